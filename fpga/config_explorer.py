@@ -0,0 +1,222 @@
+#!/usr/bin/env python3
+"""Sweep PicoRV32 configurations and report CPI, Fmax and effective run time.
+
+For every configuration the sw/bench program is simulated (Xcelium, sim/Makefile) to get the
+cycle and instruction counts, and the design is implemented (Vivado, vivado_batch.tcl impl) to
+get WNS, from which Fmax = 1 / (period - WNS). The effective run time is cycles / Fmax.
+
+Configurations override the CFG_* defines in rtl/picorv32_soc_pkg.sv. Each one runs in its
+own directory under the work directory so results can be re-tabulated with --reuse. Steps
+whose tool is not on PATH (xrun, vivado) are skipped and the matching columns show '-'.
+"""
+import argparse
+import json
+import os
+import re
+import shutil
+import subprocess
+import sys
+from concurrent.futures import ThreadPoolExecutor
+
+ROOT = os.environ.get('PICORV32_SOC_ROOT',
+                      os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+
+# Name -> CFG_* overrides, everything else keeps the package default
+DEFAULT_CONFIGS = {
+    'baseline':        {},
+    'two_stage_shift': {'BARREL_SHIFTER': 0},
+    'serial_shift':    {'BARREL_SHIFTER': 0, 'TWO_STAGE_SHIFT': 0},
+    'two_cycle_alu':   {'TWO_CYCLE_ALU': 1},
+    'two_cycle_cmp':   {'TWO_CYCLE_COMPARE': 1},
+    'two_cycle_both':  {'TWO_CYCLE_ALU': 1, 'TWO_CYCLE_COMPARE': 1},
+    'slow_mul':        {'ENABLE_FAST_MUL': 0, 'ENABLE_MUL': 1},
+    'single_port_rf':  {'ENABLE_REGS_DUALPORT': 0},
+    'write_buffer':    {'ENABLE_WRITE_BUFFER': 1},
+    'dual_core':       {'ENABLE_DUAL_CORE': 1},
+}
+
+STATS_RE = re.compile(r'SIM_STATS cycles=(\d+) instret=(\d+) cpi=[\d.]+ led=([0-9a-fA-F]+)')
+
+
+def defines(overrides):
+    return ' '.join(f'CFG_{k}={int(v)}' for k, v in sorted(overrides.items()))
+
+
+def run(cmd, cwd, log, env=None):
+    with open(log, 'w') as f:
+        return subprocess.run(cmd, cwd=cwd, env=env, stdout=f, stderr=subprocess.STDOUT).returncode
+
+
+def build_firmware():
+    """Build the benchmark and the sim bootloader, returns their hex files."""
+    bench = os.path.join(ROOT, 'sw', 'bench')
+    boot = os.path.join(ROOT, 'sw', 'bootloader_sim')
+    if shutil.which(os.environ.get('CROSS', 'riscv32-unknown-elf-') + 'gcc'):
+        for d in (bench, boot):
+            subprocess.run(['make', '-C', d], check=True, stdout=subprocess.DEVNULL)
+    hexes = os.path.join(bench, 'firmware.hex'), os.path.join(boot, 'bootloader.hex')
+    for h in hexes:
+        if not os.path.exists(h):
+            sys.exit(f'Error: {h} missing and no RISC-V toolchain to build it')
+    return hexes
+
+
+def simulate(name, overrides, workdir, ram_hex, boot_hex, reuse):
+    d = os.path.join(workdir, name, 'sim')
+    os.makedirs(d, exist_ok=True)
+    log = os.path.join(d, 'sim.log')
+    if not reuse:
+        run(['make', '-f', os.path.join(ROOT, 'sim', 'Makefile'), 'sim_batch',
+             f'RAM_INIT_FILE={ram_hex}', f'BOOTLOADER_INIT_FILE={boot_hex}',
+             f'SIM_DEFINES={defines(overrides)}'], d, log, dict(os.environ, PICORV32_SOC_ROOT=ROOT))
+    elif not os.path.exists(log):
+        print(f'  {name}: no previous simulation in {d}')
+        return None
+    with open(log) as f:
+        m = STATS_RE.search(f.read())
+    if not m:
+        print(f'  {name}: no SIM_STATS in {log}')
+        return None
+    return {'cycles': int(m.group(1)), 'instret': int(m.group(2)), 'signature': m.group(3)}
+
+
+def parse_wns(path):
+    with open(path) as f:
+        lines = f.readlines()
+    for i, line in enumerate(lines):
+        if line.split()[:1] == ['WNS(ns)']:
+            for value in lines[i + 1:i + 4]:
+                try:
+                    return float(value.split()[0])
+                except (ValueError, IndexError):
+                    continue
+    return None
+
+
+def parse_utilization(path):
+    util = {}
+    with open(path) as f:
+        for line in f:
+            m = re.match(r'\|\s*(Slice LUTs|Slice Registers)\*?\s*\|\s*(\d+)', line)
+            if m and m.group(1) not in util:
+                util[m.group(1)] = int(m.group(2))
+    return util.get('Slice LUTs'), util.get('Slice Registers')
+
+
+def implement(name, overrides, workdir, boot_hex, reuse):
+    d = os.path.join(workdir, name, 'vivado')
+    os.makedirs(d, exist_ok=True)
+    rpt = os.path.join(d, 'timing_impl.rpt')
+    if not reuse:
+        env = dict(os.environ, PICORV32_SOC_ROOT=ROOT, EXTRA_DEFINES=defines(overrides),
+                   BOOTLOADER_INIT_FILE=boot_hex, RAM_INIT_FILE='')
+        # vivado_batch.tcl only applies defines when it creates the project, start clean
+        for entry in os.listdir(d):
+            path = os.path.join(d, entry)
+            shutil.rmtree(path) if os.path.isdir(path) else os.remove(path)
+        tcl = os.path.join(ROOT, 'fpga', 'vivado', 'tcl', 'vivado_batch.tcl')
+        run(['vivado', '-mode', 'batch', '-notrace', '-nojournal', '-source', tcl,
+             '-tclargs', 'impl'], d, os.path.join(d, 'vivado.log'), env)
+    if not os.path.exists(rpt):
+        print(f'  {name}: implementation produced no {rpt}')
+        return None
+    luts, ffs = parse_utilization(os.path.join(d, 'utilization_impl.rpt'))
+    return {'wns': parse_wns(rpt), 'luts': luts, 'ffs': ffs}
+
+
+def fmt(value, spec='', missing='-'):
+    return missing if value is None else format(value, spec)
+
+
+def main():
+    ap = argparse.ArgumentParser(description='PicoRV32 configuration explorer')
+    ap.add_argument('-c', '--configs', help='JSON file mapping names to CFG_* overrides, '
+                    'e.g. {"alu2": {"TWO_CYCLE_ALU": 1}}')
+    ap.add_argument('-o', '--only', help='Comma separated subset of configuration names')
+    ap.add_argument('-w', '--workdir', default=os.path.join(ROOT, 'fpga', 'explore'),
+                    help='Work directory (default: fpga/explore)')
+    ap.add_argument('-p', '--period', type=float, default=10.0,
+                    help='Constrained CPU clock period in ns (default: 10.0)')
+    ap.add_argument('-j', '--jobs', type=int, default=1, help='Parallel Vivado runs (default: 1)')
+    ap.add_argument('--no-sim', action='store_true', help='Skip simulation')
+    ap.add_argument('--no-impl', action='store_true', help='Skip Vivado implementation')
+    ap.add_argument('--reuse', action='store_true', help='Reuse logs and reports from a previous run')
+    ap.add_argument('--csv', help='Also write the table to this CSV file')
+    args = ap.parse_args()
+
+    configs = DEFAULT_CONFIGS
+    if args.configs:
+        with open(args.configs) as f:
+            configs = json.load(f)
+    if args.only:
+        names = args.only.split(',')
+        unknown = [n for n in names if n not in configs]
+        if unknown:
+            sys.exit(f'Error: unknown configuration(s): {", ".join(unknown)}')
+        configs = {n: configs[n] for n in names}
+
+    do_sim = not args.no_sim and (args.reuse or shutil.which('xrun'))
+    do_impl = not args.no_impl and (args.reuse or shutil.which('vivado'))
+    if not args.no_sim and not do_sim:
+        print('xrun not found, skipping simulation')
+    if not args.no_impl and not do_impl:
+        print('vivado not found, skipping implementation (CPI only)')
+
+    results = {name: {} for name in configs}
+
+    if do_sim:
+        ram_hex, boot_hex = (None, None) if args.reuse else build_firmware()
+        # Simulations share the AXI file list generated by sim/Makefile, run them in sequence
+        for name, overrides in configs.items():
+            print(f'Simulating {name} [{defines(overrides) or "defaults"}]')
+            results[name].update(simulate(name, overrides, args.workdir, ram_hex, boot_hex,
+                                          args.reuse) or {})
+
+    if do_impl:
+        boot_hex = os.path.join(ROOT, 'sw', 'bootloader', 'bootloader.hex')
+        if not os.path.exists(boot_hex):
+            boot_hex = ''
+        with ThreadPoolExecutor(max_workers=max(1, args.jobs)) as pool:
+            futures = {}
+            for name, overrides in configs.items():
+                print(f'Implementing {name} [{defines(overrides) or "defaults"}]')
+                futures[name] = pool.submit(implement, name, overrides, args.workdir,
+                                            boot_hex, args.reuse)
+            for name, future in futures.items():
+                results[name].update(future.result() or {})
+
+    rows = []
+    for name, r in results.items():
+        cpi = r['cycles'] / r['instret'] if r.get('instret') else None
+        fmax = 1000.0 / (args.period - r['wns']) if r.get('wns') is not None else None
+        time_us = r['cycles'] / fmax if fmax and r.get('cycles') else None
+        rows.append((name, r.get('cycles'), r.get('instret'), cpi, r.get('wns'), fmax, time_us,
+                     r.get('luts'), r.get('ffs'), r.get('signature')))
+    rows.sort(key=lambda row: (row[6] is None, row[6] or 0, row[1] is None, row[1] or 0))
+
+    header = ('config', 'cycles', 'instret', 'CPI', 'WNS ns', 'Fmax MHz', 'time us',
+              'LUTs', 'FFs', 'sig')
+    print()
+    print(f'{header[0]:<18}{header[1]:>10}{header[2]:>10}{header[3]:>7}{header[4]:>9}'
+          f'{header[5]:>10}{header[6]:>10}{header[7]:>8}{header[8]:>8}{header[9]:>5}')
+    for name, cycles, instret, cpi, wns, fmax, time_us, luts, ffs, sig in rows:
+        print(f'{name:<18}{fmt(cycles):>10}{fmt(instret):>10}{fmt(cpi, ".3f"):>7}'
+              f'{fmt(wns, ".3f"):>9}{fmt(fmax, ".1f"):>10}{fmt(time_us, ".1f"):>10}'
+              f'{fmt(luts):>8}{fmt(ffs):>8}{fmt(sig):>5}')
+
+    signatures = {row[9] for row in rows if row[9] is not None}
+    if len(signatures) > 1:
+        print('\nWARNING: benchmark signatures differ between configurations')
+
+    if args.csv:
+        with open(args.csv, 'w') as f:
+            f.write(','.join(header) + '\n')
+            for row in rows:
+                f.write(','.join(fmt(v, missing='') for v in row) + '\n')
+        print(f'\nWrote {args.csv}')
+
+    return 1 if len(signatures) > 1 else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
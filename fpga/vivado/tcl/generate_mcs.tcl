@@ -0,0 +1,51 @@
+# Generate a QSPI flash configuration image (MCS) from a bitstream and an optional firmware
+# binary for execute-in-place boot. The firmware is placed at the XIP image offset 0xC00000,
+# well above the ~9.7 MB XC7A200T bitstream, and shows up at CPU address 0x01C00000.
+# Usage: vivado -mode batch -source generate_mcs.tcl -tclargs <bitstream> <mcs> [firmware.bin]
+
+set FLASH_SIZE_MB  32
+set FIRMWARE_OFFSET 0x00C00000
+
+if { $argc < 2 } {
+    puts "ERROR: Bitstream and MCS file must be specified"
+    puts "Usage: vivado -mode batch -source generate_mcs.tcl -tclargs <bitstream> <mcs> \[firmware.bin\]"
+    exit 1
+}
+
+set bitstream_file [lindex $argv 0]
+set mcs_file       [lindex $argv 1]
+set firmware_file  ""
+if { $argc > 2 } {
+    set firmware_file [lindex $argv 2]
+}
+
+if { ![file exists $bitstream_file] } {
+    puts "ERROR: Bitstream file not found: $bitstream_file"
+    exit 1
+}
+
+puts "=========================================="
+puts "Generating flash image:"
+puts "  Bitstream: $bitstream_file"
+if { $firmware_file ne "" } {
+    if { ![file exists $firmware_file] } {
+        puts "ERROR: Firmware file not found: $firmware_file"
+        exit 1
+    }
+    puts "  Firmware:  $firmware_file @ $FIRMWARE_OFFSET"
+}
+puts "  Output:    $mcs_file"
+puts "=========================================="
+
+if { $firmware_file ne "" } {
+    write_cfgmem -force -format mcs -size $FLASH_SIZE_MB -interface SPIx4 \
+        -loadbit "up 0x0 $bitstream_file" \
+        -loaddata "up $FIRMWARE_OFFSET $firmware_file" \
+        -file $mcs_file
+} else {
+    write_cfgmem -force -format mcs -size $FLASH_SIZE_MB -interface SPIx4 \
+        -loadbit "up 0x0 $bitstream_file" \
+        -file $mcs_file
+}
+
+exit
@@ -0,0 +1,83 @@
+# Program the Nexys Video QSPI configuration flash (S25FL256S) with an MCS image via JTAG
+# Usage: vivado -mode batch -source program_flash.tcl -tclargs <mcs_path>
+
+set FLASH_PART s25fl256sxxxxxx0-spi-x1_x2_x4
+
+# Check if MCS path is provided
+if { $argc > 0 } {
+    set mcs_file [lindex $argv 0]
+} else {
+    puts "ERROR: No MCS file specified"
+    puts "Usage: vivado -mode batch -source program_flash.tcl -tclargs <mcs_path>"
+    exit 1
+}
+
+if { ![file exists $mcs_file] } {
+    puts "ERROR: MCS file not found: $mcs_file"
+    exit 1
+}
+
+puts "=========================================="
+puts "Programming configuration flash with:"
+puts "  $mcs_file"
+puts "=========================================="
+
+# Open hardware manager
+open_hw_manager
+
+# Connect to local hardware server
+puts "Connecting to hardware server..."
+connect_hw_server -allow_non_jtag
+
+# Open and refresh the target
+puts "Opening hardware target..."
+open_hw_target
+
+# Get the first device (should be the XC7A200T on Nexys Video)
+set device [lindex [get_hw_devices] 0]
+puts "Target device: $device"
+current_hw_device $device
+refresh_hw_device -update_hw_probes false $device
+
+# Attach the configuration memory
+create_hw_cfgmem -hw_device $device [lindex [get_cfgmem_parts $FLASH_PART] 0]
+set cfgmem [get_property PROGRAM.HW_CFGMEM $device]
+
+set_property PROGRAM.ADDRESS_RANGE  {use_file} $cfgmem
+set_property PROGRAM.FILES          [list $mcs_file] $cfgmem
+set_property PROGRAM.UNUSED_PIN_TERMINATION {pull-none} $cfgmem
+set_property PROGRAM.BLANK_CHECK    0 $cfgmem
+set_property PROGRAM.ERASE          1 $cfgmem
+set_property PROGRAM.CFG_PROGRAM    1 $cfgmem
+set_property PROGRAM.VERIFY         1 $cfgmem
+set_property PROGRAM.CHECKSUM       0 $cfgmem
+
+# The FPGA is loaded with an indirect programming core that bridges JTAG to the flash
+puts "Loading flash programming core..."
+create_hw_bitstream -hw_device $device [get_property PROGRAM.HW_CFGMEM_BITFILE $device]
+program_hw_devices $device
+refresh_hw_device $device
+
+puts "Erasing, programming and verifying flash..."
+if { [catch { program_hw_cfgmem -hw_cfgmem $cfgmem } result] } {
+    puts "=========================================="
+    puts "ERROR: Flash programming failed!"
+    puts "  $result"
+    puts "=========================================="
+    exit 1
+}
+
+# Reconfigure the FPGA from the freshly written flash
+puts "Booting from flash..."
+boot_hw_device $device
+
+puts "=========================================="
+puts "SUCCESS: Flash programmed successfully!"
+puts "=========================================="
+
+# Cleanup
+close_hw_target
+disconnect_hw_server
+close_hw_manager
+
+exit
@@ -9,9 +9,16 @@ set PICORV32_CORE_PATH $ROOT/src/picorv32
 set AXI_XBAR_PATH $ROOT/src/axi
 set CCR_PATH $ROOT/src/ccr
 set AXI_SRAM_PATH $ROOT/src/axi4_lite_scratchpad
-set AXI_LED_PATH $ROOT/src/axi_led
+set AXI_GPIO_PATH $ROOT/src/axi_gpio
 set AXI_UART_PATH $ROOT/src/axi4_lite_uart
 set AXI_TIMER_PATH $ROOT/src/axi4_lite_timer
+set PCPI_CRC_PATH $ROOT/src/pcpi_crc
+set PCPI_SIMD_PATH $ROOT/src/pcpi_simd
+set UART_AXI_BRIDGE_PATH $ROOT/src/uart_axi_bridge
+set AXI_MAILBOX_PATH $ROOT/src/axi_mailbox
+set AXI_QSPI_XIP_PATH $ROOT/src/axi_qspi_xip
+set AXI_SPI_PATH $ROOT/src/axi_spi
+set AXI_WBUF_PATH $ROOT/src/axi_lite_write_buffer
 
 # ============================================
 # CCR
@@ -28,10 +35,10 @@ add_files -norecurse -fileset [current_fileset] [list \
 ]
 
 # ============================================
-# AXI-Lite LEDs
+# AXI-Lite GPIO (LEDs, switches, buttons)
 # ============================================
 add_files -norecurse -fileset [current_fileset] [list \
-  $AXI_LED_PATH/rtl/axi_led.sv \
+  $AXI_GPIO_PATH/rtl/axi_gpio.sv \
 ]
 
 # ============================================
@@ -266,6 +273,14 @@ if { [info exists env(BOOTLOADER_INIT_FILE)] } {
     puts "BOOTLOADER_INIT_FILE not set, using default empty string"
 }
 
+# Optional extra defines, e.g. EXTRA_DEFINES="CFG_TWO_CYCLE_ALU=1 CFG_BARREL_SHIFTER=0"
+if { [info exists env(EXTRA_DEFINES)] } {
+    set extra_defines $env(EXTRA_DEFINES)
+    puts "Using EXTRA_DEFINES from environment: $extra_defines"
+} else {
+    set extra_defines [list]
+}
+
 set_property verilog_define [list \
     TARGET_FPGA \
     TARGET_SYNTHESIS \
@@ -273,6 +288,7 @@ set_property verilog_define [list \
     TARGET_XILINX \
     RAM_INIT_FILE=\"$ram_init_file\" \
     BOOTLOADER_INIT_FILE=\"$bootloader_init_file\" \
+    {*}$extra_defines \
 ] [current_fileset]
 
 set_property verilog_define [list \
@@ -282,6 +298,7 @@ set_property verilog_define [list \
     TARGET_XILINX \
     RAM_INIT_FILE=\"$ram_init_file\" \
     BOOTLOADER_INIT_FILE=\"$bootloader_init_file\" \
+    {*}$extra_defines \
 ] [current_fileset -simset]
 
 # ============================================
@@ -291,6 +308,55 @@ add_files -norecurse -fileset [current_fileset] [list \
   $PICORV32_CORE_PATH/picorv32.v \
 ]
 
+# ============================================
+# PCPI CRC CO-PROCESSOR
+# ============================================
+add_files -norecurse -fileset [current_fileset] [list \
+  $PCPI_CRC_PATH/rtl/pcpi_crc.sv \
+]
+
+# ============================================
+# PCPI SIMD/MAC CO-PROCESSOR
+# ============================================
+add_files -norecurse -fileset [current_fileset] [list \
+  $PCPI_SIMD_PATH/rtl/pcpi_simd.sv \
+]
+
+# ============================================
+# UART DEBUG BRIDGE
+# ============================================
+add_files -norecurse -fileset [current_fileset] [list \
+  $UART_AXI_BRIDGE_PATH/rtl/uart_axi_bridge.sv \
+]
+
+# ============================================
+# AXI MAILBOX
+# ============================================
+add_files -norecurse -fileset [current_fileset] [list \
+  $AXI_MAILBOX_PATH/rtl/axi_mailbox.sv \
+]
+
+# ============================================
+# AXI QSPI XIP
+# ============================================
+add_files -norecurse -fileset [current_fileset] [list \
+  $AXI_QSPI_XIP_PATH/rtl/axi_qspi_xip.sv \
+]
+
+# ============================================
+# AXI SPI MASTER
+# ============================================
+add_files -norecurse -fileset [current_fileset] [list \
+  $AXI_SPI_PATH/rtl/axi_spi.sv \
+]
+
+# ============================================
+# AXI-LITE WRITE BUFFER
+# ============================================
+add_files -norecurse -fileset [current_fileset] [list \
+  $AXI_WBUF_PATH/rtl/axi_lite_write_buffer.sv \
+]
+
 # ============================================
 # PICORV32 SOC TOP
 # ============================================
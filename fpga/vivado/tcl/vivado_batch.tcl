@@ -19,9 +19,16 @@ set PICORV32_CORE_PATH $ROOT/src/picorv32
 set AXI_XBAR_PATH $ROOT/src/axi
 set CCR_PATH $ROOT/src/ccr
 set AXI_SRAM_PATH $ROOT/src/axi4_lite_scratchpad
-set AXI_LED_PATH $ROOT/src/axi_led
+set AXI_GPIO_PATH $ROOT/src/axi_gpio
 set AXI_UART_PATH $ROOT/src/axi4_lite_uart
 set AXI_TIMER_PATH $ROOT/src/axi4_lite_timer
+set PCPI_CRC_PATH $ROOT/src/pcpi_crc
+set PCPI_SIMD_PATH $ROOT/src/pcpi_simd
+set UART_AXI_BRIDGE_PATH $ROOT/src/uart_axi_bridge
+set AXI_MAILBOX_PATH $ROOT/src/axi_mailbox
+set AXI_QSPI_XIP_PATH $ROOT/src/axi_qspi_xip
+set AXI_SPI_PATH $ROOT/src/axi_spi
+set AXI_WBUF_PATH $ROOT/src/axi_lite_write_buffer
 
 # Check if project exists
 set project_name "Picorv32_SoC"
@@ -45,9 +52,9 @@ if { [file exists ${project_name}.xpr] } {
       $AXI_SRAM_PATH/rtl/axi_lite_scratchpad.sv \
     ]
     
-    # Add AXI-Lite LEDs
+    # Add AXI-Lite GPIO
     add_files -norecurse -fileset [current_fileset] [list \
-      $AXI_LED_PATH/rtl/axi_led.sv \
+      $AXI_GPIO_PATH/rtl/axi_gpio.sv \
     ]
     
     # Add AXI-Lite UART
@@ -282,6 +289,14 @@ if { [file exists ${project_name}.xpr] } {
         puts "BOOTLOADER_INIT_FILE not set, using default empty string"
     }
     
+    # Optional extra defines, e.g. EXTRA_DEFINES="CFG_TWO_CYCLE_ALU=1 CFG_BARREL_SHIFTER=0"
+    if { [info exists env(EXTRA_DEFINES)] } {
+        set extra_defines $env(EXTRA_DEFINES)
+        puts "Using EXTRA_DEFINES from environment: $extra_defines"
+    } else {
+        set extra_defines [list]
+    }
+
     set_property verilog_define [list \
         TARGET_FPGA \
         TARGET_SYNTHESIS \
@@ -289,6 +304,7 @@ if { [file exists ${project_name}.xpr] } {
         TARGET_XILINX \
         RAM_INIT_FILE=\"$ram_init_file\" \
         BOOTLOADER_INIT_FILE=\"$bootloader_init_file\" \
+        {*}$extra_defines \
     ] [current_fileset]
     
     set_property verilog_define [list \
@@ -298,6 +314,7 @@ if { [file exists ${project_name}.xpr] } {
         TARGET_XILINX \
         RAM_INIT_FILE=\"$ram_init_file\" \
         BOOTLOADER_INIT_FILE=\"$bootloader_init_file\" \
+        {*}$extra_defines \
     ] [current_fileset -simset]
     
     # Add PICORV32 CORE
@@ -305,6 +322,41 @@ if { [file exists ${project_name}.xpr] } {
       $PICORV32_CORE_PATH/picorv32.v \
     ]
     
+    # Add PCPI CRC co-processor
+    add_files -norecurse -fileset [current_fileset] [list \
+      $PCPI_CRC_PATH/rtl/pcpi_crc.sv \
+    ]
+    
+    # Add PCPI SIMD/MAC co-processor
+    add_files -norecurse -fileset [current_fileset] [list \
+      $PCPI_SIMD_PATH/rtl/pcpi_simd.sv \
+    ]
+    
+    # Add UART debug bridge
+    add_files -norecurse -fileset [current_fileset] [list \
+      $UART_AXI_BRIDGE_PATH/rtl/uart_axi_bridge.sv \
+    ]
+    
+    # Add AXI mailbox
+    add_files -norecurse -fileset [current_fileset] [list \
+      $AXI_MAILBOX_PATH/rtl/axi_mailbox.sv \
+    ]
+    
+    # Add AXI QSPI XIP controller
+    add_files -norecurse -fileset [current_fileset] [list \
+      $AXI_QSPI_XIP_PATH/rtl/axi_qspi_xip.sv \
+    ]
+    
+    # Add AXI SPI master
+    add_files -norecurse -fileset [current_fileset] [list \
+      $AXI_SPI_PATH/rtl/axi_spi.sv \
+    ]
+    
+    # Add AXI-Lite posted-write buffer
+    add_files -norecurse -fileset [current_fileset] [list \
+      $AXI_WBUF_PATH/rtl/axi_lite_write_buffer.sv \
+    ]
+    
     # Add PICORV32 SOC TOP
     add_files -norecurse -fileset [current_fileset] [list \
       $PICORV32_SOC_PATH/rtl/picorv32_soc_pkg.sv \
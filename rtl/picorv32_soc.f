@@ -1,5 +1,12 @@
 $PICORV32_SOC_ROOT/src/axi4_lite_scratchpad/rtl/axi_lite_scratchpad.sv
-$PICORV32_SOC_ROOT/src/axi_led/rtl/axi_led.sv
+$PICORV32_SOC_ROOT/src/axi_gpio/rtl/axi_gpio.sv
+$PICORV32_SOC_ROOT/src/pcpi_crc/rtl/pcpi_crc.sv
+$PICORV32_SOC_ROOT/src/pcpi_simd/rtl/pcpi_simd.sv
+$PICORV32_SOC_ROOT/src/uart_axi_bridge/rtl/uart_axi_bridge.sv
+$PICORV32_SOC_ROOT/src/axi_mailbox/rtl/axi_mailbox.sv
+$PICORV32_SOC_ROOT/src/axi_qspi_xip/rtl/axi_qspi_xip.sv
+$PICORV32_SOC_ROOT/src/axi_spi/rtl/axi_spi.sv
+$PICORV32_SOC_ROOT/src/axi_lite_write_buffer/rtl/axi_lite_write_buffer.sv
 -f $PICORV32_SOC_ROOT/src/axi4_lite_timer/rtl/axi_lite_timer.f
 -f $PICORV32_SOC_ROOT/src/axi4_lite_uart/rtl/uart.f
 $PICORV32_SOC_ROOT/rtl/picorv32_soc_pkg.sv
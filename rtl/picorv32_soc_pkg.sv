@@ -15,20 +15,47 @@ package picorv32_soc_pkg;
   parameter int unsigned BOOTLOADER_ROM_WIDTH_p = 32;
   parameter int unsigned BOOTLOADER_ROM_DEPTH_p = 1024;
 
+  // Set this to 1 (CFG_ENABLE_DUAL_CORE=1) to instantiate a second PicoRV32 core. Both cores share
+  // the crossbar and all slaves, core 1 is held in reset until core 0 releases it through the
+  // mailbox CORE_CTRL register and then starts at PROGADDR_RESET_CORE1_p. See src/axi_mailbox and
+  // sw/dual_core.
+  `ifndef CFG_ENABLE_DUAL_CORE
+    `define CFG_ENABLE_DUAL_CORE 0
+  `endif
+  parameter bit ENABLE_DUAL_CORE_p = `CFG_ENABLE_DUAL_CORE;
+
+  // Number of CPU cores
+  parameter int unsigned CPU_NBR_p = ENABLE_DUAL_CORE_p ? 2 : 1;
+
+  // Set this to 1 (CFG_ENABLE_DBG_BRIDGE=1) to add the UART debug bridge (src/uart_axi_bridge).
+  // It shares the UART pins with the UART peripheral and, after an unlock sequence from the host,
+  // reads and writes any address as an extra crossbar master and can hold the cores in reset. See
+  // sw/tools/shock_dbg.py. Off by default: anything that sends the unlock bytes on the console
+  // gets full bus access, so it is only meant for development bitstreams.
+  `ifndef CFG_ENABLE_DBG_BRIDGE
+    `define CFG_ENABLE_DBG_BRIDGE 0
+  `endif
+  parameter bit          ENABLE_DBG_BRIDGE_p = `CFG_ENABLE_DBG_BRIDGE;
+  parameter int unsigned DBG_BRIDGE_BAUD_p   = 921_600;
+
   // Number of masters
-  // We have only one master: picorv32
-  parameter int unsigned AXI_MASTER_NBR_p = 1;
+  // Every picorv32 core is a master, the debug bridge comes after the cores
+  parameter int unsigned AXI_MASTER_NBR_p = CPU_NBR_p + ENABLE_DBG_BRIDGE_p;
 
   // Number of Slaves
-  // We have 5 slaves:
+  // We have 8 slaves:
   // 1. Scratchpad memory (SRAM)
   // 2. UART
   // 3. LEDs
   // 4. Timer/Counter
-  parameter int unsigned AXI_SLAVE_NBR_p = 5;
+  // 5. Bootloader ROM
+  // 6. Mailbox/spinlocks
+  // 7. QSPI flash (execute in place)
+  // 8. SPI master
+  parameter int unsigned AXI_SLAVE_NBR_p = 8;
 
-  // AXI address width
-  parameter int unsigned AXI_ADDR_BW_p = 16;
+  // AXI address width, the full 32-bit CPU address space (the flash window is above 64k)
+  parameter int unsigned AXI_ADDR_BW_p = 32;
 
   // AXI data width
   parameter int unsigned AXI_DATA_BW_p = 32;
@@ -51,16 +78,113 @@ package picorv32_soc_pkg;
 
   // AXI address map
   parameter rule_t [AXI_XBAR_CFG_p.NoAddrRules-1:0] AXI_ADDR_MAP_p = '{
+    '{idx: 32'd7, start_addr: 32'h0000_A000, end_addr: 32'h0000_B000}, // SPI master (4k)
+    '{idx: 32'd6, start_addr: 32'h0100_0000, end_addr: 32'h0200_0000}, // QSPI flash XIP (16M)
+    '{idx: 32'd5, start_addr: 32'h0000_9000, end_addr: 32'h0000_A000}, // Mailbox/spinlocks (4k)
     '{idx: 32'd4, start_addr: 32'h0000_8000, end_addr: 32'h0000_9000}, // Bootloader (4k)
     '{idx: 32'd3, start_addr: 32'h0000_4000, end_addr: 32'h0000_8000}, // SRAM (16k) 
     '{idx: 32'd2, start_addr: 32'h0000_3000, end_addr: 32'h0000_4000}, // UART (4k)
-    '{idx: 32'd1, start_addr: 32'h0000_2000, end_addr: 32'h0000_3000}, // LEDs (4k)
+    '{idx: 32'd1, start_addr: 32'h0000_2000, end_addr: 32'h0000_3000}, // GPIO: LEDs, switches, buttons (4k)
     '{idx: 32'd0, start_addr: 32'h0000_1000, end_addr: 32'h0000_2000}  // Timer/Counter (4k)
   };
 
+  // The mailbox tells its masters apart by the crossbar port they use. Each master writes its port
+  // index into address bits [11:9] of every mailbox access before the crossbar (the registers
+  // only decode [8:0]), so software cannot pose as another master. Up to 8 masters.
+  parameter logic [31:0] MBOX_BASE_ADDR_p = 32'h0000_9000;
+
+  function automatic logic [31:0] mbox_tag_addr(input logic [31:0] addr, input int unsigned master);
+    if (addr[31:12] == MBOX_BASE_ADDR_p[31:12]) begin
+      addr[11:9] = 3'(master);
+    end
+    return addr;
+  endfunction
+
+  // QSPI flash execute-in-place controller (src/axi_qspi_xip). The SPI clock is
+  // clk / (2 * QSPI_CLK_DIV_p), 25 MHz at the default 100 MHz CPU clock. Firmware images for
+  // flash boot are stored at QSPI_IMAGE_OFFSET_p, above the bitstream of the XC7A200T.
+  parameter int unsigned QSPI_CLK_DIV_p      = 2;
+  parameter int unsigned QSPI_DUMMY_CYCLES_p = 4;
+  parameter int unsigned QSPI_LINE_NBR_p     = 16;
+  parameter bit [31:0]   QSPI_IMAGE_OFFSET_p = 32'h00C0_0000;
+
+  // Set this to 1 (CFG_QSPI_QUAD_SETUP=1) to let the controller set the non-volatile CR1.QUAD bit
+  // after reset if it is clear. Off by default, the flash then has to come with QUAD set.
+  `ifndef CFG_QSPI_QUAD_SETUP
+    `define CFG_QSPI_QUAD_SETUP 0
+  `endif
+  parameter bit          QSPI_QUAD_SETUP_p   = `CFG_QSPI_QUAD_SETUP;
+
+  // SPI master (src/axi_spi) on Pmod JA. It runs from the CPU clock, so SCK can go up to
+  // clk / 2. Each FIFO entry holds one frame of up to 32 bits. Its IRQ 7 is level sensitive.
+  parameter int unsigned SPI_FIFO_DEPTH_p = 16;
+  parameter int unsigned SPI_CS_NBR_p     = 1;
+
   // Parameters used for picorv32_axi instantiation
   // For more details check https://github.com/YosysHQ/picorv32
 
+  // The CPU micro-architecture knobs below can be overridden from the command line without
+  // editing this file, e.g. xrun +define+CFG_TWO_CYCLE_ALU=1 or EXTRA_DEFINES="CFG_TWO_CYCLE_ALU=1"
+  // for Vivado. fpga/config_explorer.py uses this to sweep configurations.
+  `ifndef CFG_ENABLE_REGS_DUALPORT
+    `define CFG_ENABLE_REGS_DUALPORT 1
+  `endif
+  `ifndef CFG_TWO_STAGE_SHIFT
+    `define CFG_TWO_STAGE_SHIFT 1
+  `endif
+  `ifndef CFG_BARREL_SHIFTER
+    `define CFG_BARREL_SHIFTER 1
+  `endif
+  `ifndef CFG_TWO_CYCLE_COMPARE
+    `define CFG_TWO_CYCLE_COMPARE 0
+  `endif
+  `ifndef CFG_TWO_CYCLE_ALU
+    `define CFG_TWO_CYCLE_ALU 0
+  `endif
+  `ifndef CFG_ENABLE_MUL
+    `define CFG_ENABLE_MUL 0
+  `endif
+  `ifndef CFG_ENABLE_FAST_MUL
+    `define CFG_ENABLE_FAST_MUL 1
+  `endif
+  `ifndef CFG_ENABLE_DIV
+    `define CFG_ENABLE_DIV 1
+  `endif
+  `ifndef CFG_ENABLE_WRITE_BUFFER
+    `define CFG_ENABLE_WRITE_BUFFER 0
+  `endif
+  `ifndef CFG_SPLIT_CLOCK_DOMAINS
+    `define CFG_SPLIT_CLOCK_DOMAINS 0
+  `endif
+  `ifndef CFG_ENABLE_PCPI_CRC
+    `define CFG_ENABLE_PCPI_CRC 0
+  `endif
+  `ifndef CFG_ENABLE_PCPI_SIMD
+    `define CFG_ENABLE_PCPI_SIMD 0
+  `endif
+
+  // Set this to 1 to run the CPU, memories and crossbar from CCR CLKOUT0 (CPU_CLK_FREQ_p) and the
+  // timer, GPIO and UART (slaves 0 .. PERIPH_SLAVE_NBR_p-1) from CLKOUT1 (PERIPH_CLK_FREQ_p),
+  // behind one axi_lite_cdc_intf each. The peripheral clock stays at 100 MHz, so baud rates and
+  // timer prescalers do not change; rdcycle and the PicoRV32 timer count CPU clocks. With 0 the
+  // whole SoC runs from CLKOUT0 at 100 MHz.
+  parameter bit          SPLIT_CLOCK_DOMAINS_p = `CFG_SPLIT_CLOCK_DOMAINS;
+  parameter real         CPU_CLK_DIVIDE_p      = SPLIT_CLOCK_DOMAINS_p ? 5.0 : 6.0; // 600 MHz VCO
+  parameter int unsigned PERIPH_CLK_DIVIDE_p   = 6;
+  parameter int unsigned CPU_CLK_FREQ_p        = int'(600_000_000.0 / CPU_CLK_DIVIDE_p);
+  parameter int unsigned PERIPH_CLK_FREQ_p     = 600_000_000 / PERIPH_CLK_DIVIDE_p;
+  parameter int unsigned PERIPH_SLAVE_NBR_p    = 3;
+
+  // Simulation only: the UART is told its clock is UART_SIM_SPEEDUP_p times slower, so every baud
+  // rate runs that much faster and a byte costs 1/UART_SIM_SPEEDUP_p of the simulated time. The
+  // testbench UART agent scales its bit period by the same factor. Keep enough clock cycles per
+  // bit at the fastest baud rate the firmware uses, e.g. 8 leaves ~13 at 921600 baud.
+  // Override with +define+CFG_UART_SIM_SPEEDUP=<n> (sim/Makefile UART_SIM_SPEEDUP=<n>).
+  `ifndef CFG_UART_SIM_SPEEDUP
+    `define CFG_UART_SIM_SPEEDUP 1
+  `endif
+  parameter int unsigned UART_SIM_SPEEDUP_p    = `CFG_UART_SIM_SPEEDUP;
+
   // This parameter enables support for the RDCYCLE[H], RDTIME[H], and RDINSTRET[H] instructions.
   // This instructions will cause a hardware trap (like any other unsupported instruction) if 
   // ENABLE_COUNTERS is set to zero.
@@ -78,7 +202,7 @@ package picorv32_soc_pkg;
 
   // The register file can be implemented with two or one read ports. A dual ported register file
   // improves performance a bit, but can also increase the size of the core.
-  parameter bit ENABLE_REGS_DUALPORT_p = 1;
+  parameter bit ENABLE_REGS_DUALPORT_p = `CFG_ENABLE_REGS_DUALPORT;
 
   // Set this to 1 if the mem_rdata is kept stable by the external circuit after a transaction. In
   // the default configuration the PicoRV32 core only expects the mem_rdata input to be valid in the
@@ -89,23 +213,23 @@ package picorv32_soc_pkg;
   // By default shift operations are performed in two stages: first shifts in units of 4 bits and
   // then shifts in units of 1 bit. This speeds up shift operations, but adds additional hardware.
   // Set this parameter to 0 to disable the two-stage shift to further reduce the size of the core.
-  parameter bit TWO_STAGE_SHIFT_p = 1;
+  parameter bit TWO_STAGE_SHIFT_p = `CFG_TWO_STAGE_SHIFT;
 
   // By default shift operations are performed by successively shifting by a small amount
   // (see TWO_STAGE_SHIFT above). With this option set, a barrel shifter is used instead.
-  parameter bit BARREL_SHIFTER_p = 1;
+  parameter bit BARREL_SHIFTER_p = `CFG_BARREL_SHIFTER;
 
   // This relaxes the longest data path a bit by adding an additional FF stage at the cost of 
   // adding an additional clock cycle delay to the conditional branch instructions.
   // Note: Enabling this parameter will be most effective when retiming (aka "register balancing") 
   // is enabled in the synthesis flow.
-  parameter bit TWO_CYCLE_COMPARE_p = 0;
+  parameter bit TWO_CYCLE_COMPARE_p = `CFG_TWO_CYCLE_COMPARE;
 
   // This adds an additional FF stage in the ALU data path, improving timing at the cost of an
   // additional clock cycle for all instructions that use the ALU.
   // Note: Enabling this parameter will be most effective when retiming (aka "register balancing")
   // is enabled in the synthesis flow.
-  parameter bit TWO_CYCLE_ALU_p = 0;
+  parameter bit TWO_CYCLE_ALU_p = `CFG_TWO_CYCLE_ALU;
 
   // This enables support for the RISC-V Compressed Instruction Set.
   parameter bit COMPRESSED_ISA_p = 1;
@@ -119,26 +243,49 @@ package picorv32_soc_pkg;
   // processor without triggering an interrupt.
   parameter bit CATCH_ILLINSN_p = 1;
 
+  // Set this to 1 to attach the pcpi_crc co-processor (src/pcpi_crc) to the external PCPI. It
+  // implements the custom-1 instructions crc32.w, crc32.b, swz and bfextu, each completing in a
+  // single cycle. See sw/lib/pcpi_crc.h for the encodings and C intrinsics. Off by default so
+  // the core keeps its area and timing; CFG_ENABLE_PCPI_CRC=1 turns it on.
+  parameter bit ENABLE_PCPI_CRC_p = `CFG_ENABLE_PCPI_CRC;
+
+  // Set this to 1 to attach the pcpi_simd co-processor (src/pcpi_simd) to the external PCPI. It
+  // implements the custom-2 packed 8/16-bit add/sub/compare instructions, dot products and a 64-bit
+  // multiply-accumulate register, two cycles each. See sw/lib/pcpi_simd.h. Off by default like
+  // pcpi_crc; CFG_ENABLE_PCPI_SIMD=1 turns it on.
+  parameter bit ENABLE_PCPI_SIMD_p = `CFG_ENABLE_PCPI_SIMD;
+
   // Set this to 1 to enable the external Pico Co-Processor Interface (PCPI). The external interface
   // is not required for the internal PCPI cores, such as picorv32_pcpi_mul.
-  parameter bit ENABLE_PCPI_p = 0;
+  // It is enabled whenever an external co-processor is instantiated.
+  parameter bit ENABLE_PCPI_p = ENABLE_PCPI_CRC_p | ENABLE_PCPI_SIMD_p;
 
   // This parameter internally enables PCPI and instantiates the picorv32_pcpi_mul core that
   // implements the MUL[H[SU|U]] instructions. The external PCPI interface only becomes functional
   // when ENABLE_PCPI is set as well.
-  parameter bit ENABLE_MUL_p = 0;
+  parameter bit ENABLE_MUL_p = `CFG_ENABLE_MUL;
   
   // This parameter internally enables PCPI and instantiates the picorv32_pcpi_fast_mul core that
   // implements the MUL[H[SU|U]] instructions. The external PCPI interface only becomes functional
   // when ENABLE_PCPI is set as well.
   // If both ENABLE_MUL and ENABLE_FAST_MUL are set then the ENABLE_MUL setting will be ignored and
   // the fast multiplier core will be instantiated.
-  parameter bit ENABLE_FAST_MUL_p = 1;
+  parameter bit ENABLE_FAST_MUL_p = `CFG_ENABLE_FAST_MUL;
   
   // This parameter internally enables PCPI and instantiates the picorv32_pcpi_div core that
   // implements the DIV[U]/REM[U] instructions. The external PCPI interface only becomes functional
   // when ENABLE_PCPI is set as well.
-  parameter bit ENABLE_DIV_p = 1;
+  parameter bit ENABLE_DIV_p = `CFG_ENABLE_DIV;
+
+  // Set this to 1 (CFG_ENABLE_WRITE_BUFFER=1) to put a posted-write buffer
+  // (src/axi_lite_write_buffer) between every core and the crossbar. Stores complete one cycle
+  // after they are accepted instead of waiting for the B response; loads wait for buffered stores
+  // to the same 4k region and a store to another region waits for the ones in flight. Failed
+  // writes raise IRQ 5 (core 0). Reading WRITE_BUFFER_DRAIN_ADDR_p waits until all stores have
+  // completed and returns the error count, see sw/lib/wbuf.h. Off by default.
+  parameter bit          ENABLE_WRITE_BUFFER_p     = `CFG_ENABLE_WRITE_BUFFER;
+  parameter int unsigned WRITE_BUFFER_DEPTH_p      = 4;
+  parameter bit [31:0]   WRITE_BUFFER_DRAIN_ADDR_p = 32'h0000_0FF0;
   
   // Set this to 1 to enable IRQs. (see "Custom Instructions for IRQ Handling" for
   // a discussion of IRQs: 
@@ -171,11 +318,15 @@ package picorv32_soc_pkg;
   // the interrupt handler is called (aka "pulse interrupts" or "edge-triggered interrupts").
   // Set a bit in this bitmask to 0 to convert an interrupt line to operate as "level sensitive"
   // interrupt.
-  parameter bit [31:0] LATCHED_IRQ_p = 32'h ffff_fff3;
+  parameter bit [31:0] LATCHED_IRQ_p = 32'h ffff_ff03;
 
   // The start address of the program.
   parameter bit [31:0] PROGADDR_RESET_p = 32'h 0000_8000;
   
+  // The start address of the second core (ENABLE_DUAL_CORE_p = 1). It points into the firmware
+  // loaded to SRAM, start.S places a jump to the secondary entry point at this address.
+  parameter bit [31:0] PROGADDR_RESET_CORE1_p = 32'h 0000_4008;
+
   // The start address of the interrupt handler.
   parameter bit [31:0] PROGADDR_IRQ_p = 32'h 0000_4010;
 
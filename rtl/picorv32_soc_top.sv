@@ -7,12 +7,24 @@ module picorv32_soc_top
   // Nexys Video CPU reset
   input logic i_btn_rst_n,
 
-  // Nexys Video LEDs
+  // Nexys Video LEDs, switches and buttons (C, D, L, R, U)
   output logic [7:0] o_led,
+  input logic [7:0] i_sw,
+  input logic [4:0] i_btn,
 
   // Nexys Video UART
   output logic o_uart_rx,
-  input logic i_uart_tx
+  input logic i_uart_tx,
+
+  // Nexys Video QSPI configuration flash (SCK is driven through STARTUPE2)
+  output logic o_qspi_cs_n,
+  inout  wire [3:0] io_qspi_dq,
+
+  // Nexys Video Pmod JA SPI master
+  output logic o_spi_sck,
+  output logic o_spi_mosi,
+  input logic i_spi_miso,
+  output logic [SPI_CS_NBR_p-1:0] o_spi_cs_n
 );
 
   `ifndef BOOTLOADER_INIT_FILE
@@ -23,20 +35,52 @@ module picorv32_soc_top
     `define RAM_INIT_FILE ""
   `endif
 
-  // Clock and reset
+  // Clock and reset, CPU domain and peripheral domain (timer, GPIO, UART)
   logic s_rst_n;
   logic s_clk;
+  logic s_periph_rst_n;
+  logic s_periph_clk;
+  logic s_ccr_periph_rst_n;
+  logic s_ccr_periph_clk;
   
-  // CPU trap
-  logic s_trap;
+  // CPU trap, one per core
+  logic [CPU_NBR_p-1:0] s_trap;
 
   // CPU IRQ
   logic [31:0] s_irq;
   logic [31:0] s_eoi;
 
-  assign s_irq[31:4] = '0;
+  assign s_irq[31:8] = '0;
   assign s_irq[1:0] = '0;
 
+  // Peripheral domain interrupts (timer, UART, GPIO) and their CPU domain copies
+  logic [2:0] s_periph_irq;
+  logic [2:0] s_periph_irq_sync;
+
+  // SPI master interrupt
+  logic s_spi_irq;
+
+  // QSPI flash
+  logic       s_qspi_sck;
+  logic [3:0] s_qspi_dq_o;
+  logic [3:0] s_qspi_dq_oe;
+  logic [3:0] s_qspi_dq_i;
+
+  // Cores held in reset until released through the mailbox (core 0 always runs)
+  logic [CPU_NBR_p-1:0] s_core_release;
+  logic [CPU_NBR_p-1:0] s_mbox_irq;
+
+  // Posted-write buffer error interrupts, one per core
+  logic [CPU_NBR_p-1:0] s_wbuf_irq;
+
+  // Debug bridge: UART pin ownership and core halt handshake
+  logic                 s_uart_rx;
+  logic                 s_uart_tx;
+  logic                 s_dbg_active;
+  logic                 s_dbg_tx;
+  logic                 s_dbg_halt_req;
+  logic [CPU_NBR_p-1:0] s_dbg_halted;
+
   AXI_LITE #(
     .AXI_ADDR_WIDTH ( AXI_ADDR_BW_p ),
     .AXI_DATA_WIDTH ( AXI_DATA_BW_p )
@@ -52,34 +96,92 @@ module picorv32_soc_top
     .AXI_DATA_WIDTH ( AXI_DATA_BW_p )
   ) cut_to_xbar[AXI_MASTER_NBR_p-1:0]();
 
-  // Insert cut (slice register) between PicoRV32 and crossbar, this improves timing by 
-  // roughly 10%
-  axi_lite_cut_intf #(
-    .ADDR_WIDTH ( AXI_ADDR_BW_p ),
-    .DATA_WIDTH ( AXI_DATA_BW_p )
-  ) i_response_cut (
-    .clk_i  ( s_clk               ),
-    .rst_ni ( s_rst_n             ),
-    .in     ( axi_master_intf[0]  ),  // From your PicoRV32 bridge
-    .out    ( cut_to_xbar[0]      )   // To crossbar
-  ); 
+  AXI_LITE #(
+    .AXI_ADDR_WIDTH ( AXI_ADDR_BW_p ),
+    .AXI_DATA_WIDTH ( AXI_DATA_BW_p )
+  ) wbuf_to_cut[AXI_MASTER_NBR_p-1:0]();
+
+  AXI_LITE #(
+    .AXI_ADDR_WIDTH ( AXI_ADDR_BW_p ),
+    .AXI_DATA_WIDTH ( AXI_DATA_BW_p )
+  ) periph_intf[PERIPH_SLAVE_NBR_p-1:0]();
 
   // Common clock and reset (CCR) instance
   ccr #(
 `ifdef SIM
     .BTN_DEBOUNCE_COUNTER_VALUE_p ( 10 ),
-    .PLL_LOCK_COUNTER_VALUE_p     ( 15 )
+    .RST_GUARD_CYCLES_p           ( 4 ),
 `else
     .BTN_DEBOUNCE_COUNTER_VALUE_p ( 100000 ),
-    .PLL_LOCK_COUNTER_VALUE_p     ( 100000 )
+    .RST_GUARD_CYCLES_p           ( 64 ),
 `endif // SIM
+    .CPU_CLK_DIVIDE_p             ( CPU_CLK_DIVIDE_p    ),
+    .PERIPH_CLK_DIVIDE_p          ( PERIPH_CLK_DIVIDE_p )
   ) ccr_inst (
-    .i_clk       ( i_clk        ),
-    .i_btn_rst_n ( i_btn_rst_n  ),
-    .o_clk       ( s_clk        ),
-    .o_rst_n     ( s_rst_n      )
+    .i_clk          ( i_clk               ),
+    .i_btn_rst_n    ( i_btn_rst_n         ),
+    .o_clk          ( s_clk               ),
+    .o_rst_n        ( s_rst_n             ),
+    .o_periph_clk   ( s_ccr_periph_clk    ),
+    .o_periph_rst_n ( s_ccr_periph_rst_n  )
   );
 
+  // Timer, GPIO and UART (slaves 0 .. PERIPH_SLAVE_NBR_p-1) sit behind a clock domain crossing
+  // when the clock domains are split, otherwise behind a bypassed cut on the CPU clock
+  if (SPLIT_CLOCK_DOMAINS_p) begin : gen_periph_cdc
+    (* ASYNC_REG = "TRUE" *) logic [2:0] periph_irq_meta;
+    (* ASYNC_REG = "TRUE" *) logic [2:0] periph_irq_sync;
+
+    assign s_periph_clk   = s_ccr_periph_clk;
+    assign s_periph_rst_n = s_ccr_periph_rst_n;
+
+    for (genvar j = 0; j < PERIPH_SLAVE_NBR_p; j++) begin : gen_cdc
+      axi_lite_cdc_intf #(
+        .AXI_ADDR_WIDTH ( AXI_ADDR_BW_p ),
+        .AXI_DATA_WIDTH ( AXI_DATA_BW_p ),
+        .LOG_DEPTH      ( 1             )
+      ) i_periph_cdc (
+        .src_clk_i  ( s_clk              ),
+        .src_rst_ni ( s_rst_n            ),
+        .src        ( axi_slave_intf[j]  ),  // From crossbar
+        .dst_clk_i  ( s_periph_clk       ),
+        .dst_rst_ni ( s_periph_rst_n     ),
+        .dst        ( periph_intf[j]     )   // To peripheral
+      );
+    end
+
+    // Peripheral interrupts are levels or pulses at least one peripheral clock long, the CPU
+    // clock is faster so a two flop synchronizer does not lose them
+    always_ff @(posedge s_clk) begin
+      periph_irq_meta <= s_periph_irq;
+      periph_irq_sync <= periph_irq_meta;
+    end
+
+    assign s_periph_irq_sync = periph_irq_sync;
+  end else begin : gen_no_periph_cdc
+    assign s_periph_clk   = s_clk;
+    assign s_periph_rst_n = s_rst_n;
+
+    for (genvar j = 0; j < PERIPH_SLAVE_NBR_p; j++) begin : gen_bypass
+      axi_lite_cut_intf #(
+        .BYPASS     ( 1'b1          ),
+        .ADDR_WIDTH ( AXI_ADDR_BW_p ),
+        .DATA_WIDTH ( AXI_DATA_BW_p )
+      ) i_periph_bypass (
+        .clk_i  ( s_clk              ),
+        .rst_ni ( s_rst_n            ),
+        .in     ( axi_slave_intf[j]  ),
+        .out    ( periph_intf[j]     )
+      );
+    end
+
+    assign s_periph_irq_sync = s_periph_irq;
+  end
+
+  assign s_irq[2] = s_periph_irq_sync[0];
+  assign s_irq[3] = s_periph_irq_sync[1];
+  assign s_irq[6] = s_periph_irq_sync[2];
+
   // AXI crossbar
   axi_lite_xbar_intf #(
     .Cfg    ( AXI_XBAR_CFG_p ),
@@ -156,152 +258,577 @@ module picorv32_soc_top
   
   // AXI UART
   uart_top #(
-    .CLK_FREQ_p         ( 100_000_000         ),
+`ifdef SIM
+    .CLK_FREQ_p         ( PERIPH_CLK_FREQ_p / UART_SIM_SPEEDUP_p ),
+`else
+    .CLK_FREQ_p         ( PERIPH_CLK_FREQ_p   ),
+`endif // SIM
     .UART_FIFO_DEPTH_p  ( 16                  ),
     .AXI_ADDR_BW_p      ( 12                  )
   ) uart_inst (
-    .clk            ( s_clk                           ),
-    .rst_n          ( s_rst_n                         ),
-    .i_axi_awaddr   ( axi_slave_intf[2].aw_addr[11:0] ),
-    .i_axi_awvalid  ( axi_slave_intf[2].aw_valid      ),
-    .i_axi_wdata    ( axi_slave_intf[2].w_data        ),
-    .i_axi_wvalid   ( axi_slave_intf[2].w_valid       ),
-    .i_axi_bready   ( axi_slave_intf[2].b_ready       ),
-    .i_axi_araddr   ( axi_slave_intf[2].ar_addr[11:0] ),
-    .i_axi_arvalid  ( axi_slave_intf[2].ar_valid      ),
-    .i_axi_rready   ( axi_slave_intf[2].r_ready       ),
-    .o_axi_awready  ( axi_slave_intf[2].aw_ready      ),
-    .o_axi_wready   ( axi_slave_intf[2].w_ready       ),
-    .o_axi_bresp    ( axi_slave_intf[2].b_resp        ),
-    .o_axi_bvalid   ( axi_slave_intf[2].b_valid       ),
-    .o_axi_arready  ( axi_slave_intf[2].ar_ready      ),
-    .o_axi_rdata    ( axi_slave_intf[2].r_data        ),
-    .o_axi_rresp    ( axi_slave_intf[2].r_resp        ),
-    .o_axi_rvalid   ( axi_slave_intf[2].r_valid       ),
-    .i_uart_rx      ( i_uart_tx                       ),
-    .o_uart_tx      ( o_uart_rx                       ),
-    .o_irq          ( s_irq[3]                        )
+    .clk            ( s_periph_clk                 ),
+    .rst_n          ( s_periph_rst_n               ),
+    .i_axi_awaddr   ( periph_intf[2].aw_addr[11:0] ),
+    .i_axi_awvalid  ( periph_intf[2].aw_valid      ),
+    .i_axi_wdata    ( periph_intf[2].w_data        ),
+    .i_axi_wvalid   ( periph_intf[2].w_valid       ),
+    .i_axi_bready   ( periph_intf[2].b_ready       ),
+    .i_axi_araddr   ( periph_intf[2].ar_addr[11:0] ),
+    .i_axi_arvalid  ( periph_intf[2].ar_valid      ),
+    .i_axi_rready   ( periph_intf[2].r_ready       ),
+    .o_axi_awready  ( periph_intf[2].aw_ready      ),
+    .o_axi_wready   ( periph_intf[2].w_ready       ),
+    .o_axi_bresp    ( periph_intf[2].b_resp        ),
+    .o_axi_bvalid   ( periph_intf[2].b_valid       ),
+    .o_axi_arready  ( periph_intf[2].ar_ready      ),
+    .o_axi_rdata    ( periph_intf[2].r_data        ),
+    .o_axi_rresp    ( periph_intf[2].r_resp        ),
+    .o_axi_rvalid   ( periph_intf[2].r_valid       ),
+    .i_uart_rx      ( s_uart_rx                    ),
+    .o_uart_tx      ( s_uart_tx                    ),
+    .o_irq          ( s_periph_irq[1]              )
   );
 
-  // AXI LED module
-  axi_led #(
-    .AXI_ADDR_BW_p ( 12  ),
-    .LED_NBR_p     ( 8  )
-  ) axi_led_inst (
-    .clk            ( s_clk                            ),
-    .rst_n          ( s_rst_n                          ),
-    .i_axi_awaddr   ( axi_slave_intf[1].aw_addr[11:0]  ),
-    .i_axi_awvalid  ( axi_slave_intf[1].aw_valid       ),
-    .i_axi_wdata    ( axi_slave_intf[1].w_data         ),
-    .i_axi_wvalid   ( axi_slave_intf[1].w_valid        ),
-    .i_axi_bready   ( axi_slave_intf[1].b_ready        ),
-    .i_axi_araddr   ( axi_slave_intf[1].ar_addr[11:0]  ),
-    .i_axi_arvalid  ( axi_slave_intf[1].ar_valid       ),
-    .i_axi_rready   ( axi_slave_intf[1].r_ready        ),
-    .o_axi_awready  ( axi_slave_intf[1].aw_ready       ),
-    .o_axi_wready   ( axi_slave_intf[1].w_ready        ),
-    .o_axi_bresp    ( axi_slave_intf[1].b_resp         ),
-    .o_axi_bvalid   ( axi_slave_intf[1].b_valid        ),
-    .o_axi_arready  ( axi_slave_intf[1].ar_ready       ),
-    .o_axi_rdata    ( axi_slave_intf[1].r_data         ),
-    .o_axi_rresp    ( axi_slave_intf[1].r_resp         ),
-    .o_axi_rvalid   ( axi_slave_intf[1].r_valid        ),
-    .o_led          ( o_led                            )
+  // UART debug bridge, the last crossbar master. While a debug session is open it owns the TX pin
+  // and the UART peripheral sees an idle RX line.
+  if (ENABLE_DBG_BRIDGE_p) begin : gen_dbg_bridge
+    logic [AXI_ADDR_BW_p-1:0] s_dbg_awaddr;
+    logic [AXI_ADDR_BW_p-1:0] s_dbg_araddr;
+
+    uart_axi_bridge #(
+`ifdef SIM
+      .CLK_FREQ_p ( CPU_CLK_FREQ_p / UART_SIM_SPEEDUP_p ),
+`else
+      .CLK_FREQ_p ( CPU_CLK_FREQ_p      ),
+`endif // SIM
+      .BAUD_p     ( DBG_BRIDGE_BAUD_p   )
+    ) uart_axi_bridge_inst (
+      .clk              ( s_clk                                ),
+      .rst_n            ( s_rst_n                              ),
+      .i_rx             ( i_uart_tx                            ),
+      .o_tx             ( s_dbg_tx                             ),
+      .o_active         ( s_dbg_active                         ),
+      .o_halt_req       ( s_dbg_halt_req                       ),
+      .i_halted         ( s_dbg_halt_req ? &s_dbg_halted : |s_dbg_halted ),
+      .o_m_axi_awaddr   ( s_dbg_awaddr                         ),
+      .o_m_axi_awprot   ( axi_master_intf[CPU_NBR_p].aw_prot   ),
+      .o_m_axi_awvalid  ( axi_master_intf[CPU_NBR_p].aw_valid  ),
+      .i_m_axi_awready  ( axi_master_intf[CPU_NBR_p].aw_ready  ),
+      .o_m_axi_wdata    ( axi_master_intf[CPU_NBR_p].w_data    ),
+      .o_m_axi_wstrb    ( axi_master_intf[CPU_NBR_p].w_strb    ),
+      .o_m_axi_wvalid   ( axi_master_intf[CPU_NBR_p].w_valid   ),
+      .i_m_axi_wready   ( axi_master_intf[CPU_NBR_p].w_ready   ),
+      .i_m_axi_bresp    ( axi_master_intf[CPU_NBR_p].b_resp    ),
+      .i_m_axi_bvalid   ( axi_master_intf[CPU_NBR_p].b_valid   ),
+      .o_m_axi_bready   ( axi_master_intf[CPU_NBR_p].b_ready   ),
+      .o_m_axi_araddr   ( s_dbg_araddr                         ),
+      .o_m_axi_arprot   ( axi_master_intf[CPU_NBR_p].ar_prot   ),
+      .o_m_axi_arvalid  ( axi_master_intf[CPU_NBR_p].ar_valid  ),
+      .i_m_axi_arready  ( axi_master_intf[CPU_NBR_p].ar_ready  ),
+      .i_m_axi_rdata    ( axi_master_intf[CPU_NBR_p].r_data    ),
+      .i_m_axi_rresp    ( axi_master_intf[CPU_NBR_p].r_resp    ),
+      .i_m_axi_rvalid   ( axi_master_intf[CPU_NBR_p].r_valid   ),
+      .o_m_axi_rready   ( axi_master_intf[CPU_NBR_p].r_ready   )
+    );
+
+    // Mailbox master index after the cores
+    assign axi_master_intf[CPU_NBR_p].aw_addr = mbox_tag_addr(s_dbg_awaddr, CPU_NBR_p);
+    assign axi_master_intf[CPU_NBR_p].ar_addr = mbox_tag_addr(s_dbg_araddr, CPU_NBR_p);
+
+    axi_lite_cut_intf #(
+      .ADDR_WIDTH ( AXI_ADDR_BW_p ),
+      .DATA_WIDTH ( AXI_DATA_BW_p )
+    ) i_response_cut (
+      .clk_i  ( s_clk                       ),
+      .rst_ni ( s_rst_n                     ),
+      .in     ( axi_master_intf[CPU_NBR_p]  ),  // From the debug bridge
+      .out    ( cut_to_xbar[CPU_NBR_p]      )   // To crossbar
+    );
+
+    assign s_uart_rx = s_dbg_active ? 1'b1 : i_uart_tx;
+    assign o_uart_rx = s_dbg_active ? s_dbg_tx : s_uart_tx;
+  end else begin : gen_no_dbg_bridge
+    assign s_dbg_active   = 1'b0;
+    assign s_dbg_tx       = 1'b1;
+    assign s_dbg_halt_req = 1'b0;
+    assign s_uart_rx      = i_uart_tx;
+    assign o_uart_rx      = s_uart_tx;
+  end
+
+  // AXI GPIO: LEDs with set/clear/toggle and PWM, switches and buttons with edge IRQs
+  axi_gpio #(
+    .AXI_ADDR_BW_p     ( 12      ),
+    .OUT_NBR_p         ( 8       ),
+    .IN_NBR_p          ( 13      ),
+`ifdef SIM
+    .DEBOUNCE_CYCLES_p ( 4       )
+`else
+    .DEBOUNCE_CYCLES_p ( 1000000 )
+`endif // SIM
+  ) axi_gpio_inst (
+    .clk            ( s_periph_clk                 ),
+    .rst_n          ( s_periph_rst_n               ),
+    .i_axi_awaddr   ( periph_intf[1].aw_addr[11:0] ),
+    .i_axi_awvalid  ( periph_intf[1].aw_valid      ),
+    .i_axi_wdata    ( periph_intf[1].w_data        ),
+    .i_axi_wvalid   ( periph_intf[1].w_valid       ),
+    .i_axi_bready   ( periph_intf[1].b_ready       ),
+    .i_axi_araddr   ( periph_intf[1].ar_addr[11:0] ),
+    .i_axi_arvalid  ( periph_intf[1].ar_valid      ),
+    .i_axi_rready   ( periph_intf[1].r_ready       ),
+    .o_axi_awready  ( periph_intf[1].aw_ready      ),
+    .o_axi_wready   ( periph_intf[1].w_ready       ),
+    .o_axi_bresp    ( periph_intf[1].b_resp        ),
+    .o_axi_bvalid   ( periph_intf[1].b_valid       ),
+    .o_axi_arready  ( periph_intf[1].ar_ready      ),
+    .o_axi_rdata    ( periph_intf[1].r_data        ),
+    .o_axi_rresp    ( periph_intf[1].r_resp        ),
+    .o_axi_rvalid   ( periph_intf[1].r_valid       ),
+    .o_gpio         ( o_led                        ),
+    .i_gpio         ( {i_btn, i_sw}                ),
+    .o_irq          ( s_periph_irq[2]              )
   );
   
   // AXI Timer/Compare
   axi_timer_counter_top #(
     .AXI_ADDR_BW_p ( 12 )
   ) axi_timer_counter_inst (
+    .clk            ( s_periph_clk                 ),
+    .rst_n          ( s_periph_rst_n               ),
+    .i_axi_awaddr   ( periph_intf[0].aw_addr[11:0] ),
+    .i_axi_awvalid  ( periph_intf[0].aw_valid      ),
+    .i_axi_wdata    ( periph_intf[0].w_data        ),
+    .i_axi_wvalid   ( periph_intf[0].w_valid       ),
+    .i_axi_bready   ( periph_intf[0].b_ready       ),
+    .i_axi_araddr   ( periph_intf[0].ar_addr[11:0] ),
+    .i_axi_arvalid  ( periph_intf[0].ar_valid      ),
+    .i_axi_rready   ( periph_intf[0].r_ready       ),
+    .o_axi_awready  ( periph_intf[0].aw_ready      ),
+    .o_axi_wready   ( periph_intf[0].w_ready       ),
+    .o_axi_bresp    ( periph_intf[0].b_resp        ),
+    .o_axi_bvalid   ( periph_intf[0].b_valid       ),
+    .o_axi_arready  ( periph_intf[0].ar_ready      ),
+    .o_axi_rdata    ( periph_intf[0].r_data        ),
+    .o_axi_rresp    ( periph_intf[0].r_resp        ),
+    .o_axi_rvalid   ( periph_intf[0].r_valid       ),
+    .o_irq          ( s_periph_irq[0]              )
+  );
+
+  // QSPI flash execute-in-place controller
+  axi_qspi_xip #(
+    .AXI_ADDR_BW_p  ( 24                   ),
+    .CLK_DIV_p      ( QSPI_CLK_DIV_p       ),
+    .DUMMY_CYCLES_p ( QSPI_DUMMY_CYCLES_p  ),
+    .LINE_NBR_p     ( QSPI_LINE_NBR_p      ),
+    .QUAD_SETUP_p   ( QSPI_QUAD_SETUP_p    )
+  ) axi_qspi_xip_inst (
     .clk            ( s_clk                            ),
     .rst_n          ( s_rst_n                          ),
-    .i_axi_awaddr   ( axi_slave_intf[0].aw_addr[11:0]  ),
-    .i_axi_awvalid  ( axi_slave_intf[0].aw_valid       ),
-    .i_axi_wdata    ( axi_slave_intf[0].w_data         ),
-    .i_axi_wvalid   ( axi_slave_intf[0].w_valid        ),
-    .i_axi_bready   ( axi_slave_intf[0].b_ready        ),
-    .i_axi_araddr   ( axi_slave_intf[0].ar_addr[11:0]  ),
-    .i_axi_arvalid  ( axi_slave_intf[0].ar_valid       ),
-    .i_axi_rready   ( axi_slave_intf[0].r_ready        ),
-    .o_axi_awready  ( axi_slave_intf[0].aw_ready       ),
-    .o_axi_wready   ( axi_slave_intf[0].w_ready        ),
-    .o_axi_bresp    ( axi_slave_intf[0].b_resp         ),
-    .o_axi_bvalid   ( axi_slave_intf[0].b_valid        ),
-    .o_axi_arready  ( axi_slave_intf[0].ar_ready       ),
-    .o_axi_rdata    ( axi_slave_intf[0].r_data         ),
-    .o_axi_rresp    ( axi_slave_intf[0].r_resp         ),
-    .o_axi_rvalid   ( axi_slave_intf[0].r_valid        ),
-    .o_irq          ( s_irq[2]                         )
+    .i_axi_awaddr   ( axi_slave_intf[6].aw_addr[23:0]  ),
+    .i_axi_awvalid  ( axi_slave_intf[6].aw_valid       ),
+    .i_axi_wdata    ( axi_slave_intf[6].w_data         ),
+    .i_axi_wvalid   ( axi_slave_intf[6].w_valid        ),
+    .i_axi_bready   ( axi_slave_intf[6].b_ready        ),
+    .i_axi_araddr   ( axi_slave_intf[6].ar_addr[23:0]  ),
+    .i_axi_arvalid  ( axi_slave_intf[6].ar_valid       ),
+    .i_axi_rready   ( axi_slave_intf[6].r_ready        ),
+    .o_axi_awready  ( axi_slave_intf[6].aw_ready       ),
+    .o_axi_wready   ( axi_slave_intf[6].w_ready        ),
+    .o_axi_bresp    ( axi_slave_intf[6].b_resp         ),
+    .o_axi_bvalid   ( axi_slave_intf[6].b_valid        ),
+    .o_axi_arready  ( axi_slave_intf[6].ar_ready       ),
+    .o_axi_rdata    ( axi_slave_intf[6].r_data         ),
+    .o_axi_rresp    ( axi_slave_intf[6].r_resp         ),
+    .o_axi_rvalid   ( axi_slave_intf[6].r_valid        ),
+    .o_qspi_sck     ( s_qspi_sck                       ),
+    .o_qspi_cs_n    ( o_qspi_cs_n                      ),
+    .o_qspi_dq      ( s_qspi_dq_o                      ),
+    .o_qspi_dq_oe   ( s_qspi_dq_oe                     ),
+    .i_qspi_dq      ( s_qspi_dq_i                      )
   );
 
-  // PicoRV32 instance
-  picorv32_axi #(
-    .ENABLE_COUNTERS      ( ENABLE_COUNTERS_p       ),
-    .ENABLE_COUNTERS64    ( ENABLE_COUNTERS64_p     ),
-    .ENABLE_REGS_16_31    ( ENABLE_REGS_16_31_p     ),
-    .ENABLE_REGS_DUALPORT ( ENABLE_REGS_DUALPORT_p  ),
-    .TWO_STAGE_SHIFT      ( TWO_STAGE_SHIFT_p       ),
-    .BARREL_SHIFTER       ( BARREL_SHIFTER_p        ),
-    .TWO_CYCLE_COMPARE    ( TWO_CYCLE_COMPARE_p     ),
-    .TWO_CYCLE_ALU        ( TWO_CYCLE_ALU_p         ), 
-    .COMPRESSED_ISA       ( COMPRESSED_ISA_p        ),
-    .CATCH_MISALIGN       ( CATCH_MISALIGN_p        ),
-    .CATCH_ILLINSN        ( CATCH_ILLINSN_p         ),
-    .ENABLE_PCPI          ( ENABLE_PCPI_p           ),
-    .ENABLE_MUL           ( ENABLE_MUL_p            ),
-    .ENABLE_FAST_MUL      ( ENABLE_FAST_MUL_p       ),
-    .ENABLE_DIV           ( ENABLE_DIV_p            ),
-    .ENABLE_IRQ           ( ENABLE_IRQ_p            ),
-    .ENABLE_IRQ_QREGS     ( ENABLE_IRQ_QREGS_p      ),
-    .ENABLE_IRQ_TIMER     ( ENABLE_IRQ_TIMER_p      ),
-    .ENABLE_TRACE         ( ENABLE_TRACE_p          ),
-    .REGS_INIT_ZERO       ( REGS_INIT_ZERO_p        ),
-    .MASKED_IRQ           ( MASKED_IRQ_p            ),
-    .LATCHED_IRQ          ( LATCHED_IRQ_p           ),
-    .PROGADDR_RESET       ( PROGADDR_RESET_p        ),
-    .PROGADDR_IRQ         ( PROGADDR_IRQ_p          ),
-    .STACKADDR            ( STACKADDR_p             )
-  ) picorv32_axi_inst (
-    .clk    ( s_clk      ), 
-    .resetn ( s_rst_n    ),
-    .trap   ( s_trap     ), 
-    // AXI4-lite master memory interface
-    .mem_axi_awvalid    ( axi_master_intf[0].aw_valid   ),
-    .mem_axi_awready    ( axi_master_intf[0].aw_ready   ),
-    .mem_axi_awaddr     ( axi_master_intf[0].aw_addr    ),
-    .mem_axi_awprot     ( axi_master_intf[0].aw_prot    ),
-    .mem_axi_wvalid     ( axi_master_intf[0].w_valid    ),
-    .mem_axi_wready     ( axi_master_intf[0].w_ready    ),
-    .mem_axi_wdata      ( axi_master_intf[0].w_data     ),
-    .mem_axi_wstrb      ( axi_master_intf[0].w_strb     ),
-    .mem_axi_bvalid     ( axi_master_intf[0].b_valid    ),
-    .mem_axi_bready     ( axi_master_intf[0].b_ready    ),
-    .mem_axi_arvalid    ( axi_master_intf[0].ar_valid   ),
-    .mem_axi_arready    ( axi_master_intf[0].ar_ready   ),
-    .mem_axi_araddr     ( axi_master_intf[0].ar_addr    ),
-    .mem_axi_arprot     ( axi_master_intf[0].ar_prot    ),
-    .mem_axi_rvalid     ( axi_master_intf[0].r_valid    ),
-    .mem_axi_rready     ( axi_master_intf[0].r_ready    ),
-    .mem_axi_rdata      ( axi_master_intf[0].r_data     ),
-
-    // Pico Co-Processor Interface (PCPI)
-    .pcpi_valid   ( /* OPEN */    ),
-    .pcpi_insn    ( /* OPEN */    ),
-    .pcpi_rs1     ( /* OPEN */    ),
-    .pcpi_rs2     ( /* OPEN */    ),
-    .pcpi_wr      ( 1'b0          ),
-    .pcpi_rd      ( '0            ),
-    .pcpi_wait    ( 1'b0          ),
-    .pcpi_ready   ( 1'b0          ),
-
-    // IRQ interface
-    .irq          ( s_irq         ),
-    .eoi          ( s_eoi         ),
-  
-    // Trace Interface
-    .trace_valid  ( /* OPEN */    ),
-    .trace_data   ( /* OPEN */    )
+  generate
+    for (genvar i = 0; i < 4; i++) begin : gen_qspi_dq
+      assign io_qspi_dq[i] = s_qspi_dq_oe[i] ? s_qspi_dq_o[i] : 1'bz;
+    end
+  endgenerate
+
+  assign s_qspi_dq_i = io_qspi_dq;
+
+`ifndef SIM
+  // The configuration flash clock pin (CCLK) is only reachable through STARTUPE2. In simulation
+  // the testbench flash model takes s_qspi_sck directly.
+  STARTUPE2 #(
+    .PROG_USR      ( "FALSE" ),
+    .SIM_CCLK_FREQ ( 0.0     )
+  ) startupe2_inst (
+    .CFGCLK    (  /* OPEN */  ),
+    .CFGMCLK   (  /* OPEN */  ),
+    .EOS       (  /* OPEN */  ),
+    .PREQ      (  /* OPEN */  ),
+    .CLK       ( 1'b0         ),
+    .GSR       ( 1'b0         ),
+    .GTS       ( 1'b0         ),
+    .KEYCLEARB ( 1'b1         ),
+    .PACK      ( 1'b0         ),
+    .USRCCLKO  ( s_qspi_sck   ),
+    .USRCCLKTS ( 1'b0         ),
+    .USRDONEO  ( 1'b1         ),
+    .USRDONETS ( 1'b1         )
   );
+`endif // SIM
+
+  // AXI inter-core mailbox and spinlocks
+  axi_mailbox #(
+    .AXI_ADDR_BW_p ( 12                ),
+    .CORE_NBR_p    ( CPU_NBR_p         ),
+    .MASTER_NBR_p  ( AXI_MASTER_NBR_p  )
+  ) axi_mailbox_inst (
+    .clk            ( s_clk                            ),
+    .rst_n          ( s_rst_n                          ),
+    .i_axi_awaddr   ( axi_slave_intf[5].aw_addr[11:0]  ),
+    .i_axi_awvalid  ( axi_slave_intf[5].aw_valid       ),
+    .i_axi_wdata    ( axi_slave_intf[5].w_data         ),
+    .i_axi_wvalid   ( axi_slave_intf[5].w_valid        ),
+    .i_axi_bready   ( axi_slave_intf[5].b_ready        ),
+    .i_axi_araddr   ( axi_slave_intf[5].ar_addr[11:0]  ),
+    .i_axi_arvalid  ( axi_slave_intf[5].ar_valid       ),
+    .i_axi_rready   ( axi_slave_intf[5].r_ready        ),
+    .o_axi_awready  ( axi_slave_intf[5].aw_ready       ),
+    .o_axi_wready   ( axi_slave_intf[5].w_ready        ),
+    .o_axi_bresp    ( axi_slave_intf[5].b_resp         ),
+    .o_axi_bvalid   ( axi_slave_intf[5].b_valid        ),
+    .o_axi_arready  ( axi_slave_intf[5].ar_ready       ),
+    .o_axi_rdata    ( axi_slave_intf[5].r_data         ),
+    .o_axi_rresp    ( axi_slave_intf[5].r_resp         ),
+    .o_axi_rvalid   ( axi_slave_intf[5].r_valid        ),
+    .o_core_release ( s_core_release                   ),
+    .o_irq          ( s_mbox_irq                       )
+  );
+
+  // AXI SPI master
+  axi_spi #(
+    .AXI_ADDR_BW_p ( 12                ),
+    .FIFO_DEPTH_p  ( SPI_FIFO_DEPTH_p  ),
+    .CS_NBR_p      ( SPI_CS_NBR_p      )
+  ) axi_spi_inst (
+    .clk            ( s_clk                            ),
+    .rst_n          ( s_rst_n                          ),
+    .i_axi_awaddr   ( axi_slave_intf[7].aw_addr[11:0]  ),
+    .i_axi_awvalid  ( axi_slave_intf[7].aw_valid       ),
+    .i_axi_wdata    ( axi_slave_intf[7].w_data         ),
+    .i_axi_wvalid   ( axi_slave_intf[7].w_valid        ),
+    .i_axi_bready   ( axi_slave_intf[7].b_ready        ),
+    .i_axi_araddr   ( axi_slave_intf[7].ar_addr[11:0]  ),
+    .i_axi_arvalid  ( axi_slave_intf[7].ar_valid       ),
+    .i_axi_rready   ( axi_slave_intf[7].r_ready        ),
+    .o_axi_awready  ( axi_slave_intf[7].aw_ready       ),
+    .o_axi_wready   ( axi_slave_intf[7].w_ready        ),
+    .o_axi_bresp    ( axi_slave_intf[7].b_resp         ),
+    .o_axi_bvalid   ( axi_slave_intf[7].b_valid        ),
+    .o_axi_arready  ( axi_slave_intf[7].ar_ready       ),
+    .o_axi_rdata    ( axi_slave_intf[7].r_data         ),
+    .o_axi_rresp    ( axi_slave_intf[7].r_resp         ),
+    .o_axi_rvalid   ( axi_slave_intf[7].r_valid        ),
+    .o_spi_sck      ( o_spi_sck                        ),
+    .o_spi_mosi     ( o_spi_mosi                       ),
+    .i_spi_miso     ( i_spi_miso                       ),
+    .o_spi_cs_n     ( o_spi_cs_n                       ),
+    .o_irq          ( s_spi_irq                        ),
+    .o_dma_tx_req   (  /* OPEN */                      ),
+    .o_dma_rx_req   (  /* OPEN */                      )
+  );
+
+  // Level sensitive, the SPI keeps it high until the FIFO levels or the sticky flags change
+  assign s_irq[7] = s_spi_irq;
+
+  // Mailbox 0 (core 0 inbox) interrupts core 0, core 1 polls its mailbox
+  assign s_irq[4] = s_mbox_irq[0];
+
+  // Late write errors of core 0, core 1 can poll its own buffer
+  assign s_irq[5] = s_wbuf_irq[0];
+
+  // CPU cores
+  generate
+    for (genvar i = 0; i < CPU_NBR_p; i++) begin : gen_cpu
+      // PCPI
+      logic        s_pcpi_valid;
+      logic [31:0] s_pcpi_insn;
+      logic [31:0] s_pcpi_rs1;
+      logic [31:0] s_pcpi_rs2;
+      logic        s_pcpi_wr;
+      logic [31:0] s_pcpi_rd;
+      logic        s_pcpi_wait;
+      logic        s_pcpi_ready;
+      // Responses of the individual co-processors, they decode disjoint opcodes
+      logic        s_crc_pcpi_wr;
+      logic [31:0] s_crc_pcpi_rd;
+      logic        s_crc_pcpi_wait;
+      logic        s_crc_pcpi_ready;
+      logic        s_simd_pcpi_wr;
+      logic [31:0] s_simd_pcpi_rd;
+      logic        s_simd_pcpi_wait;
+      logic        s_simd_pcpi_ready;
+
+      // Core addresses before the mailbox master index is inserted
+      logic [31:0] s_awaddr;
+      logic [31:0] s_araddr;
+
+      // Core side of the AXI valid/ready handshakes, gated while the debug bridge halts the core
+      logic        s_core_awvalid;
+      logic        s_core_awready;
+      logic        s_core_wvalid;
+      logic        s_core_wready;
+      logic        s_core_bvalid;
+      logic        s_core_bready;
+      logic        s_core_arvalid;
+      logic        s_core_arready;
+      logic        s_core_rvalid;
+      logic        s_core_rready;
+      logic        s_dbg_block;
+      logic        s_dbg_halt;
+
+      // IRQ (only core 0 handles interrupts)
+      logic [31:0] s_core_irq;
+      logic [31:0] s_core_eoi;
+
+      if (i == 0) begin : gen_irq
+        assign s_core_irq = s_irq;
+        assign s_eoi      = s_core_eoi;
+      end else begin : gen_no_irq
+        assign s_core_irq = '0;
+      end
+
+      assign axi_master_intf[i].aw_addr = mbox_tag_addr(s_awaddr, i);
+      assign axi_master_intf[i].ar_addr = mbox_tag_addr(s_araddr, i);
+
+      // Debug halt: the bus is blocked as soon as the core has no transaction in flight and the
+      // core goes into reset one cycle later, so a request it starts in between never reaches
+      // the crossbar. Both are released together when the bridge drops the request.
+      always_ff @(posedge s_clk) begin
+        if (!s_rst_n || !s_dbg_halt_req) begin
+          s_dbg_block <= 1'b0;
+          s_dbg_halt  <= 1'b0;
+        end else begin
+          if (!(s_core_awvalid || s_core_wvalid || s_core_bready || s_core_arvalid ||
+                s_core_rready)) begin
+            s_dbg_block <= 1'b1;
+          end
+          s_dbg_halt <= s_dbg_block;
+        end
+      end
+
+      assign s_dbg_halted[i] = s_dbg_halt;
+
+      assign axi_master_intf[i].aw_valid = s_core_awvalid & ~s_dbg_block;
+      assign axi_master_intf[i].w_valid  = s_core_wvalid  & ~s_dbg_block;
+      assign axi_master_intf[i].b_ready  = s_core_bready  & ~s_dbg_block;
+      assign axi_master_intf[i].ar_valid = s_core_arvalid & ~s_dbg_block;
+      assign axi_master_intf[i].r_ready  = s_core_rready  & ~s_dbg_block;
+      assign s_core_awready = axi_master_intf[i].aw_ready & ~s_dbg_block;
+      assign s_core_wready  = axi_master_intf[i].w_ready  & ~s_dbg_block;
+      assign s_core_bvalid  = axi_master_intf[i].b_valid  & ~s_dbg_block;
+      assign s_core_arready = axi_master_intf[i].ar_ready & ~s_dbg_block;
+      assign s_core_rvalid  = axi_master_intf[i].r_valid  & ~s_dbg_block;
+
+      if (ENABLE_WRITE_BUFFER_p) begin : gen_wbuf
+        // Posted-write buffer, stores complete without waiting for the B response
+        axi_lite_write_buffer #(
+          .AXI_ADDR_BW_p ( AXI_ADDR_BW_p              ),
+          .DEPTH_p       ( WRITE_BUFFER_DEPTH_p       ),
+          .DRAIN_ADDR_p  ( WRITE_BUFFER_DRAIN_ADDR_p  )
+        ) axi_lite_write_buffer_inst (
+          .clk              ( s_clk                         ),
+          .rst_n            ( s_rst_n                       ),
+          .i_s_axi_awaddr   ( axi_master_intf[i].aw_addr    ),
+          .i_s_axi_awprot   ( axi_master_intf[i].aw_prot    ),
+          .i_s_axi_awvalid  ( axi_master_intf[i].aw_valid   ),
+          .o_s_axi_awready  ( axi_master_intf[i].aw_ready   ),
+          .i_s_axi_wdata    ( axi_master_intf[i].w_data     ),
+          .i_s_axi_wstrb    ( axi_master_intf[i].w_strb     ),
+          .i_s_axi_wvalid   ( axi_master_intf[i].w_valid    ),
+          .o_s_axi_wready   ( axi_master_intf[i].w_ready    ),
+          .o_s_axi_bresp    ( axi_master_intf[i].b_resp     ),
+          .o_s_axi_bvalid   ( axi_master_intf[i].b_valid    ),
+          .i_s_axi_bready   ( axi_master_intf[i].b_ready    ),
+          .i_s_axi_araddr   ( axi_master_intf[i].ar_addr    ),
+          .i_s_axi_arprot   ( axi_master_intf[i].ar_prot    ),
+          .i_s_axi_arvalid  ( axi_master_intf[i].ar_valid   ),
+          .o_s_axi_arready  ( axi_master_intf[i].ar_ready   ),
+          .o_s_axi_rdata    ( axi_master_intf[i].r_data     ),
+          .o_s_axi_rresp    ( axi_master_intf[i].r_resp     ),
+          .o_s_axi_rvalid   ( axi_master_intf[i].r_valid    ),
+          .i_s_axi_rready   ( axi_master_intf[i].r_ready    ),
+          .o_m_axi_awaddr   ( wbuf_to_cut[i].aw_addr        ),
+          .o_m_axi_awprot   ( wbuf_to_cut[i].aw_prot        ),
+          .o_m_axi_awvalid  ( wbuf_to_cut[i].aw_valid       ),
+          .i_m_axi_awready  ( wbuf_to_cut[i].aw_ready       ),
+          .o_m_axi_wdata    ( wbuf_to_cut[i].w_data         ),
+          .o_m_axi_wstrb    ( wbuf_to_cut[i].w_strb         ),
+          .o_m_axi_wvalid   ( wbuf_to_cut[i].w_valid        ),
+          .i_m_axi_wready   ( wbuf_to_cut[i].w_ready        ),
+          .i_m_axi_bresp    ( wbuf_to_cut[i].b_resp         ),
+          .i_m_axi_bvalid   ( wbuf_to_cut[i].b_valid        ),
+          .o_m_axi_bready   ( wbuf_to_cut[i].b_ready        ),
+          .o_m_axi_araddr   ( wbuf_to_cut[i].ar_addr        ),
+          .o_m_axi_arprot   ( wbuf_to_cut[i].ar_prot        ),
+          .o_m_axi_arvalid  ( wbuf_to_cut[i].ar_valid       ),
+          .i_m_axi_arready  ( wbuf_to_cut[i].ar_ready       ),
+          .i_m_axi_rdata    ( wbuf_to_cut[i].r_data         ),
+          .i_m_axi_rresp    ( wbuf_to_cut[i].r_resp         ),
+          .i_m_axi_rvalid   ( wbuf_to_cut[i].r_valid        ),
+          .o_m_axi_rready   ( wbuf_to_cut[i].r_ready        ),
+          .o_irq            ( s_wbuf_irq[i]                 )
+        );
+
+        // Insert cut (slice register) between PicoRV32 and crossbar, this improves timing by 
+        // roughly 10%
+        axi_lite_cut_intf #(
+          .ADDR_WIDTH ( AXI_ADDR_BW_p ),
+          .DATA_WIDTH ( AXI_DATA_BW_p )
+        ) i_response_cut (
+          .clk_i  ( s_clk           ),
+          .rst_ni ( s_rst_n         ),
+          .in     ( wbuf_to_cut[i]  ),  // From the write buffer
+          .out    ( cut_to_xbar[i]  )   // To crossbar
+        );
+      end else begin : gen_no_wbuf
+        assign s_wbuf_irq[i] = 1'b0;
+
+        // Insert cut (slice register) between PicoRV32 and crossbar, this improves timing by 
+        // roughly 10%
+        axi_lite_cut_intf #(
+          .ADDR_WIDTH ( AXI_ADDR_BW_p ),
+          .DATA_WIDTH ( AXI_DATA_BW_p )
+        ) i_response_cut (
+          .clk_i  ( s_clk               ),
+          .rst_ni ( s_rst_n             ),
+          .in     ( axi_master_intf[i]  ),  // From your PicoRV32 bridge
+          .out    ( cut_to_xbar[i]      )   // To crossbar
+        );
+      end
+
+      // PCPI CRC/bit manipulation co-processor
+      if (ENABLE_PCPI_CRC_p) begin : gen_pcpi_crc
+        pcpi_crc pcpi_crc_inst (
+          .clk          ( s_clk         ),
+          .rst_n        ( s_rst_n       ),
+          .i_pcpi_valid ( s_pcpi_valid  ),
+          .i_pcpi_insn  ( s_pcpi_insn   ),
+          .i_pcpi_rs1   ( s_pcpi_rs1    ),
+          .i_pcpi_rs2   ( s_pcpi_rs2    ),
+          .o_pcpi_wr    ( s_crc_pcpi_wr     ),
+          .o_pcpi_rd    ( s_crc_pcpi_rd     ),
+          .o_pcpi_wait  ( s_crc_pcpi_wait   ),
+          .o_pcpi_ready ( s_crc_pcpi_ready  )
+        );
+      end else begin : gen_no_pcpi_crc
+        assign s_crc_pcpi_wr    = 1'b0;
+        assign s_crc_pcpi_rd    = '0;
+        assign s_crc_pcpi_wait  = 1'b0;
+        assign s_crc_pcpi_ready = 1'b0;
+      end
+
+      // PCPI packed SIMD/MAC co-processor
+      if (ENABLE_PCPI_SIMD_p) begin : gen_pcpi_simd
+        pcpi_simd pcpi_simd_inst (
+          .clk          ( s_clk              ),
+          .rst_n        ( s_rst_n            ),
+          .i_pcpi_valid ( s_pcpi_valid       ),
+          .i_pcpi_insn  ( s_pcpi_insn        ),
+          .i_pcpi_rs1   ( s_pcpi_rs1         ),
+          .i_pcpi_rs2   ( s_pcpi_rs2         ),
+          .o_pcpi_wr    ( s_simd_pcpi_wr     ),
+          .o_pcpi_rd    ( s_simd_pcpi_rd     ),
+          .o_pcpi_wait  ( s_simd_pcpi_wait   ),
+          .o_pcpi_ready ( s_simd_pcpi_ready  )
+        );
+      end else begin : gen_no_pcpi_simd
+        assign s_simd_pcpi_wr    = 1'b0;
+        assign s_simd_pcpi_rd    = '0;
+        assign s_simd_pcpi_wait  = 1'b0;
+        assign s_simd_pcpi_ready = 1'b0;
+      end
+
+      // At most one co-processor claims an instruction, so the handshakes can be OR-ed and rd
+      // taken from whichever unit is ready
+      assign s_pcpi_wr    = s_crc_pcpi_wr | s_simd_pcpi_wr;
+      assign s_pcpi_rd    = s_crc_pcpi_ready ? s_crc_pcpi_rd : s_simd_pcpi_rd;
+      assign s_pcpi_wait  = s_crc_pcpi_wait | s_simd_pcpi_wait;
+      assign s_pcpi_ready = s_crc_pcpi_ready | s_simd_pcpi_ready;
+
+      // PicoRV32 instance
+      // Core 1 is built without IRQ support and starts from its own reset vector
+      picorv32_axi #(
+        .ENABLE_COUNTERS      ( ENABLE_COUNTERS_p       ),
+        .ENABLE_COUNTERS64    ( ENABLE_COUNTERS64_p     ),
+        .ENABLE_REGS_16_31    ( ENABLE_REGS_16_31_p     ),
+        .ENABLE_REGS_DUALPORT ( ENABLE_REGS_DUALPORT_p  ),
+        .TWO_STAGE_SHIFT      ( TWO_STAGE_SHIFT_p       ),
+        .BARREL_SHIFTER       ( BARREL_SHIFTER_p        ),
+        .TWO_CYCLE_COMPARE    ( TWO_CYCLE_COMPARE_p     ),
+        .TWO_CYCLE_ALU        ( TWO_CYCLE_ALU_p         ), 
+        .COMPRESSED_ISA       ( COMPRESSED_ISA_p        ),
+        .CATCH_MISALIGN       ( CATCH_MISALIGN_p        ),
+        .CATCH_ILLINSN        ( CATCH_ILLINSN_p         ),
+        .ENABLE_PCPI          ( ENABLE_PCPI_p           ),
+        .ENABLE_MUL           ( ENABLE_MUL_p            ),
+        .ENABLE_FAST_MUL      ( ENABLE_FAST_MUL_p       ),
+        .ENABLE_DIV           ( ENABLE_DIV_p            ),
+        .ENABLE_IRQ           ( (i == 0) && ENABLE_IRQ_p ),
+        .ENABLE_IRQ_QREGS     ( ENABLE_IRQ_QREGS_p      ),
+        .ENABLE_IRQ_TIMER     ( ENABLE_IRQ_TIMER_p      ),
+        .ENABLE_TRACE         ( ENABLE_TRACE_p          ),
+        .REGS_INIT_ZERO       ( REGS_INIT_ZERO_p        ),
+        .MASKED_IRQ           ( MASKED_IRQ_p            ),
+        .LATCHED_IRQ          ( LATCHED_IRQ_p           ),
+        .PROGADDR_RESET       ( (i == 0) ? PROGADDR_RESET_p : PROGADDR_RESET_CORE1_p ),
+        .PROGADDR_IRQ         ( PROGADDR_IRQ_p          ),
+        .STACKADDR            ( STACKADDR_p             )
+      ) picorv32_axi_inst (
+        .clk    ( s_clk                        ), 
+        .resetn ( s_rst_n & s_core_release[i] & ~s_dbg_halt  ),
+        .trap   ( s_trap[i]                    ), 
+        // AXI4-lite master memory interface
+        .mem_axi_awvalid    ( s_core_awvalid                ),
+        .mem_axi_awready    ( s_core_awready                ),
+        .mem_axi_awaddr     ( s_awaddr                      ),
+        .mem_axi_awprot     ( axi_master_intf[i].aw_prot    ),
+        .mem_axi_wvalid     ( s_core_wvalid                 ),
+        .mem_axi_wready     ( s_core_wready                 ),
+        .mem_axi_wdata      ( axi_master_intf[i].w_data     ),
+        .mem_axi_wstrb      ( axi_master_intf[i].w_strb     ),
+        .mem_axi_bvalid     ( s_core_bvalid                 ),
+        .mem_axi_bready     ( s_core_bready                 ),
+        .mem_axi_arvalid    ( s_core_arvalid                ),
+        .mem_axi_arready    ( s_core_arready                ),
+        .mem_axi_araddr     ( s_araddr                      ),
+        .mem_axi_arprot     ( axi_master_intf[i].ar_prot    ),
+        .mem_axi_rvalid     ( s_core_rvalid                 ),
+        .mem_axi_rready     ( s_core_rready                 ),
+        .mem_axi_rdata      ( axi_master_intf[i].r_data     ),
+
+        // Pico Co-Processor Interface (PCPI)
+        .pcpi_valid   ( s_pcpi_valid  ),
+        .pcpi_insn    ( s_pcpi_insn   ),
+        .pcpi_rs1     ( s_pcpi_rs1    ),
+        .pcpi_rs2     ( s_pcpi_rs2    ),
+        .pcpi_wr      ( s_pcpi_wr     ),
+        .pcpi_rd      ( s_pcpi_rd     ),
+        .pcpi_wait    ( s_pcpi_wait   ),
+        .pcpi_ready   ( s_pcpi_ready  ),
+
+        // IRQ interface
+        .irq          ( s_core_irq    ),
+        .eoi          ( s_core_eoi    ),
+    
+        // Trace Interface
+        .trace_valid  ( /* OPEN */    ),
+        .trace_data   ( /* OPEN */    )
+      );
+
+    end
+  endgenerate
 
 
 endmodule : picorv32_soc_top
@@ -0,0 +1,260 @@
+// AXI4-Lite GPIO with atomic output updates, edge interrupts and per-pin PWM
+//
+// Register map (byte offsets):
+//   0x00  OUT           RW  Output value (compatible with the old axi_led register)
+//   0x04  OUT_SET       W   Write 1 to set output bits, reads OUT
+//   0x08  OUT_CLR       W   Write 1 to clear output bits, reads OUT
+//   0x0C  OUT_TGL       W   Write 1 to toggle output bits, reads OUT
+//   0x10  IN            RO  Synchronized and debounced input pins
+//   0x14  IRQ_RISE_EN   RW  Bit n flags a rising edge on input n in IRQ_STATUS
+//   0x18  IRQ_FALL_EN   RW  Bit n flags a falling edge on input n in IRQ_STATUS
+//   0x1C  IRQ_STATUS    RW  Pending edges, write 1 to clear. o_irq is high while any bit is set.
+//   0x20  PWM_EN        RW  Bit n drives output n from its PWM channel instead of OUT[n]
+//   0x24  PWM_PERIOD    RW  PWM counter counts 0 .. PWM_PERIOD
+//   0x28  PWM_PRESCALE  RW  PWM counter advances every PWM_PRESCALE + 1 clock cycles
+//   0x40 + 4*n  PWM_DUTY[n]  RW  Output n is high while the PWM counter is below PWM_DUTY[n]
+//
+// Inputs pass a two flop synchronizer and are then sampled once every DEBOUNCE_CYCLES_p clock
+// cycles, which filters mechanical bounce shorter than the sample period. The first sample is
+// taken as soon as the synchronizer holds the pins, so IN is valid a few cycles after reset and
+// can be read as a boot strap. All PWM channels share one counter, so they run at the same
+// frequency and are phase aligned.
+module axi_gpio #(
+  parameter int unsigned AXI_ADDR_BW_p     = 12,
+  parameter int unsigned OUT_NBR_p         = 8,
+  parameter int unsigned IN_NBR_p          = 13,
+  parameter int unsigned PWM_BW_p          = 16,
+  parameter int unsigned DEBOUNCE_CYCLES_p = 1000000
+)(
+  input  logic                     clk,
+  input  logic                     rst_n,
+  input  logic [AXI_ADDR_BW_p-1:0] i_axi_awaddr,
+  input  logic                     i_axi_awvalid,
+  input  logic [31:0]              i_axi_wdata,
+  input  logic                     i_axi_wvalid,
+  input  logic                     i_axi_bready,
+  input  logic [AXI_ADDR_BW_p-1:0] i_axi_araddr,
+  input  logic                     i_axi_arvalid,
+  input  logic                     i_axi_rready,
+  output logic                     o_axi_awready,
+  output logic                     o_axi_wready,
+  output logic [1:0]               o_axi_bresp,
+  output logic                     o_axi_bvalid,
+  output logic                     o_axi_arready,
+  output logic [31:0]              o_axi_rdata,
+  output logic [1:0]               o_axi_rresp,
+  output logic                     o_axi_rvalid,
+  output logic [OUT_NBR_p-1:0]     o_gpio,
+  input  logic [IN_NBR_p-1:0]      i_gpio,
+  output logic                     o_irq
+);
+
+  localparam logic [1:0] RESP_OKAY = 2'b00;
+
+  localparam int unsigned DEB_BW_p = (DEBOUNCE_CYCLES_p > 1) ? $clog2(DEBOUNCE_CYCLES_p) : 1;
+  localparam int unsigned DEB_FIRST_p = (DEBOUNCE_CYCLES_p > 3) ? DEBOUNCE_CYCLES_p - 3 : 0;
+
+  localparam logic [7:0] ADDR_OUT          = 8'h00;
+  localparam logic [7:0] ADDR_OUT_SET      = 8'h04;
+  localparam logic [7:0] ADDR_OUT_CLR      = 8'h08;
+  localparam logic [7:0] ADDR_OUT_TGL      = 8'h0C;
+  localparam logic [7:0] ADDR_IN           = 8'h10;
+  localparam logic [7:0] ADDR_IRQ_RISE_EN  = 8'h14;
+  localparam logic [7:0] ADDR_IRQ_FALL_EN  = 8'h18;
+  localparam logic [7:0] ADDR_IRQ_STATUS   = 8'h1C;
+  localparam logic [7:0] ADDR_PWM_EN       = 8'h20;
+  localparam logic [7:0] ADDR_PWM_PERIOD   = 8'h24;
+  localparam logic [7:0] ADDR_PWM_PRESCALE = 8'h28;
+  localparam logic [7:0] ADDR_PWM_DUTY     = 8'h40;
+
+  // Registers
+  logic [OUT_NBR_p-1:0] out;
+  logic [IN_NBR_p-1:0]  irq_rise_en;
+  logic [IN_NBR_p-1:0]  irq_fall_en;
+  logic [IN_NBR_p-1:0]  irq_status;
+  logic [OUT_NBR_p-1:0] pwm_en;
+  logic [PWM_BW_p-1:0]  pwm_period;
+  logic [PWM_BW_p-1:0]  pwm_prescale;
+  logic [PWM_BW_p-1:0]  pwm_duty [OUT_NBR_p];
+
+  // --------------------------------------------------------------------------
+  // Address decode
+  // --------------------------------------------------------------------------
+  logic [7:0] s_waddr;
+  logic [7:0] s_raddr;
+
+  assign s_waddr = 8'(i_axi_awaddr) & 8'hFC;
+  assign s_raddr = 8'(i_axi_araddr) & 8'hFC;
+
+  // Write and read requests are accepted when both AW and W are present and the previous
+  // response has been taken, so every register access completes in a single cycle.
+  logic s_wr_en;
+  logic s_rd_en;
+
+  assign s_wr_en       = i_axi_awvalid & i_axi_wvalid & (~o_axi_bvalid | i_axi_bready);
+  assign s_rd_en       = i_axi_arvalid & (~o_axi_rvalid | i_axi_rready);
+  assign o_axi_awready = s_wr_en;
+  assign o_axi_wready  = s_wr_en;
+  assign o_axi_arready = s_rd_en;
+
+  // --------------------------------------------------------------------------
+  // Inputs: synchronizer, debounce sampling and edge detection
+  // --------------------------------------------------------------------------
+  logic [IN_NBR_p-1:0] in_meta;
+  logic [IN_NBR_p-1:0] in_sync;
+  logic [IN_NBR_p-1:0] in_deb;
+  logic [IN_NBR_p-1:0] in_deb_q;
+  logic [DEB_BW_p-1:0] deb_cnt;
+  logic                s_deb_tick;
+  logic [IN_NBR_p-1:0] s_rise;
+  logic [IN_NBR_p-1:0] s_fall;
+
+  assign s_deb_tick = (DEBOUNCE_CYCLES_p <= 1) || (deb_cnt == DEB_BW_p'(DEBOUNCE_CYCLES_p - 1));
+
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      in_meta  <= '0;
+      in_sync  <= '0;
+      in_deb   <= '0;
+      in_deb_q <= '0;
+      deb_cnt  <= DEB_BW_p'(DEB_FIRST_p);
+    end else begin
+      in_meta  <= i_gpio;
+      in_sync  <= in_meta;
+      in_deb_q <= in_deb;
+      deb_cnt  <= s_deb_tick ? '0 : deb_cnt + 1'b1;
+      if (s_deb_tick) begin
+        in_deb <= in_sync;
+      end
+    end
+  end
+
+  assign s_rise = in_deb & ~in_deb_q;
+  assign s_fall = ~in_deb & in_deb_q;
+  assign o_irq  = |irq_status;
+
+  // --------------------------------------------------------------------------
+  // Control registers
+  // --------------------------------------------------------------------------
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      out          <= '0;
+      irq_rise_en  <= '0;
+      irq_fall_en  <= '0;
+      irq_status   <= '0;
+      pwm_en       <= '0;
+      pwm_period   <= '1;
+      pwm_prescale <= '0;
+      for (int n = 0; n < OUT_NBR_p; n++) begin
+        pwm_duty[n] <= '0;
+      end
+    end else begin
+      // New edges are set after the clear, so an edge arriving with the W1C is not lost
+      if (s_wr_en && s_waddr == ADDR_IRQ_STATUS) begin
+        irq_status <= (irq_status & ~i_axi_wdata[IN_NBR_p-1:0]) |
+                      (s_rise & irq_rise_en) | (s_fall & irq_fall_en);
+      end else begin
+        irq_status <= irq_status | (s_rise & irq_rise_en) | (s_fall & irq_fall_en);
+      end
+
+      if (s_wr_en) begin
+        unique case (s_waddr)
+          ADDR_OUT:          out          <= i_axi_wdata[OUT_NBR_p-1:0];
+          ADDR_OUT_SET:      out          <= out |  i_axi_wdata[OUT_NBR_p-1:0];
+          ADDR_OUT_CLR:      out          <= out & ~i_axi_wdata[OUT_NBR_p-1:0];
+          ADDR_OUT_TGL:      out          <= out ^  i_axi_wdata[OUT_NBR_p-1:0];
+          ADDR_IRQ_RISE_EN:  irq_rise_en  <= i_axi_wdata[IN_NBR_p-1:0];
+          ADDR_IRQ_FALL_EN:  irq_fall_en  <= i_axi_wdata[IN_NBR_p-1:0];
+          ADDR_PWM_EN:       pwm_en       <= i_axi_wdata[OUT_NBR_p-1:0];
+          ADDR_PWM_PERIOD:   pwm_period   <= i_axi_wdata[PWM_BW_p-1:0];
+          ADDR_PWM_PRESCALE: pwm_prescale <= i_axi_wdata[PWM_BW_p-1:0];
+          default: ;
+        endcase
+        for (int n = 0; n < OUT_NBR_p; n++) begin
+          if (s_waddr == ADDR_PWM_DUTY + 8'(4*n)) begin
+            pwm_duty[n] <= i_axi_wdata[PWM_BW_p-1:0];
+          end
+        end
+      end
+    end
+  end
+
+  // --------------------------------------------------------------------------
+  // PWM
+  // --------------------------------------------------------------------------
+  logic [PWM_BW_p-1:0]  pwm_div;
+  logic [PWM_BW_p-1:0]  pwm_cnt;
+  logic [OUT_NBR_p-1:0] pwm_out;
+
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      pwm_div <= '0;
+      pwm_cnt <= '0;
+      pwm_out <= '0;
+    end else begin
+      if (pwm_div >= pwm_prescale) begin
+        pwm_div <= '0;
+        pwm_cnt <= (pwm_cnt >= pwm_period) ? '0 : pwm_cnt + 1'b1;
+      end else begin
+        pwm_div <= pwm_div + 1'b1;
+      end
+      for (int n = 0; n < OUT_NBR_p; n++) begin
+        pwm_out[n] <= pwm_cnt < pwm_duty[n];
+      end
+    end
+  end
+
+  assign o_gpio = (pwm_en & pwm_out) | (~pwm_en & out);
+
+  // --------------------------------------------------------------------------
+  // Responses
+  // --------------------------------------------------------------------------
+  logic [31:0] s_rdata;
+
+  always_comb begin
+    unique case (s_raddr)
+      ADDR_OUT,
+      ADDR_OUT_SET,
+      ADDR_OUT_CLR,
+      ADDR_OUT_TGL:      s_rdata = 32'(out);
+      ADDR_IN:           s_rdata = 32'(in_deb);
+      ADDR_IRQ_RISE_EN:  s_rdata = 32'(irq_rise_en);
+      ADDR_IRQ_FALL_EN:  s_rdata = 32'(irq_fall_en);
+      ADDR_IRQ_STATUS:   s_rdata = 32'(irq_status);
+      ADDR_PWM_EN:       s_rdata = 32'(pwm_en);
+      ADDR_PWM_PERIOD:   s_rdata = 32'(pwm_period);
+      ADDR_PWM_PRESCALE: s_rdata = 32'(pwm_prescale);
+      default:           s_rdata = '0;
+    endcase
+    for (int n = 0; n < OUT_NBR_p; n++) begin
+      if (s_raddr == ADDR_PWM_DUTY + 8'(4*n)) begin
+        s_rdata = 32'(pwm_duty[n]);
+      end
+    end
+  end
+
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      o_axi_bvalid <= 1'b0;
+      o_axi_rvalid <= 1'b0;
+      o_axi_rdata  <= '0;
+    end else begin
+      if (s_wr_en) begin
+        o_axi_bvalid <= 1'b1;
+      end else if (i_axi_bready) begin
+        o_axi_bvalid <= 1'b0;
+      end
+
+      if (s_rd_en) begin
+        o_axi_rvalid <= 1'b1;
+        o_axi_rdata  <= s_rdata;
+      end else if (i_axi_rready) begin
+        o_axi_rvalid <= 1'b0;
+      end
+    end
+  end
+
+  assign o_axi_bresp = RESP_OKAY;
+  assign o_axi_rresp = RESP_OKAY;
+
+endmodule : axi_gpio
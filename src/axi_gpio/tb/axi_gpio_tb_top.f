@@ -0,0 +1,2 @@
+$AXI_GPIO_PROJ_ROOT/rtl/axi_gpio.sv
+$AXI_GPIO_PROJ_ROOT/tb/axi_gpio_tb_top.sv
@@ -0,0 +1,217 @@
+module axi_gpio_tb_top ();
+
+  timeunit 1ns;
+  timeprecision 1ps;
+
+  localparam int unsigned OUT_NBR  = 8;
+  localparam int unsigned IN_NBR   = 13;
+  localparam int unsigned DEBOUNCE = 8;
+
+  localparam logic [11:0] OUT          = 12'h00;
+  localparam logic [11:0] OUT_SET      = 12'h04;
+  localparam logic [11:0] OUT_CLR      = 12'h08;
+  localparam logic [11:0] OUT_TGL      = 12'h0C;
+  localparam logic [11:0] IN           = 12'h10;
+  localparam logic [11:0] IRQ_RISE_EN  = 12'h14;
+  localparam logic [11:0] IRQ_FALL_EN  = 12'h18;
+  localparam logic [11:0] IRQ_STATUS   = 12'h1C;
+  localparam logic [11:0] PWM_EN       = 12'h20;
+  localparam logic [11:0] PWM_PERIOD   = 12'h24;
+  localparam logic [11:0] PWM_PRESCALE = 12'h28;
+  localparam logic [11:0] PWM_DUTY     = 12'h40;
+
+  logic               tb_clk;
+  logic               tb_rst_n;
+  logic [11:0]        tb_axi_awaddr;
+  logic               tb_axi_awvalid;
+  logic [31:0]        tb_axi_wdata;
+  logic               tb_axi_wvalid;
+  logic               tb_axi_bready;
+  logic [11:0]        tb_axi_araddr;
+  logic               tb_axi_arvalid;
+  logic               tb_axi_rready;
+  logic               dut_axi_awready;
+  logic               dut_axi_wready;
+  logic [1:0]         dut_axi_bresp;
+  logic               dut_axi_bvalid;
+  logic               dut_axi_arready;
+  logic [31:0]        dut_axi_rdata;
+  logic [1:0]         dut_axi_rresp;
+  logic               dut_axi_rvalid;
+  logic [OUT_NBR-1:0] dut_gpio;
+  logic [IN_NBR-1:0]  tb_gpio;
+  logic               dut_irq;
+
+  int errors = 0;
+
+  // Generate clock
+  initial begin
+    tb_clk <= 1'b0;
+    forever #5ns tb_clk <= ~tb_clk;
+  end
+
+  task automatic axi_write(input logic [11:0] addr, input logic [31:0] data);
+    @(posedge tb_clk);
+    tb_axi_awaddr  <= addr;
+    tb_axi_awvalid <= 1'b1;
+    tb_axi_wdata   <= data;
+    tb_axi_wvalid  <= 1'b1;
+    tb_axi_bready  <= 1'b1;
+    do @(posedge tb_clk); while (!dut_axi_awready);
+    tb_axi_awvalid <= 1'b0;
+    tb_axi_wvalid  <= 1'b0;
+    while (!dut_axi_bvalid) @(posedge tb_clk);
+    @(posedge tb_clk);
+    tb_axi_bready  <= 1'b0;
+  endtask
+
+  task automatic axi_read(input logic [11:0] addr, output logic [31:0] data);
+    @(posedge tb_clk);
+    tb_axi_araddr  <= addr;
+    tb_axi_arvalid <= 1'b1;
+    tb_axi_rready  <= 1'b1;
+    do @(posedge tb_clk); while (!dut_axi_arready);
+    tb_axi_arvalid <= 1'b0;
+    while (!dut_axi_rvalid) @(posedge tb_clk);
+    data = dut_axi_rdata;
+    @(posedge tb_clk);
+    tb_axi_rready  <= 1'b0;
+  endtask
+
+  task automatic check_reg(input string name, input logic [11:0] addr, input logic [31:0] expected);
+    logic [31:0] data;
+    axi_read(addr, data);
+    if (data !== expected) begin
+      $error("%s: read %03h got %08h, expected %08h", name, addr, data, expected);
+      errors++;
+    end
+  endtask
+
+  // Count the high cycles of output n over cycles clock cycles
+  task automatic count_high(input int n, input int cycles, output int high);
+    high = 0;
+    repeat (cycles) begin
+      @(posedge tb_clk);
+      high += dut_gpio[n];
+    end
+  endtask
+
+  initial begin
+    int high;
+
+    tb_rst_n       <= 1'b0;
+    tb_axi_awaddr  <= '0;
+    tb_axi_awvalid <= 1'b0;
+    tb_axi_wdata   <= '0;
+    tb_axi_wvalid  <= 1'b0;
+    tb_axi_bready  <= 1'b0;
+    tb_axi_araddr  <= '0;
+    tb_axi_arvalid <= 1'b0;
+    tb_axi_rready  <= 1'b0;
+    tb_gpio        <= '0;
+    repeat (5) @(posedge tb_clk);
+    tb_rst_n <= 1'b1;
+
+    // Atomic output updates
+    axi_write(OUT, 32'h0000_00A5);
+    check_reg("out", OUT, 32'h0000_00A5);
+    axi_write(OUT_SET, 32'h0000_0003);
+    check_reg("set", OUT, 32'h0000_00A7);
+    axi_write(OUT_CLR, 32'h0000_0081);
+    check_reg("clear", OUT, 32'h0000_0026);
+    axi_write(OUT_TGL, 32'h0000_00FF);
+    check_reg("toggle", OUT_TGL, 32'h0000_00D9);
+    if (dut_gpio !== 8'hD9) begin
+      $error("pins %02h, expected D9", dut_gpio);
+      errors++;
+    end
+
+    // Inputs show up after the synchronizer and the next debounce sample
+    tb_gpio <= 13'h1001;
+    repeat (4 * DEBOUNCE) @(posedge tb_clk);
+    check_reg("input", IN, 32'h0000_1001);
+    tb_gpio <= 13'h0000;
+    repeat (4 * DEBOUNCE) @(posedge tb_clk);
+
+    // Edge interrupts: rising on input 0, falling on input 12
+    axi_write(IRQ_RISE_EN, 32'h0000_0001);
+    axi_write(IRQ_FALL_EN, 32'h0000_1000);
+    tb_gpio <= 13'h1001;
+    repeat (4 * DEBOUNCE) @(posedge tb_clk);
+    if (dut_irq !== 1'b1) begin
+      $error("IRQ not raised on a rising edge");
+      errors++;
+    end
+    check_reg("rise status", IRQ_STATUS, 32'h0000_0001);
+    axi_write(IRQ_STATUS, 32'h0000_0001);
+    if (dut_irq !== 1'b0) begin
+      $error("IRQ still set after clearing");
+      errors++;
+    end
+    tb_gpio <= 13'h0000;
+    repeat (4 * DEBOUNCE) @(posedge tb_clk);
+    check_reg("fall status", IRQ_STATUS, 32'h0000_1000);
+    axi_write(IRQ_STATUS, 32'h0000_1000);
+    check_reg("status cleared", IRQ_STATUS, 32'h0000_0000);
+
+    // PWM: 3/8 duty on output 2, output 5 always on, other outputs follow OUT
+    axi_write(OUT, 32'h0000_0000);
+    axi_write(PWM_PRESCALE, 32'h0000_0001);
+    axi_write(PWM_PERIOD, 32'h0000_0007);
+    axi_write(PWM_DUTY + 4 * 2, 32'h0000_0003);
+    axi_write(PWM_DUTY + 4 * 5, 32'h0000_0008);
+    axi_write(PWM_EN, 32'h0000_0024);
+    check_reg("duty", PWM_DUTY + 4 * 2, 32'h0000_0003);
+    count_high(2, 160, high);
+    if (high != 60) begin
+      $error("PWM output 2 high for %0d of 160 cycles, expected 60", high);
+      errors++;
+    end
+    count_high(5, 160, high);
+    if (high != 160) begin
+      $error("PWM output 5 high for %0d of 160 cycles, expected 160", high);
+      errors++;
+    end
+    if (dut_gpio[0] !== 1'b0) begin
+      $error("output 0 driven while PWM is disabled for it");
+      errors++;
+    end
+
+    if (errors == 0) begin
+      $display("PASSED");
+    end else begin
+      $display("FAILED with %0d errors", errors);
+    end
+    $finish;
+  end
+
+  axi_gpio #(
+    .AXI_ADDR_BW_p     ( 12       ),
+    .OUT_NBR_p         ( OUT_NBR  ),
+    .IN_NBR_p          ( IN_NBR   ),
+    .DEBOUNCE_CYCLES_p ( DEBOUNCE )
+  ) axi_gpio_dut_i (
+    .clk            ( tb_clk            ),
+    .rst_n          ( tb_rst_n          ),
+    .i_axi_awaddr   ( tb_axi_awaddr     ),
+    .i_axi_awvalid  ( tb_axi_awvalid    ),
+    .i_axi_wdata    ( tb_axi_wdata      ),
+    .i_axi_wvalid   ( tb_axi_wvalid     ),
+    .i_axi_bready   ( tb_axi_bready     ),
+    .i_axi_araddr   ( tb_axi_araddr     ),
+    .i_axi_arvalid  ( tb_axi_arvalid    ),
+    .i_axi_rready   ( tb_axi_rready     ),
+    .o_axi_awready  ( dut_axi_awready   ),
+    .o_axi_wready   ( dut_axi_wready    ),
+    .o_axi_bresp    ( dut_axi_bresp     ),
+    .o_axi_bvalid   ( dut_axi_bvalid    ),
+    .o_axi_arready  ( dut_axi_arready   ),
+    .o_axi_rdata    ( dut_axi_rdata     ),
+    .o_axi_rresp    ( dut_axi_rresp     ),
+    .o_axi_rvalid   ( dut_axi_rvalid    ),
+    .o_gpio         ( dut_gpio          ),
+    .i_gpio         ( tb_gpio           ),
+    .o_irq          ( dut_irq           )
+  );
+
+endmodule : axi_gpio_tb_top
@@ -0,0 +1,277 @@
+// AXI4-Lite posted-write buffer
+//
+// Sits between a CPU and the interconnect. A write is stored in a DEPTH_p entry FIFO and
+// acknowledged (OKAY) on the next cycle, the FIFO drains to the master port in order with one
+// write in flight per entry. Entries stay in the FIFO until their B response returns.
+//
+// Writes in flight all target the same 2^REGION_BW_p byte region. A write to another region
+// waits until the earlier ones have their B response, since different slaves answer through
+// different crossbar paths and could complete out of order. A store to a flag or lock therefore
+// never becomes visible before the data stored ahead of it.
+//
+// Ordering: a read is held back while any buffered or in-flight write targets the same
+// 2^REGION_BW_p byte region (4KB by default, the size of a peripheral slot), so a load always
+// observes earlier stores to the same peripheral or memory page. Reads of other regions pass.
+//
+// Errors: the CPU has already moved on when a SLVERR/DECERR arrives, so errors are counted and
+// o_irq is held high until firmware reads the DRAIN register. Two registers are answered
+// locally instead of being forwarded:
+//   DRAIN_ADDR_p + 0x0  DRAIN     Read stalls until every buffered write has completed, then
+//                                 returns the number of failed writes since the last read
+//                                 (saturating at 0xFFFF) and clears it and o_irq.
+//   DRAIN_ADDR_p + 0x4  ERR_ADDR  Address of the last write that failed. Does not drain.
+// Writes to these addresses are forwarded like any other write.
+module axi_lite_write_buffer #(
+  parameter int unsigned AXI_ADDR_BW_p = 32,
+  parameter int unsigned DEPTH_p       = 4,
+  parameter int unsigned REGION_BW_p   = 12,
+  parameter logic [31:0] DRAIN_ADDR_p  = 32'h0000_0FF0
+)(
+  input  logic                     clk,
+  input  logic                     rst_n,
+  // Slave port, from the CPU
+  input  logic [AXI_ADDR_BW_p-1:0] i_s_axi_awaddr,
+  input  logic [2:0]               i_s_axi_awprot,
+  input  logic                     i_s_axi_awvalid,
+  output logic                     o_s_axi_awready,
+  input  logic [31:0]              i_s_axi_wdata,
+  input  logic [3:0]               i_s_axi_wstrb,
+  input  logic                     i_s_axi_wvalid,
+  output logic                     o_s_axi_wready,
+  output logic [1:0]               o_s_axi_bresp,
+  output logic                     o_s_axi_bvalid,
+  input  logic                     i_s_axi_bready,
+  input  logic [AXI_ADDR_BW_p-1:0] i_s_axi_araddr,
+  input  logic [2:0]               i_s_axi_arprot,
+  input  logic                     i_s_axi_arvalid,
+  output logic                     o_s_axi_arready,
+  output logic [31:0]              o_s_axi_rdata,
+  output logic [1:0]               o_s_axi_rresp,
+  output logic                     o_s_axi_rvalid,
+  input  logic                     i_s_axi_rready,
+  // Master port, to the interconnect
+  output logic [AXI_ADDR_BW_p-1:0] o_m_axi_awaddr,
+  output logic [2:0]               o_m_axi_awprot,
+  output logic                     o_m_axi_awvalid,
+  input  logic                     i_m_axi_awready,
+  output logic [31:0]              o_m_axi_wdata,
+  output logic [3:0]               o_m_axi_wstrb,
+  output logic                     o_m_axi_wvalid,
+  input  logic                     i_m_axi_wready,
+  input  logic [1:0]               i_m_axi_bresp,
+  input  logic                     i_m_axi_bvalid,
+  output logic                     o_m_axi_bready,
+  output logic [AXI_ADDR_BW_p-1:0] o_m_axi_araddr,
+  output logic [2:0]               o_m_axi_arprot,
+  output logic                     o_m_axi_arvalid,
+  input  logic                     i_m_axi_arready,
+  input  logic [31:0]              i_m_axi_rdata,
+  input  logic [1:0]               i_m_axi_rresp,
+  input  logic                     i_m_axi_rvalid,
+  output logic                     o_m_axi_rready,
+  // Write error interrupt (level)
+  output logic                     o_irq
+);
+
+  localparam logic [1:0] RESP_OKAY = 2'b00;
+
+  localparam int unsigned PTR_BW_p = (DEPTH_p > 1) ? $clog2(DEPTH_p) : 1;
+  localparam int unsigned CNT_BW_p = $clog2(DEPTH_p + 1);
+
+  typedef struct packed {
+    logic [AXI_ADDR_BW_p-1:0] addr;
+    logic [2:0]               prot;
+    logic [31:0]              data;
+    logic [3:0]               strb;
+  } entry_t;
+
+  entry_t                fifo [DEPTH_p];
+  logic [DEPTH_p-1:0]    valid;       // Buffered or in flight
+  logic [PTR_BW_p-1:0]   wr_ptr;      // Next free entry
+  logic [PTR_BW_p-1:0]   iss_ptr;     // Next entry to send
+  logic [PTR_BW_p-1:0]   rsp_ptr;     // Oldest entry, waiting for its B response
+  logic [CNT_BW_p-1:0]   count;
+  logic [CNT_BW_p-1:0]   iss_count;   // Entries not sent yet
+  // Region of the writes in flight
+  logic [AXI_ADDR_BW_p-1:REGION_BW_p] iss_region;
+  logic                  aw_done;
+  logic                  w_done;
+
+  function automatic logic [PTR_BW_p-1:0] ptr_inc(input logic [PTR_BW_p-1:0] ptr);
+    return (ptr == PTR_BW_p'(DEPTH_p - 1)) ? '0 : ptr + 1'b1;
+  endfunction
+
+  // --------------------------------------------------------------------------
+  // Slave write channel: accept into the FIFO, respond immediately
+  // --------------------------------------------------------------------------
+  logic s_push;
+  logic s_full;
+
+  assign s_full          = count == CNT_BW_p'(DEPTH_p);
+  assign s_push          = i_s_axi_awvalid & i_s_axi_wvalid & ~s_full &
+                           (~o_s_axi_bvalid | i_s_axi_bready);
+  assign o_s_axi_awready = s_push;
+  assign o_s_axi_wready  = s_push;
+  assign o_s_axi_bresp   = RESP_OKAY;
+
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      o_s_axi_bvalid <= 1'b0;
+    end else if (s_push) begin
+      o_s_axi_bvalid <= 1'b1;
+    end else if (i_s_axi_bready) begin
+      o_s_axi_bvalid <= 1'b0;
+    end
+  end
+
+  always_ff @(posedge clk) begin
+    if (s_push) begin
+      fifo[wr_ptr] <= '{addr: i_s_axi_awaddr, prot: i_s_axi_awprot,
+                        data: i_s_axi_wdata,  strb: i_s_axi_wstrb};
+    end
+  end
+
+  // --------------------------------------------------------------------------
+  // Master write channel: send entries in order, retire them on B
+  // --------------------------------------------------------------------------
+  logic s_issue;
+  logic s_retire;
+  logic s_aw_ok;
+  logic s_w_ok;
+  logic s_iss_ok;
+
+  // Nothing in flight, or the next entry goes to the same region as the writes in flight
+  assign s_iss_ok = (iss_count != '0) &
+                    (count == iss_count ||
+                     fifo[iss_ptr].addr[AXI_ADDR_BW_p-1:REGION_BW_p] == iss_region);
+
+  assign o_m_axi_awaddr  = fifo[iss_ptr].addr;
+  assign o_m_axi_awprot  = fifo[iss_ptr].prot;
+  assign o_m_axi_wdata   = fifo[iss_ptr].data;
+  assign o_m_axi_wstrb   = fifo[iss_ptr].strb;
+  assign o_m_axi_awvalid = s_iss_ok & ~aw_done;
+  assign o_m_axi_wvalid  = s_iss_ok & ~w_done;
+  assign o_m_axi_bready  = 1'b1;
+
+  assign s_aw_ok  = aw_done | (o_m_axi_awvalid & i_m_axi_awready);
+  assign s_w_ok   = w_done  | (o_m_axi_wvalid  & i_m_axi_wready);
+  assign s_issue  = s_iss_ok & s_aw_ok & s_w_ok;
+  assign s_retire = i_m_axi_bvalid;
+
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      valid      <= '0;
+      wr_ptr     <= '0;
+      iss_ptr    <= '0;
+      rsp_ptr    <= '0;
+      count      <= '0;
+      iss_count  <= '0;
+      iss_region <= '0;
+      aw_done    <= 1'b0;
+      w_done     <= 1'b0;
+    end else begin
+      if (s_push) begin
+        wr_ptr <= ptr_inc(wr_ptr);
+      end
+      if (s_issue) begin
+        iss_ptr    <= ptr_inc(iss_ptr);
+        iss_region <= fifo[iss_ptr].addr[AXI_ADDR_BW_p-1:REGION_BW_p];
+        aw_done    <= 1'b0;
+        w_done     <= 1'b0;
+      end else begin
+        aw_done <= s_aw_ok;
+        w_done  <= s_w_ok;
+      end
+      if (s_retire) begin
+        rsp_ptr <= ptr_inc(rsp_ptr);
+      end
+
+      // Set after clear, the same entry is never pushed and retired in one cycle
+      for (int j = 0; j < DEPTH_p; j++) begin
+        if (s_retire && rsp_ptr == PTR_BW_p'(j)) begin
+          valid[j] <= 1'b0;
+        end
+        if (s_push && wr_ptr == PTR_BW_p'(j)) begin
+          valid[j] <= 1'b1;
+        end
+      end
+
+      count     <= count + CNT_BW_p'(s_push) - CNT_BW_p'(s_retire);
+      iss_count <= iss_count + CNT_BW_p'(s_push) - CNT_BW_p'(s_issue);
+    end
+  end
+
+  // --------------------------------------------------------------------------
+  // Write errors
+  // --------------------------------------------------------------------------
+  logic [15:0]              err_count;
+  logic [AXI_ADDR_BW_p-1:0] err_addr;
+  logic                     s_err;
+  logic                     s_drain_rd;
+
+  assign s_err = s_retire && i_m_axi_bresp != RESP_OKAY;
+  assign o_irq = err_count != '0;
+
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      err_count <= '0;
+      err_addr  <= '0;
+    end else begin
+      if (s_drain_rd) begin
+        err_count <= 16'(s_err);
+      end else if (s_err && err_count != '1) begin
+        err_count <= err_count + 1'b1;
+      end
+      if (s_err) begin
+        err_addr <= fifo[rsp_ptr].addr;
+      end
+    end
+  end
+
+  // --------------------------------------------------------------------------
+  // Read channel
+  // --------------------------------------------------------------------------
+  logic [DEPTH_p-1:0] s_conflict;
+  logic               s_hazard;
+  logic               s_local;
+  logic               s_local_rd;
+  logic               local_rvalid;
+  logic [31:0]        local_rdata;
+
+  // Pending writes to the region of the read
+  always_comb begin
+    for (int j = 0; j < DEPTH_p; j++) begin
+      s_conflict[j] = valid[j] &&
+        fifo[j].addr[AXI_ADDR_BW_p-1:REGION_BW_p] == i_s_axi_araddr[AXI_ADDR_BW_p-1:REGION_BW_p];
+    end
+  end
+
+  assign s_hazard   = |s_conflict;
+  assign s_local    = i_s_axi_araddr[AXI_ADDR_BW_p-1:3] == DRAIN_ADDR_p[AXI_ADDR_BW_p-1:3];
+  assign s_local_rd = i_s_axi_arvalid & s_local & ~local_rvalid & ~i_m_axi_rvalid &
+                      (i_s_axi_araddr[2] | count == '0);
+  assign s_drain_rd = s_local_rd & ~i_s_axi_araddr[2];
+
+  assign o_m_axi_araddr  = i_s_axi_araddr;
+  assign o_m_axi_arprot  = i_s_axi_arprot;
+  assign o_m_axi_arvalid = i_s_axi_arvalid & ~s_local & ~s_hazard;
+  assign o_s_axi_arready = s_local ? s_local_rd : (~s_hazard & i_m_axi_arready);
+
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      local_rvalid <= 1'b0;
+      local_rdata  <= '0;
+    end else if (s_local_rd) begin
+      local_rvalid <= 1'b1;
+      local_rdata  <= i_s_axi_araddr[2] ? 32'(err_addr) : {16'b0, err_count};
+    end else if (i_s_axi_rready) begin
+      local_rvalid <= 1'b0;
+    end
+  end
+
+  assign o_s_axi_rvalid = local_rvalid | i_m_axi_rvalid;
+  assign o_s_axi_rdata  = local_rvalid ? local_rdata : i_m_axi_rdata;
+  assign o_s_axi_rresp  = local_rvalid ? RESP_OKAY : i_m_axi_rresp;
+  assign o_m_axi_rready = i_s_axi_rready & ~local_rvalid;
+
+endmodule : axi_lite_write_buffer
@@ -0,0 +1,2 @@
+$AXI_LITE_WRITE_BUFFER_PROJ_ROOT/rtl/axi_lite_write_buffer.sv
+$AXI_LITE_WRITE_BUFFER_PROJ_ROOT/tb/axi_lite_write_buffer_tb_top.sv
@@ -0,0 +1,312 @@
+module axi_lite_write_buffer_tb_top ();
+
+  timeunit 1ns;
+  timeprecision 1ps;
+
+  localparam int unsigned DEPTH       = 4;
+  localparam int unsigned SLV_LATENCY = 8;     // Slave write response latency
+  localparam logic [31:0] DRAIN       = 32'h0000_0FF0;
+  localparam logic [31:0] ERR_ADDR    = 32'h0000_0FF4;
+  localparam logic [31:0] BAD_ADDR    = 32'h0000_5000; // Slave answers SLVERR
+
+  logic        tb_clk;
+  logic        tb_rst_n;
+
+  // CPU side
+  logic [31:0] cpu_awaddr;
+  logic        cpu_awvalid;
+  logic        cpu_awready;
+  logic [31:0] cpu_wdata;
+  logic        cpu_wvalid;
+  logic        cpu_wready;
+  logic [1:0]  cpu_bresp;
+  logic        cpu_bvalid;
+  logic        cpu_bready;
+  logic [31:0] cpu_araddr;
+  logic        cpu_arvalid;
+  logic        cpu_arready;
+  logic [31:0] cpu_rdata;
+  logic [1:0]  cpu_rresp;
+  logic        cpu_rvalid;
+  logic        cpu_rready;
+
+  // Slave side
+  logic [31:0] slv_awaddr;
+  logic        slv_awvalid;
+  logic        slv_awready;
+  logic [31:0] slv_wdata;
+  logic [3:0]  slv_wstrb;
+  logic        slv_wvalid;
+  logic        slv_wready;
+  logic [1:0]  slv_bresp;
+  logic        slv_bvalid;
+  logic        slv_bready;
+  logic [31:0] slv_araddr;
+  logic        slv_arvalid;
+  logic        slv_arready;
+  logic [31:0] slv_rdata;
+  logic [1:0]  slv_rresp;
+  logic        slv_rvalid;
+  logic        slv_rready;
+
+  logic        dut_irq;
+
+  logic [31:0] slv_mem [logic [31:0]];
+
+  int errors = 0;
+
+  // Generate clock
+  initial begin
+    tb_clk <= 1'b0;
+    forever #5ns tb_clk <= ~tb_clk;
+  end
+
+  // --------------------------------------------------------------------------
+  // Slow slave: one write at a time, B after SLV_LATENCY cycles, reads in one cycle
+  // --------------------------------------------------------------------------
+  initial begin
+    slv_awready <= 1'b0;
+    slv_wready  <= 1'b0;
+    slv_bvalid  <= 1'b0;
+    slv_bresp   <= 2'b00;
+    forever begin
+      @(posedge tb_clk);
+      if (slv_awvalid && slv_wvalid && !slv_awready) begin
+        slv_awready <= 1'b1;
+        slv_wready  <= 1'b1;
+        @(posedge tb_clk);
+        slv_awready <= 1'b0;
+        slv_wready  <= 1'b0;
+        if (slv_awaddr == BAD_ADDR) begin
+          slv_bresp <= 2'b10;
+        end else begin
+          slv_bresp <= 2'b00;
+          slv_mem[slv_awaddr] = slv_wdata;
+        end
+        repeat (SLV_LATENCY) @(posedge tb_clk);
+        slv_bvalid <= 1'b1;
+        do @(posedge tb_clk); while (!slv_bready);
+        slv_bvalid <= 1'b0;
+      end
+    end
+  end
+
+  initial begin
+    slv_arready <= 1'b0;
+    slv_rvalid  <= 1'b0;
+    slv_rdata   <= '0;
+    slv_rresp   <= 2'b00;
+    forever begin
+      @(posedge tb_clk);
+      if (slv_arvalid) begin
+        slv_arready <= 1'b1;
+        @(posedge tb_clk);
+        slv_arready <= 1'b0;
+        slv_rvalid  <= 1'b1;
+        slv_rdata   <= slv_mem.exists(slv_araddr) ? slv_mem[slv_araddr] : 32'hDEAD_DEAD;
+        do @(posedge tb_clk); while (!slv_rready);
+        slv_rvalid  <= 1'b0;
+      end
+    end
+  end
+
+  // --------------------------------------------------------------------------
+  // Writes to another 4k region must wait until the ones in flight have their B response
+  // --------------------------------------------------------------------------
+  int unsigned slv_inflight = 0;
+  logic [31:0] slv_inflight_addr;
+
+  always @(posedge tb_clk) begin
+    if (slv_awvalid && slv_inflight != 0 && slv_awaddr[31:12] != slv_inflight_addr[31:12]) begin
+      $error("Write to %08h issued while a write to %08h is in flight", slv_awaddr,
+             slv_inflight_addr);
+      errors++;
+    end
+    if (slv_awvalid && slv_awready) begin
+      slv_inflight_addr = slv_awaddr;
+    end
+    slv_inflight = slv_inflight + (slv_awvalid && slv_awready) - (slv_bvalid && slv_bready);
+  end
+
+  // --------------------------------------------------------------------------
+  // CPU side tasks, one transaction at a time like PicoRV32
+  // --------------------------------------------------------------------------
+  task automatic cpu_write(input logic [31:0] addr, input logic [31:0] data, output int cycles);
+    @(posedge tb_clk);
+    cpu_awaddr  <= addr;
+    cpu_awvalid <= 1'b1;
+    cpu_wdata   <= data;
+    cpu_wvalid  <= 1'b1;
+    cpu_bready  <= 1'b1;
+    cycles = 0;
+    do begin
+      @(posedge tb_clk);
+      cycles++;
+    end while (!cpu_awready);
+    cpu_awvalid <= 1'b0;
+    cpu_wvalid  <= 1'b0;
+    while (!cpu_bvalid) begin
+      @(posedge tb_clk);
+      cycles++;
+    end
+    @(posedge tb_clk);
+    cpu_bready  <= 1'b0;
+  endtask
+
+  task automatic cpu_read(input logic [31:0] addr, output logic [31:0] data, output int cycles);
+    @(posedge tb_clk);
+    cpu_araddr  <= addr;
+    cpu_arvalid <= 1'b1;
+    cpu_rready  <= 1'b1;
+    cycles = 0;
+    do begin
+      @(posedge tb_clk);
+      cycles++;
+    end while (!cpu_arready);
+    cpu_arvalid <= 1'b0;
+    while (!cpu_rvalid) begin
+      @(posedge tb_clk);
+      cycles++;
+    end
+    data = cpu_rdata;
+    @(posedge tb_clk);
+    cpu_rready  <= 1'b0;
+  endtask
+
+  task automatic check(input string name, input logic [31:0] got, input logic [31:0] expected);
+    if (got !== expected) begin
+      $error("%s: got %08h, expected %08h", name, got, expected);
+      errors++;
+    end
+  endtask
+
+  initial begin
+    logic [31:0] data;
+    int          cycles;
+    int          total;
+
+    tb_rst_n    <= 1'b0;
+    cpu_awaddr  <= '0;
+    cpu_awvalid <= 1'b0;
+    cpu_wdata   <= '0;
+    cpu_wvalid  <= 1'b0;
+    cpu_bready  <= 1'b0;
+    cpu_araddr  <= '0;
+    cpu_arvalid <= 1'b0;
+    cpu_rready  <= 1'b0;
+    repeat (5) @(posedge tb_clk);
+    tb_rst_n <= 1'b1;
+
+    // Stores are acknowledged without waiting for the slave
+    total = 0;
+    for (int i = 0; i < DEPTH; i++) begin
+      cpu_write(32'h0000_4000 + 4 * i, 32'h1000 + i, cycles);
+      total += cycles;
+    end
+    if (total > 2 * DEPTH) begin
+      $error("%0d buffered stores took %0d cycles", DEPTH, total);
+      errors++;
+    end
+
+    // A read from another region passes the buffered stores
+    slv_mem[32'h0000_3000] = 32'hCAFE_F00D;
+    cpu_read(32'h0000_3000, data, cycles);
+    check("bypass read", data, 32'hCAFE_F00D);
+    if (cycles > SLV_LATENCY) begin
+      $error("bypass read waited %0d cycles for the buffer", cycles);
+      errors++;
+    end
+
+    // A read from the same region sees the last store
+    cpu_read(32'h0000_400C, data, cycles);
+    check("ordered read", data, 32'h1000 + DEPTH - 1);
+
+    // Data then flag in another region, the flag store waits for the data
+    cpu_write(32'h0000_4020, 32'h3000, cycles);
+    cpu_write(32'h0000_9100, 32'h0, cycles);
+    cpu_read(DRAIN, data, cycles);
+    check("ordered data", slv_mem[32'h0000_4020], 32'h3000);
+    check("ordered flag", slv_mem[32'h0000_9100], 32'h0);
+
+    // Drain with a failed write in the buffer
+    cpu_write(BAD_ADDR, 32'hBAD0_BAD0, cycles);
+    cpu_write(32'h0000_4010, 32'h2000, cycles);
+    cpu_read(DRAIN, data, cycles);
+    check("drain count", data, 32'd1);
+    check("drain done", slv_mem[32'h0000_4010], 32'h2000);
+    cpu_read(ERR_ADDR, data, cycles);
+    check("error address", data, BAD_ADDR);
+    if (dut_irq !== 1'b0) begin
+      $error("IRQ still set after drain");
+      errors++;
+    end
+
+    // Error interrupt without a drain
+    cpu_write(BAD_ADDR, 32'h0, cycles);
+    repeat (4 * SLV_LATENCY) @(posedge tb_clk);
+    if (dut_irq !== 1'b1) begin
+      $error("IRQ not raised for a failed write");
+      errors++;
+    end
+    cpu_read(DRAIN, data, cycles);
+    check("drain count 2", data, 32'd1);
+    cpu_read(DRAIN, data, cycles);
+    check("drain empty", data, 32'd0);
+
+    if (errors == 0) begin
+      $display("PASSED");
+    end else begin
+      $display("FAILED with %0d errors", errors);
+    end
+    $finish;
+  end
+
+  axi_lite_write_buffer #(
+    .AXI_ADDR_BW_p ( 32     ),
+    .DEPTH_p       ( DEPTH  ),
+    .DRAIN_ADDR_p  ( DRAIN  )
+  ) axi_lite_write_buffer_dut_i (
+    .clk              ( tb_clk       ),
+    .rst_n            ( tb_rst_n     ),
+    .i_s_axi_awaddr   ( cpu_awaddr   ),
+    .i_s_axi_awprot   ( 3'b000       ),
+    .i_s_axi_awvalid  ( cpu_awvalid  ),
+    .o_s_axi_awready  ( cpu_awready  ),
+    .i_s_axi_wdata    ( cpu_wdata    ),
+    .i_s_axi_wstrb    ( 4'hF         ),
+    .i_s_axi_wvalid   ( cpu_wvalid   ),
+    .o_s_axi_wready   ( cpu_wready   ),
+    .o_s_axi_bresp    ( cpu_bresp    ),
+    .o_s_axi_bvalid   ( cpu_bvalid   ),
+    .i_s_axi_bready   ( cpu_bready   ),
+    .i_s_axi_araddr   ( cpu_araddr   ),
+    .i_s_axi_arprot   ( 3'b000       ),
+    .i_s_axi_arvalid  ( cpu_arvalid  ),
+    .o_s_axi_arready  ( cpu_arready  ),
+    .o_s_axi_rdata    ( cpu_rdata    ),
+    .o_s_axi_rresp    ( cpu_rresp    ),
+    .o_s_axi_rvalid   ( cpu_rvalid   ),
+    .i_s_axi_rready   ( cpu_rready   ),
+    .o_m_axi_awaddr   ( slv_awaddr   ),
+    .o_m_axi_awprot   (  /* OPEN */  ),
+    .o_m_axi_awvalid  ( slv_awvalid  ),
+    .i_m_axi_awready  ( slv_awready  ),
+    .o_m_axi_wdata    ( slv_wdata    ),
+    .o_m_axi_wstrb    ( slv_wstrb    ),
+    .o_m_axi_wvalid   ( slv_wvalid   ),
+    .i_m_axi_wready   ( slv_wready   ),
+    .i_m_axi_bresp    ( slv_bresp    ),
+    .i_m_axi_bvalid   ( slv_bvalid   ),
+    .o_m_axi_bready   ( slv_bready   ),
+    .o_m_axi_araddr   ( slv_araddr   ),
+    .o_m_axi_arprot   (  /* OPEN */  ),
+    .o_m_axi_arvalid  ( slv_arvalid  ),
+    .i_m_axi_arready  ( slv_arready  ),
+    .i_m_axi_rdata    ( slv_rdata    ),
+    .i_m_axi_rresp    ( slv_rresp    ),
+    .i_m_axi_rvalid   ( slv_rvalid   ),
+    .o_m_axi_rready   ( slv_rready   ),
+    .o_irq            ( dut_irq      )
+  );
+
+endmodule : axi_lite_write_buffer_tb_top
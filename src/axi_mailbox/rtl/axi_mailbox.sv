@@ -0,0 +1,257 @@
+// AXI4-Lite inter-core mailbox and spinlock peripheral
+//
+// Register map (byte offsets):
+//   0x000  CORE_ID       RO  Index of the master issuing the read
+//   0x004  CORE_NBR      RO  Number of cores in the system
+//   0x008  CORE_CTRL     RW  Bit n releases core n from reset (core 0 always runs)
+//   0x00C  MBOX_IRQ_EN   RW  Bit n raises o_irq[n] while mailbox n is not empty
+//   0x020 + 8*n  MBOX_DATA[n]    W: push a word into mailbox n (dropped with SLVERR when full)
+//                                R: pop a word from mailbox n (0 when empty)
+//   0x024 + 8*n  MBOX_STATUS[n]  RO [0] not empty, [1] full, [15:8] number of words
+//   0x100 + 4*i  LOCK[i]         R: try to take lock i. Returns 0 when the lock was free and is
+//                                   now held by the reader, otherwise owner index + 1.
+//                                W: release lock i
+//
+// Mailbox n is the inbox of core n. The registers only decode address bits [8:0], bits [11:9]
+// carry the index of the master that issued the access. The SoC top overwrites them with the
+// crossbar port of every master, cores first, so up to MASTER_NBR_p = 8 masters are told apart
+// and none of them can pose as another. Masters after the cores (the debug bridge) read their
+// own index from CORE_ID and can take locks, but have no inbox.
+module axi_mailbox #(
+  parameter int unsigned AXI_ADDR_BW_p   = 12,
+  parameter int unsigned CORE_NBR_p      = 2,
+  parameter int unsigned MASTER_NBR_p    = CORE_NBR_p,
+  parameter int unsigned MBOX_DEPTH_p    = 4,
+  parameter int unsigned LOCK_NBR_p      = 16
+)(
+  input  logic                     clk,
+  input  logic                     rst_n,
+  input  logic [AXI_ADDR_BW_p-1:0] i_axi_awaddr,
+  input  logic                     i_axi_awvalid,
+  input  logic [31:0]              i_axi_wdata,
+  input  logic                     i_axi_wvalid,
+  input  logic                     i_axi_bready,
+  input  logic [AXI_ADDR_BW_p-1:0] i_axi_araddr,
+  input  logic                     i_axi_arvalid,
+  input  logic                     i_axi_rready,
+  output logic                     o_axi_awready,
+  output logic                     o_axi_wready,
+  output logic [1:0]               o_axi_bresp,
+  output logic                     o_axi_bvalid,
+  output logic                     o_axi_arready,
+  output logic [31:0]              o_axi_rdata,
+  output logic [1:0]               o_axi_rresp,
+  output logic                     o_axi_rvalid,
+  output logic [CORE_NBR_p-1:0]    o_core_release,
+  output logic [CORE_NBR_p-1:0]    o_irq
+);
+
+  localparam logic [1:0] RESP_OKAY   = 2'b00;
+  localparam logic [1:0] RESP_SLVERR = 2'b10;
+
+  localparam int unsigned PTR_BW_p   = (MBOX_DEPTH_p > 1) ? $clog2(MBOX_DEPTH_p) : 1;
+  localparam int unsigned CNT_BW_p   = $clog2(MBOX_DEPTH_p + 1);
+  localparam int unsigned OWNER_BW_p = $clog2(MASTER_NBR_p + 1);
+
+  localparam logic [11:0] ADDR_CORE_ID     = 12'h000;
+  localparam logic [11:0] ADDR_CORE_NBR    = 12'h004;
+  localparam logic [11:0] ADDR_CORE_CTRL   = 12'h008;
+  localparam logic [11:0] ADDR_MBOX_IRQ_EN = 12'h00C;
+  localparam logic [11:0] ADDR_MBOX_BASE   = 12'h020;
+  localparam logic [11:0] ADDR_LOCK_BASE   = 12'h100;
+
+  // Registers
+  logic [CORE_NBR_p-1:0] core_release;
+  logic [CORE_NBR_p-1:0] mbox_irq_en;
+  logic [31:0]           mbox_mem [CORE_NBR_p][MBOX_DEPTH_p];
+  logic [PTR_BW_p-1:0]   mbox_wr_ptr [CORE_NBR_p];
+  logic [PTR_BW_p-1:0]   mbox_rd_ptr [CORE_NBR_p];
+  logic [CNT_BW_p-1:0]   mbox_count [CORE_NBR_p];
+  logic [OWNER_BW_p-1:0] lock_owner [LOCK_NBR_p];  // 0 = free, otherwise master index + 1
+
+  logic [CORE_NBR_p-1:0] s_mbox_empty;
+  logic [CORE_NBR_p-1:0] s_mbox_full;
+
+  always_comb begin
+    for (int n = 0; n < CORE_NBR_p; n++) begin
+      s_mbox_empty[n] = (mbox_count[n] == '0);
+      s_mbox_full[n]  = (mbox_count[n] == CNT_BW_p'(MBOX_DEPTH_p));
+    end
+  end
+
+  assign o_core_release = core_release | CORE_NBR_p'(1);
+  assign o_irq          = mbox_irq_en & ~s_mbox_empty;
+
+  // --------------------------------------------------------------------------
+  // Address decode
+  // --------------------------------------------------------------------------
+  logic [11:0] s_waddr;
+  logic [11:0] s_raddr;
+  logic [2:0]  s_rid;
+
+  assign s_waddr = 12'(i_axi_awaddr) & 12'h1FC;
+  assign s_raddr = 12'(i_axi_araddr) & 12'h1FC;
+  assign s_rid   = 3'(i_axi_araddr >> 9);
+
+  // Write and read requests are accepted when both AW and W are present and the previous
+  // response has been taken, so every register access completes in a single cycle.
+  logic s_wr_en;
+  logic s_rd_en;
+
+  assign s_wr_en       = i_axi_awvalid & i_axi_wvalid & (~o_axi_bvalid | i_axi_bready);
+  assign s_rd_en       = i_axi_arvalid & (~o_axi_rvalid | i_axi_rready);
+  assign o_axi_awready = s_wr_en;
+  assign o_axi_wready  = s_wr_en;
+  assign o_axi_arready = s_rd_en;
+
+  // Decoded accesses
+  logic [CORE_NBR_p-1:0] s_mbox_push;
+  logic [CORE_NBR_p-1:0] s_mbox_pop;
+  logic [LOCK_NBR_p-1:0] s_lock_release;
+  logic [LOCK_NBR_p-1:0] s_lock_try;
+  logic                  s_wr_error;
+  logic [31:0]           s_rdata;
+
+  always_comb begin
+    s_mbox_push    = '0;
+    s_wr_error     = 1'b0;
+    s_lock_release = '0;
+    for (int n = 0; n < CORE_NBR_p; n++) begin
+      if (s_wr_en && s_waddr == ADDR_MBOX_BASE + 12'(8*n)) begin
+        s_mbox_push[n] = ~s_mbox_full[n];
+        s_wr_error     = s_mbox_full[n];
+      end
+    end
+    for (int i = 0; i < LOCK_NBR_p; i++) begin
+      s_lock_release[i] = s_wr_en && s_waddr == ADDR_LOCK_BASE + 12'(4*i);
+    end
+  end
+
+  always_comb begin
+    s_rdata    = '0;
+    s_mbox_pop = '0;
+    s_lock_try = '0;
+    if (s_raddr == ADDR_CORE_ID) begin
+      s_rdata = 32'(s_rid);
+    end else if (s_raddr == ADDR_CORE_NBR) begin
+      s_rdata = 32'(CORE_NBR_p);
+    end else if (s_raddr == ADDR_CORE_CTRL) begin
+      s_rdata = 32'(o_core_release);
+    end else if (s_raddr == ADDR_MBOX_IRQ_EN) begin
+      s_rdata = 32'(mbox_irq_en);
+    end
+    for (int n = 0; n < CORE_NBR_p; n++) begin
+      if (s_raddr == ADDR_MBOX_BASE + 12'(8*n)) begin
+        s_rdata       = s_mbox_empty[n] ? '0 : mbox_mem[n][mbox_rd_ptr[n]];
+        s_mbox_pop[n] = s_rd_en & ~s_mbox_empty[n];
+      end else if (s_raddr == ADDR_MBOX_BASE + 12'(8*n + 4)) begin
+        s_rdata = {16'b0, 8'(mbox_count[n]), 6'b0, s_mbox_full[n], ~s_mbox_empty[n]};
+      end
+    end
+    for (int i = 0; i < LOCK_NBR_p; i++) begin
+      if (s_raddr == ADDR_LOCK_BASE + 12'(4*i)) begin
+        s_rdata       = 32'(lock_owner[i]);
+        s_lock_try[i] = s_rd_en;
+      end
+    end
+  end
+
+  // --------------------------------------------------------------------------
+  // Control registers
+  // --------------------------------------------------------------------------
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      core_release <= '0;
+      mbox_irq_en  <= '0;
+    end else if (s_wr_en) begin
+      if (s_waddr == ADDR_CORE_CTRL) begin
+        core_release <= i_axi_wdata[CORE_NBR_p-1:0];
+      end
+      if (s_waddr == ADDR_MBOX_IRQ_EN) begin
+        mbox_irq_en <= i_axi_wdata[CORE_NBR_p-1:0];
+      end
+    end
+  end
+
+  // --------------------------------------------------------------------------
+  // Mailbox FIFOs
+  // --------------------------------------------------------------------------
+  always_ff @(posedge clk) begin
+    for (int n = 0; n < CORE_NBR_p; n++) begin
+      if (s_mbox_push[n]) begin
+        mbox_mem[n][mbox_wr_ptr[n]] <= i_axi_wdata;
+      end
+    end
+  end
+
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      for (int n = 0; n < CORE_NBR_p; n++) begin
+        mbox_wr_ptr[n] <= '0;
+        mbox_rd_ptr[n] <= '0;
+        mbox_count[n]  <= '0;
+      end
+    end else begin
+      for (int n = 0; n < CORE_NBR_p; n++) begin
+        if (s_mbox_push[n]) begin
+          mbox_wr_ptr[n] <= (mbox_wr_ptr[n] == PTR_BW_p'(MBOX_DEPTH_p - 1)) ? '0 : mbox_wr_ptr[n] + 1'b1;
+        end
+        if (s_mbox_pop[n]) begin
+          mbox_rd_ptr[n] <= (mbox_rd_ptr[n] == PTR_BW_p'(MBOX_DEPTH_p - 1)) ? '0 : mbox_rd_ptr[n] + 1'b1;
+        end
+        if (s_mbox_push[n] && !s_mbox_pop[n]) begin
+          mbox_count[n] <= mbox_count[n] + 1'b1;
+        end else if (!s_mbox_push[n] && s_mbox_pop[n]) begin
+          mbox_count[n] <= mbox_count[n] - 1'b1;
+        end
+      end
+    end
+  end
+
+  // --------------------------------------------------------------------------
+  // Spinlocks: a read of a free lock takes it atomically, a write frees it
+  // --------------------------------------------------------------------------
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      for (int i = 0; i < LOCK_NBR_p; i++) begin
+        lock_owner[i] <= '0;
+      end
+    end else begin
+      for (int i = 0; i < LOCK_NBR_p; i++) begin
+        if (s_lock_release[i]) begin
+          lock_owner[i] <= '0;
+        end else if (s_lock_try[i] && lock_owner[i] == '0) begin
+          lock_owner[i] <= OWNER_BW_p'(s_rid) + 1'b1;
+        end
+      end
+    end
+  end
+
+  // --------------------------------------------------------------------------
+  // Responses
+  // --------------------------------------------------------------------------
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      o_axi_bvalid <= 1'b0;
+      o_axi_bresp  <= RESP_OKAY;
+      o_axi_rvalid <= 1'b0;
+      o_axi_rresp  <= RESP_OKAY;
+      o_axi_rdata  <= '0;
+    end else begin
+      if (s_wr_en) begin
+        o_axi_bvalid <= 1'b1;
+        o_axi_bresp  <= s_wr_error ? RESP_SLVERR : RESP_OKAY;
+      end else if (i_axi_bready) begin
+        o_axi_bvalid <= 1'b0;
+      end
+
+      if (s_rd_en) begin
+        o_axi_rvalid <= 1'b1;
+        o_axi_rdata  <= s_rdata;
+      end else if (i_axi_rready) begin
+        o_axi_rvalid <= 1'b0;
+      end
+    end
+  end
+
+endmodule : axi_mailbox
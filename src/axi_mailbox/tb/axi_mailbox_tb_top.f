@@ -0,0 +1,2 @@
+$AXI_MAILBOX_PROJ_ROOT/rtl/axi_mailbox.sv
+$AXI_MAILBOX_PROJ_ROOT/tb/axi_mailbox_tb_top.sv
@@ -0,0 +1,207 @@
+module axi_mailbox_tb_top ();
+
+  timeunit 1ns;
+  timeprecision 1ps;
+
+  localparam int unsigned MBOX_DEPTH = 4;
+
+  localparam logic [11:0] CORE_ID     = 12'h000;
+  localparam logic [11:0] CORE_NBR    = 12'h004;
+  localparam logic [11:0] CORE_CTRL   = 12'h008;
+  localparam logic [11:0] MBOX_IRQ_EN = 12'h00C;
+  localparam logic [11:0] MBOX0_DATA  = 12'h020;
+  localparam logic [11:0] MBOX0_STAT  = 12'h024;
+  localparam logic [11:0] MBOX1_DATA  = 12'h028;
+  localparam logic [11:0] MBOX1_STAT  = 12'h02C;
+  localparam logic [11:0] LOCK0       = 12'h100;
+  localparam logic [11:0] LOCK3       = 12'h10C;
+
+  logic        tb_clk;
+  logic        tb_rst_n;
+  logic [11:0] tb_axi_awaddr;
+  logic        tb_axi_awvalid;
+  logic [31:0] tb_axi_wdata;
+  logic        tb_axi_wvalid;
+  logic        tb_axi_bready;
+  logic [11:0] tb_axi_araddr;
+  logic        tb_axi_arvalid;
+  logic        tb_axi_rready;
+  logic        dut_axi_awready;
+  logic        dut_axi_wready;
+  logic [1:0]  dut_axi_bresp;
+  logic        dut_axi_bvalid;
+  logic        dut_axi_arready;
+  logic [31:0] dut_axi_rdata;
+  logic [1:0]  dut_axi_rresp;
+  logic        dut_axi_rvalid;
+  logic [1:0]  dut_core_release;
+  logic [1:0]  dut_irq;
+
+  int errors = 0;
+
+  // Generate clock
+  initial begin
+    tb_clk <= 1'b0;
+    forever #5ns tb_clk <= ~tb_clk;
+  end
+
+  // AXI4-Lite write from the given master, its index goes into address bits [11:9] like the SoC
+  // top inserts it. Returns BRESP
+  task automatic axi_write(input int core, input logic [11:0] addr, input logic [31:0] data,
+                           output logic [1:0] resp);
+    @(posedge tb_clk);
+    tb_axi_awaddr  <= {3'(core), addr[8:0]};
+    tb_axi_awvalid <= 1'b1;
+    tb_axi_wdata   <= data;
+    tb_axi_wvalid  <= 1'b1;
+    tb_axi_bready  <= 1'b1;
+    do @(posedge tb_clk); while (!dut_axi_awready);
+    tb_axi_awvalid <= 1'b0;
+    tb_axi_wvalid  <= 1'b0;
+    while (!dut_axi_bvalid) @(posedge tb_clk);
+    resp = dut_axi_bresp;
+    @(posedge tb_clk);
+    tb_axi_bready  <= 1'b0;
+  endtask
+
+  // AXI4-Lite read from the given master
+  task automatic axi_read(input int core, input logic [11:0] addr, output logic [31:0] data);
+    @(posedge tb_clk);
+    tb_axi_araddr  <= {3'(core), addr[8:0]};
+    tb_axi_arvalid <= 1'b1;
+    tb_axi_rready  <= 1'b1;
+    do @(posedge tb_clk); while (!dut_axi_arready);
+    tb_axi_arvalid <= 1'b0;
+    while (!dut_axi_rvalid) @(posedge tb_clk);
+    data = dut_axi_rdata;
+    @(posedge tb_clk);
+    tb_axi_rready  <= 1'b0;
+  endtask
+
+  task automatic check_read(input string name, input int core, input logic [11:0] addr,
+                            input logic [31:0] expected);
+    logic [31:0] data;
+    axi_read(core, addr, data);
+    if (data !== expected) begin
+      $error("%s: core %0d read %03h got %08h, expected %08h", name, core, addr, data, expected);
+      errors++;
+    end
+  endtask
+
+  task automatic check_write(input string name, input int core, input logic [11:0] addr,
+                             input logic [31:0] data, input logic [1:0] expected);
+    logic [1:0] resp;
+    axi_write(core, addr, data, resp);
+    if (resp !== expected) begin
+      $error("%s: core %0d write %03h got BRESP %0b, expected %0b", name, core, addr, resp,
+             expected);
+      errors++;
+    end
+  endtask
+
+  initial begin
+    tb_rst_n       <= 1'b0;
+    tb_axi_awaddr  <= '0;
+    tb_axi_awvalid <= 1'b0;
+    tb_axi_wdata   <= '0;
+    tb_axi_wvalid  <= 1'b0;
+    tb_axi_bready  <= 1'b0;
+    tb_axi_araddr  <= '0;
+    tb_axi_arvalid <= 1'b0;
+    tb_axi_rready  <= 1'b0;
+    repeat (5) @(posedge tb_clk);
+    tb_rst_n <= 1'b1;
+
+    // Identification and core release
+    check_read("core id 0", 0, CORE_ID, 32'd0);
+    check_read("core id 1", 1, CORE_ID, 32'd1);
+    check_read("master id 2", 2, CORE_ID, 32'd2);
+    check_read("core nbr",  0, CORE_NBR, 32'd2);
+    if (dut_core_release !== 2'b01) begin
+      $error("Core 1 released out of reset");
+      errors++;
+    end
+    check_write("release", 0, CORE_CTRL, 32'h2, 2'b00);
+    if (dut_core_release !== 2'b11) begin
+      $error("Core 1 not released, core_release = %02b", dut_core_release);
+      errors++;
+    end
+
+    // Mailbox FIFO order, full and empty behaviour
+    for (int i = 0; i < MBOX_DEPTH; i++) begin
+      check_write("push", 0, MBOX1_DATA, 32'hA000_0000 + i, 2'b00);
+    end
+    check_read("status full", 1, MBOX1_STAT, {16'b0, 8'(MBOX_DEPTH), 8'b0000_0011});
+    check_write("push full", 0, MBOX1_DATA, 32'hDEAD_BEEF, 2'b10);
+    for (int i = 0; i < MBOX_DEPTH; i++) begin
+      check_read("pop", 1, MBOX1_DATA, 32'hA000_0000 + i);
+    end
+    check_read("status empty", 1, MBOX1_STAT, 32'h0);
+    check_read("pop empty", 1, MBOX1_DATA, 32'h0);
+
+    // Interrupt while the inbox of core 0 holds data
+    check_write("irq enable", 0, MBOX_IRQ_EN, 32'h1, 2'b00);
+    if (dut_irq !== 2'b00) begin
+      $error("IRQ raised with empty mailbox");
+      errors++;
+    end
+    check_write("push 0", 1, MBOX0_DATA, 32'h1234_5678, 2'b00);
+    if (dut_irq !== 2'b01) begin
+      $error("IRQ not raised, irq = %02b", dut_irq);
+      errors++;
+    end
+    check_read("pop 0", 0, MBOX0_DATA, 32'h1234_5678);
+    if (dut_irq !== 2'b00) begin
+      $error("IRQ not cleared after pop");
+      errors++;
+    end
+
+    // Spinlocks
+    check_read("lock take",  0, LOCK0, 32'd0);
+    check_read("lock busy",  1, LOCK0, 32'd1);
+    check_read("lock other", 1, LOCK3, 32'd0);
+    check_read("lock owner", 0, LOCK3, 32'd2);
+    check_write("lock free", 0, LOCK0, 32'd0, 2'b00);
+    check_read("lock retake", 1, LOCK0, 32'd0);
+    check_read("lock master", 2, LOCK0, 32'd2);
+    check_write("lock free 3", 2, LOCK3, 32'd0, 2'b00);
+    check_read("lock master 3", 2, LOCK3, 32'd0);
+    check_read("lock owner 3", 0, LOCK3, 32'd3);
+
+    if (errors == 0) begin
+      $display("PASSED");
+    end else begin
+      $display("FAILED with %0d errors", errors);
+    end
+    $finish;
+  end
+
+  axi_mailbox #(
+    .AXI_ADDR_BW_p ( 12          ),
+    .CORE_NBR_p    ( 2           ),
+    .MASTER_NBR_p  ( 3           ),
+    .MBOX_DEPTH_p  ( MBOX_DEPTH  )
+  ) axi_mailbox_dut_i (
+    .clk            ( tb_clk            ),
+    .rst_n          ( tb_rst_n          ),
+    .i_axi_awaddr   ( tb_axi_awaddr     ),
+    .i_axi_awvalid  ( tb_axi_awvalid    ),
+    .i_axi_wdata    ( tb_axi_wdata      ),
+    .i_axi_wvalid   ( tb_axi_wvalid     ),
+    .i_axi_bready   ( tb_axi_bready     ),
+    .i_axi_araddr   ( tb_axi_araddr     ),
+    .i_axi_arvalid  ( tb_axi_arvalid    ),
+    .i_axi_rready   ( tb_axi_rready     ),
+    .o_axi_awready  ( dut_axi_awready   ),
+    .o_axi_wready   ( dut_axi_wready    ),
+    .o_axi_bresp    ( dut_axi_bresp     ),
+    .o_axi_bvalid   ( dut_axi_bvalid    ),
+    .o_axi_arready  ( dut_axi_arready   ),
+    .o_axi_rdata    ( dut_axi_rdata     ),
+    .o_axi_rresp    ( dut_axi_rresp     ),
+    .o_axi_rvalid   ( dut_axi_rvalid    ),
+    .o_core_release ( dut_core_release  ),
+    .o_irq          ( dut_irq           )
+  );
+
+endmodule : axi_mailbox_tb_top
@@ -0,0 +1,425 @@
+// AXI4-Lite execute-in-place (XIP) controller for quad SPI NOR flash
+//
+// Maps the flash read-only into the AXI address space: a read of offset A returns the 32-bit
+// little-endian word at flash address A. Writes are answered with SLVERR. Reads are served
+// from a direct-mapped cache of LINE_NBR_p 16-byte lines, a miss fetches the whole line with a
+// Quad I/O Fast Read (0xEB, 1-4-4). The mode byte MODE_BYTE_p keeps the flash in continuous
+// read mode, so after the first miss the 0xEB command is skipped and a line fill takes
+// 6 address + 2 mode + DUMMY_CYCLES_p + 32 data SPI clocks.
+//
+// Initialization after reset:
+//   - 8 clocks with CS# high (STARTUPE2 drops the first USRCCLKO edges after configuration)
+//   - Mode bit reset: 8 clocks of all ones, leaves continuous read mode after a soft reset
+//   - QUAD_SETUP_p = 1: read SR1/CR1 and, if CR1.QUAD is clear, set it with WREN + WRR and
+//     poll WIP. CR1 is non-volatile and WRR rewrites SR1 as well, so this is off by default:
+//     the flash must then already have CR1.QUAD set (a flash that configures the FPGA in x4
+//     mode has it)
+//
+// Register reads and writes follow the Spansion/Cypress S25FL-S command set used on the
+// Nexys Video (S25FL256S). The SPI clock is clk / (2 * CLK_DIV_p); flash data is registered
+// once before sampling at the end of the high phase, which leaves (2 * CLK_DIV_p - 1) clk
+// periods for the round trip through the pads.
+module axi_qspi_xip #(
+  parameter int unsigned AXI_ADDR_BW_p   = 24,
+  parameter int unsigned CLK_DIV_p       = 2,
+  parameter int unsigned DUMMY_CYCLES_p  = 4,
+  parameter logic [7:0]  MODE_BYTE_p     = 8'hA0,
+  parameter int unsigned LINE_NBR_p      = 16,
+  parameter bit          QUAD_SETUP_p    = 0
+)(
+  input  logic                     clk,
+  input  logic                     rst_n,
+  input  logic [AXI_ADDR_BW_p-1:0] i_axi_awaddr,
+  input  logic                     i_axi_awvalid,
+  input  logic [31:0]              i_axi_wdata,
+  input  logic                     i_axi_wvalid,
+  input  logic                     i_axi_bready,
+  input  logic [AXI_ADDR_BW_p-1:0] i_axi_araddr,
+  input  logic                     i_axi_arvalid,
+  input  logic                     i_axi_rready,
+  output logic                     o_axi_awready,
+  output logic                     o_axi_wready,
+  output logic [1:0]               o_axi_bresp,
+  output logic                     o_axi_bvalid,
+  output logic                     o_axi_arready,
+  output logic [31:0]              o_axi_rdata,
+  output logic [1:0]               o_axi_rresp,
+  output logic                     o_axi_rvalid,
+  // Quad SPI flash
+  output logic                     o_qspi_sck,
+  output logic                     o_qspi_cs_n,
+  output logic [3:0]               o_qspi_dq,
+  output logic [3:0]               o_qspi_dq_oe,
+  input  logic [3:0]               i_qspi_dq
+);
+
+  localparam logic [1:0] RESP_OKAY   = 2'b00;
+  localparam logic [1:0] RESP_SLVERR = 2'b10;
+
+  // Flash commands
+  localparam logic [7:0] CMD_WRR   = 8'h01;
+  localparam logic [7:0] CMD_RDSR1 = 8'h05;
+  localparam logic [7:0] CMD_WREN  = 8'h06;
+  localparam logic [7:0] CMD_RDCR  = 8'h35;
+  localparam logic [7:0] CMD_QIOR  = 8'hEB;
+
+  localparam int unsigned FLASH_ADDR_BW_p = 24;
+  localparam int unsigned LINE_BYTES_p    = 16;
+  localparam int unsigned LINE_BW_p       = 8 * LINE_BYTES_p;
+  localparam int unsigned INDEX_BW_p      = (LINE_NBR_p > 1) ? $clog2(LINE_NBR_p) : 1;
+  localparam int unsigned TAG_BW_p        = FLASH_ADDR_BW_p - 4 - INDEX_BW_p;
+  localparam int unsigned DIV_BW_p        = (CLK_DIV_p > 1) ? $clog2(CLK_DIV_p) : 1;
+  localparam int unsigned GAP_TICKS_p     = 4;  // CS# high time between commands, half periods
+
+  // --------------------------------------------------------------------------
+  // SPI engine
+  // --------------------------------------------------------------------------
+  // A transfer runs up to five phases in this order, each for a given number of SPI clocks:
+  // single-line output on DQ0, quad output, dummy clocks, single-line input on DQ1, quad input.
+  // Output data is taken MSB first from a 40-bit shift register (command, address, mode).
+  typedef enum logic [2:0] {
+    PH_SOUT  = 3'd0,
+    PH_QOUT  = 3'd1,
+    PH_DUMMY = 3'd2,
+    PH_SIN   = 3'd3,
+    PH_QIN   = 3'd4,
+    PH_GAP   = 3'd5,
+    PH_IDLE  = 3'd6
+  } phase_t;
+
+  typedef struct packed {
+    logic [5:0]  sout;    // Clocks per phase
+    logic [3:0]  qout;
+    logic [3:0]  dummy;
+    logic [3:0]  sin;
+    logic [5:0]  qin;
+    logic        no_cs;   // Keep CS# high (startup clocks)
+    logic [39:0] data;    // Output data, MSB first
+  } xfer_t;
+
+  function automatic logic [6:0] phase_clks(input phase_t ph, input xfer_t x);
+    unique case (ph)
+      PH_SOUT:  return 7'(x.sout);
+      PH_QOUT:  return 7'(x.qout);
+      PH_DUMMY: return 7'(x.dummy);
+      PH_SIN:   return 7'(x.sin);
+      PH_QIN:   return 7'(x.qin);
+      default:  return 7'(GAP_TICKS_p);
+    endcase
+  endfunction
+
+  // First phase at or after 'first' with a non-zero clock count
+  function automatic phase_t phase_from(input int first, input xfer_t x);
+    for (int i = first; i <= int'(PH_QIN); i++) begin
+      if (phase_clks(phase_t'(i), x) != '0) begin
+        return phase_t'(i);
+      end
+    end
+    return PH_GAP;
+  endfunction
+
+  xfer_t                s_xfer;        // Transfer requested by the sequencer
+  logic                 s_xfer_start;
+  xfer_t                xfer;          // Transfer in progress
+  phase_t               phase;
+  phase_t               s_phase_next;
+  logic [6:0]           clk_cnt;
+  logic [DIV_BW_p-1:0]  div_cnt;
+  logic                 s_tick;
+  logic [39:0]          sreg_out;
+  logic [LINE_BW_p-1:0] sreg_in;
+  logic [3:0]           dq_in_q;
+
+  assign s_tick       = (div_cnt == DIV_BW_p'(CLK_DIV_p - 1));
+  assign s_phase_next = phase_from(int'(phase) + 1, xfer);
+
+  always_ff @(posedge clk) begin
+    dq_in_q <= i_qspi_dq;
+  end
+
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      phase       <= PH_IDLE;
+      xfer        <= '0;
+      clk_cnt     <= '0;
+      div_cnt     <= '0;
+      o_qspi_sck  <= 1'b0;
+      o_qspi_cs_n <= 1'b1;
+      sreg_out    <= '0;
+    end else begin
+      div_cnt <= s_tick ? '0 : div_cnt + 1'b1;
+
+      unique case (phase)
+        PH_IDLE: begin
+          div_cnt <= '0;
+          if (s_xfer_start) begin
+            xfer        <= s_xfer;
+            sreg_out    <= s_xfer.data;
+            o_qspi_cs_n <= s_xfer.no_cs;
+            phase       <= phase_from(int'(PH_SOUT), s_xfer);
+            clk_cnt     <= phase_clks(phase_from(int'(PH_SOUT), s_xfer), s_xfer);
+          end
+        end
+
+        PH_GAP: begin
+          o_qspi_cs_n <= 1'b1;
+          if (s_tick) begin
+            clk_cnt <= clk_cnt - 1'b1;
+            if (clk_cnt == 7'd1) begin
+              phase <= PH_IDLE;
+            end
+          end
+        end
+
+        default: begin
+          if (s_tick) begin
+            o_qspi_sck <= ~o_qspi_sck;
+            // Falling edge: sample input, shift output, count the clock
+            if (o_qspi_sck) begin
+              if (phase == PH_SIN) begin
+                sreg_in <= {sreg_in[LINE_BW_p-2:0], dq_in_q[1]};
+              end
+              if (phase == PH_QIN) begin
+                sreg_in <= {sreg_in[LINE_BW_p-5:0], dq_in_q};
+              end
+              if (phase == PH_SOUT) begin
+                sreg_out <= {sreg_out[38:0], 1'b0};
+              end
+              if (phase == PH_QOUT) begin
+                sreg_out <= {sreg_out[35:0], 4'b0};
+              end
+              if (clk_cnt == 7'd1) begin
+                phase   <= s_phase_next;
+                clk_cnt <= phase_clks(s_phase_next, xfer);
+              end else begin
+                clk_cnt <= clk_cnt - 1'b1;
+              end
+            end
+          end
+        end
+      endcase
+    end
+  end
+
+  // DQ2/DQ3 are WP#/HOLD# until CR1.QUAD is set, keep them high in single-line phases
+  always_comb begin
+    unique case (phase)
+      PH_SOUT: begin
+        o_qspi_dq    = {2'b11, 1'b0, sreg_out[39]};
+        o_qspi_dq_oe = 4'b1101;
+      end
+      PH_QOUT: begin
+        o_qspi_dq    = sreg_out[39:36];
+        o_qspi_dq_oe = 4'b1111;
+      end
+      PH_SIN: begin
+        o_qspi_dq    = 4'b1100;
+        o_qspi_dq_oe = 4'b1101;
+      end
+      default: begin
+        o_qspi_dq    = 4'b0000;
+        o_qspi_dq_oe = 4'b0000;
+      end
+    endcase
+  end
+
+  // --------------------------------------------------------------------------
+  // Line cache
+  // --------------------------------------------------------------------------
+  logic [LINE_BW_p-1:0] line_data  [LINE_NBR_p];
+  logic [TAG_BW_p-1:0]  line_tag   [LINE_NBR_p];
+  logic [LINE_NBR_p-1:0] line_valid;
+
+  logic [FLASH_ADDR_BW_p-1:0] rd_addr;
+  logic [INDEX_BW_p-1:0]      s_index;
+  logic [TAG_BW_p-1:0]        s_tag;
+  logic                       s_hit;
+  logic [LINE_BW_p-1:0]       s_fill_line;
+
+  assign s_index = (LINE_NBR_p > 1) ? rd_addr[4 +: INDEX_BW_p] : '0;
+  assign s_tag   = rd_addr[FLASH_ADDR_BW_p-1 -: TAG_BW_p];
+  assign s_hit   = line_valid[s_index] && line_tag[s_index] == s_tag;
+
+  // The first byte received ends up in the top byte of the shift register
+  always_comb begin
+    for (int b = 0; b < LINE_BYTES_p; b++) begin
+      s_fill_line[8*b +: 8] = sreg_in[LINE_BW_p-1-8*b -: 8];
+    end
+  end
+
+  // --------------------------------------------------------------------------
+  // Sequencer
+  // --------------------------------------------------------------------------
+  typedef enum logic [3:0] {
+    SQ_STARTUP,
+    SQ_MBR,
+    SQ_RDSR,
+    SQ_RDCR,
+    SQ_WREN,
+    SQ_WRR,
+    SQ_POLL,
+    SQ_READY,
+    SQ_LOOKUP,
+    SQ_FILL
+  } seq_t;
+
+  seq_t       sq_state;
+  logic       sq_issued;    // Transfer of the current state has been started
+  logic       cont_mode;    // Flash is in continuous read mode
+  logic [7:0] sr1;
+  logic [7:0] cr1;
+  logic       s_xfer_done;
+
+  assign s_xfer_done = sq_issued && phase == PH_IDLE;
+
+  always_comb begin
+    s_xfer      = '0;
+    unique case (sq_state)
+      SQ_STARTUP: begin
+        s_xfer.dummy = 4'd8;
+        s_xfer.no_cs = 1'b1;
+      end
+      SQ_MBR: begin
+        s_xfer.qout = 4'd8;
+        s_xfer.data = '1;
+      end
+      SQ_RDSR, SQ_POLL: begin
+        s_xfer.sout = 6'd8;
+        s_xfer.sin  = 4'd8;
+        s_xfer.data = {CMD_RDSR1, 32'b0};
+      end
+      SQ_RDCR: begin
+        s_xfer.sout = 6'd8;
+        s_xfer.sin  = 4'd8;
+        s_xfer.data = {CMD_RDCR, 32'b0};
+      end
+      SQ_WREN: begin
+        s_xfer.sout = 6'd8;
+        s_xfer.data = {CMD_WREN, 32'b0};
+      end
+      SQ_WRR: begin
+        s_xfer.sout = 6'd24;
+        s_xfer.data = {CMD_WRR, sr1, cr1 | 8'h02, 16'b0};
+      end
+      SQ_FILL: begin
+        s_xfer.sout  = cont_mode ? 6'd0 : 6'd8;
+        s_xfer.qout  = 4'd8;
+        s_xfer.dummy = 4'(DUMMY_CYCLES_p);
+        s_xfer.qin   = 6'(2 * LINE_BYTES_p);
+        s_xfer.data  = cont_mode ? {rd_addr[23:4], 4'b0, MODE_BYTE_p, 8'b0}
+                                 : {CMD_QIOR, rd_addr[23:4], 4'b0, MODE_BYTE_p};
+      end
+      default: ;
+    endcase
+  end
+
+  assign s_xfer_start = !sq_issued && phase == PH_IDLE &&
+                        sq_state != SQ_READY && sq_state != SQ_LOOKUP;
+
+  // AXI read channel: one outstanding read, accepted once initialization is done
+  logic s_rd_en;
+  assign o_axi_arready = sq_state == SQ_READY && !o_axi_rvalid;
+  assign s_rd_en       = i_axi_arvalid & o_axi_arready;
+  assign o_axi_rresp   = RESP_OKAY;
+
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      sq_state     <= SQ_STARTUP;
+      sq_issued    <= 1'b0;
+      cont_mode    <= 1'b0;
+      sr1          <= '0;
+      cr1          <= '0;
+      rd_addr      <= '0;
+      line_valid   <= '0;
+      o_axi_rvalid <= 1'b0;
+      o_axi_rdata  <= '0;
+    end else begin
+      if (s_xfer_start) begin
+        sq_issued <= 1'b1;
+      end
+      if (s_xfer_done) begin
+        sq_issued <= 1'b0;
+      end
+      if (o_axi_rvalid && i_axi_rready) begin
+        o_axi_rvalid <= 1'b0;
+      end
+
+      unique case (sq_state)
+        SQ_STARTUP: if (s_xfer_done) sq_state <= SQ_MBR;
+        SQ_MBR:     if (s_xfer_done) sq_state <= QUAD_SETUP_p ? SQ_RDSR : SQ_READY;
+        SQ_RDSR: begin
+          if (s_xfer_done) begin
+            sr1      <= sreg_in[7:0];
+            sq_state <= SQ_RDCR;
+          end
+        end
+        SQ_RDCR: begin
+          if (s_xfer_done) begin
+            cr1      <= sreg_in[7:0];
+            sq_state <= sreg_in[1] ? SQ_READY : SQ_WREN;
+          end
+        end
+        SQ_WREN:    if (s_xfer_done) sq_state <= SQ_WRR;
+        SQ_WRR:     if (s_xfer_done) sq_state <= SQ_POLL;
+        SQ_POLL: begin
+          // Wait for the non-volatile write to finish (SR1.WIP)
+          if (s_xfer_done && !sreg_in[0]) begin
+            sq_state <= SQ_READY;
+          end
+        end
+        SQ_READY: begin
+          if (s_rd_en) begin
+            rd_addr  <= FLASH_ADDR_BW_p'(i_axi_araddr);
+            sq_state <= SQ_LOOKUP;
+          end
+        end
+        SQ_LOOKUP: begin
+          if (s_hit) begin
+            o_axi_rdata  <= line_data[s_index][32*rd_addr[3:2] +: 32];
+            o_axi_rvalid <= 1'b1;
+            sq_state     <= SQ_READY;
+          end else begin
+            sq_state     <= SQ_FILL;
+          end
+        end
+        SQ_FILL: begin
+          if (s_xfer_done) begin
+            line_valid[s_index] <= 1'b1;
+            cont_mode           <= MODE_BYTE_p[7:4] == 4'hA;
+            o_axi_rdata         <= s_fill_line[32*rd_addr[3:2] +: 32];
+            o_axi_rvalid        <= 1'b1;
+            sq_state            <= SQ_READY;
+          end
+        end
+        default: sq_state <= SQ_STARTUP;
+      endcase
+    end
+  end
+
+  always_ff @(posedge clk) begin
+    if (sq_state == SQ_FILL && s_xfer_done) begin
+      line_data[s_index] <= s_fill_line;
+      line_tag[s_index]  <= s_tag;
+    end
+  end
+
+  // --------------------------------------------------------------------------
+  // AXI write channel: the flash is read-only
+  // --------------------------------------------------------------------------
+  logic s_wr_en;
+  assign s_wr_en       = i_axi_awvalid & i_axi_wvalid & (~o_axi_bvalid | i_axi_bready);
+  assign o_axi_awready = s_wr_en;
+  assign o_axi_wready  = s_wr_en;
+  assign o_axi_bresp   = RESP_SLVERR;
+
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      o_axi_bvalid <= 1'b0;
+    end else if (s_wr_en) begin
+      o_axi_bvalid <= 1'b1;
+    end else if (i_axi_bready) begin
+      o_axi_bvalid <= 1'b0;
+    end
+  end
+
+endmodule : axi_qspi_xip
@@ -0,0 +1,3 @@
+$AXI_QSPI_XIP_PROJ_ROOT/rtl/axi_qspi_xip.sv
+$AXI_QSPI_XIP_PROJ_ROOT/../../tb/src/qspi_flash_model.sv
+$AXI_QSPI_XIP_PROJ_ROOT/tb/axi_qspi_xip_tb_top.sv
@@ -0,0 +1,217 @@
+module axi_qspi_xip_tb_top ();
+
+  timeunit 1ns;
+  timeprecision 1ps;
+
+  localparam int unsigned LINE_NBR = 4;
+
+  logic        tb_clk;
+  logic        tb_rst_n;
+  logic [23:0] tb_axi_awaddr;
+  logic        tb_axi_awvalid;
+  logic [31:0] tb_axi_wdata;
+  logic        tb_axi_wvalid;
+  logic        tb_axi_bready;
+  logic [23:0] tb_axi_araddr;
+  logic        tb_axi_arvalid;
+  logic        tb_axi_rready;
+  logic        dut_axi_awready;
+  logic        dut_axi_wready;
+  logic [1:0]  dut_axi_bresp;
+  logic        dut_axi_bvalid;
+  logic        dut_axi_arready;
+  logic [31:0] dut_axi_rdata;
+  logic [1:0]  dut_axi_rresp;
+  logic        dut_axi_rvalid;
+  logic        dut_qspi_sck;
+  logic        dut_qspi_cs_n;
+  logic [3:0]  dut_qspi_dq;
+  logic [3:0]  dut_qspi_dq_oe;
+  wire  [3:0]  qspi_dq;
+
+  int errors = 0;
+
+  // Generate clock
+  initial begin
+    tb_clk <= 1'b0;
+    forever #5ns tb_clk <= ~tb_clk;
+  end
+
+  for (genvar i = 0; i < 4; i++) begin : gen_dq
+    assign qspi_dq[i] = dut_qspi_dq_oe[i] ? dut_qspi_dq[i] : 1'bz;
+    pullup (qspi_dq[i]);
+  end
+
+  // Flash contents: byte at address a is a[7:0] ^ a[15:8] ^ a[23:16]
+  function automatic logic [7:0] flash_byte(input logic [23:0] addr);
+    return addr[7:0] ^ addr[15:8] ^ addr[23:16];
+  endfunction
+
+  function automatic logic [31:0] flash_word(input logic [23:0] addr);
+    return {flash_byte(addr + 3), flash_byte(addr + 2), flash_byte(addr + 1), flash_byte(addr)};
+  endfunction
+
+  // AXI4-Lite write, returns BRESP
+  task automatic axi_write(input logic [23:0] addr, input logic [31:0] data,
+                           output logic [1:0] resp);
+    @(posedge tb_clk);
+    tb_axi_awaddr  <= addr;
+    tb_axi_awvalid <= 1'b1;
+    tb_axi_wdata   <= data;
+    tb_axi_wvalid  <= 1'b1;
+    tb_axi_bready  <= 1'b1;
+    do @(posedge tb_clk); while (!dut_axi_awready);
+    tb_axi_awvalid <= 1'b0;
+    tb_axi_wvalid  <= 1'b0;
+    while (!dut_axi_bvalid) @(posedge tb_clk);
+    resp = dut_axi_bresp;
+    @(posedge tb_clk);
+    tb_axi_bready  <= 1'b0;
+  endtask
+
+  // AXI4-Lite read, returns the data and the latency in clock cycles
+  task automatic axi_read(input logic [23:0] addr, output logic [31:0] data, output int cycles);
+    @(posedge tb_clk);
+    tb_axi_araddr  <= addr;
+    tb_axi_arvalid <= 1'b1;
+    tb_axi_rready  <= 1'b1;
+    cycles = 0;
+    do begin
+      @(posedge tb_clk);
+      cycles++;
+    end while (!dut_axi_arready);
+    tb_axi_arvalid <= 1'b0;
+    while (!dut_axi_rvalid) begin
+      @(posedge tb_clk);
+      cycles++;
+    end
+    data = dut_axi_rdata;
+    @(posedge tb_clk);
+    tb_axi_rready  <= 1'b0;
+  endtask
+
+  // Read and compare, a hit must take only a few cycles, a miss a line fill
+  task automatic check_read(input string name, input logic [23:0] addr, input bit hit);
+    logic [31:0] data;
+    int          cycles;
+    axi_read(addr, data, cycles);
+    if (data !== flash_word(addr)) begin
+      $error("%s: read %06h got %08h, expected %08h", name, addr, data, flash_word(addr));
+      errors++;
+    end
+    if (hit && cycles > 4) begin
+      $error("%s: read %06h took %0d cycles, expected a cache hit", name, addr, cycles);
+      errors++;
+    end
+    if (!hit && cycles < 40) begin
+      $error("%s: read %06h took %0d cycles, expected a line fill", name, addr, cycles);
+      errors++;
+    end
+  endtask
+
+  initial begin
+    logic [1:0]  resp;
+    logic [31:0] data;
+    int          cycles;
+
+    for (int a = 0; a < 'h400; a++) begin
+      qspi_flash_model_inst.mem[24'h01_0000 + a] = flash_byte(24'h01_0000 + a);
+      qspi_flash_model_inst.mem[24'hC0_0000 + a] = flash_byte(24'hC0_0000 + a);
+    end
+
+    tb_rst_n       <= 1'b0;
+    tb_axi_awaddr  <= '0;
+    tb_axi_awvalid <= 1'b0;
+    tb_axi_wdata   <= '0;
+    tb_axi_wvalid  <= 1'b0;
+    tb_axi_bready  <= 1'b0;
+    tb_axi_araddr  <= '0;
+    tb_axi_arvalid <= 1'b0;
+    tb_axi_rready  <= 1'b0;
+    repeat (5) @(posedge tb_clk);
+    tb_rst_n <= 1'b1;
+
+    // The first read waits for initialization (QUAD bit set by WRR) and fills a line
+    axi_read(24'h01_0000, data, cycles);
+    if (data !== flash_word(24'h01_0000)) begin
+      $error("first read got %08h, expected %08h", data, flash_word(24'h01_0000));
+      errors++;
+    end
+    if (!qspi_flash_model_inst.cr1[1]) begin
+      $error("CR1.QUAD not set during initialization");
+      errors++;
+    end
+
+    // Same line hits, next line misses (continuous read mode from now on)
+    check_read("hit word 1",  24'h01_0004, 1);
+    check_read("hit word 3",  24'h01_000C, 1);
+    check_read("miss line 1", 24'h01_0010, 0);
+    check_read("hit line 1",  24'h01_0018, 1);
+
+    // Same index, different tag evicts the line
+    check_read("conflict",    24'hC0_0000, 0);
+    check_read("evicted",     24'h01_0000, 0);
+
+    // Sweep more lines than the cache holds
+    for (int a = 0; a < 'h100; a += 4) begin
+      check_read("sweep", 24'hC0_0100 + a, (a % 16) != 0);
+    end
+
+    // Writes are rejected
+    axi_write(24'h01_0000, 32'hDEAD_BEEF, resp);
+    if (resp !== 2'b10) begin
+      $error("write got BRESP %0b, expected SLVERR", resp);
+      errors++;
+    end
+    check_read("after write", 24'h01_0000, 0);
+
+    if (errors == 0) begin
+      $display("PASSED");
+    end else begin
+      $display("FAILED with %0d errors", errors);
+    end
+    $finish;
+  end
+
+  axi_qspi_xip #(
+    .AXI_ADDR_BW_p  ( 24        ),
+    .CLK_DIV_p      ( 2         ),
+    .DUMMY_CYCLES_p ( 4         ),
+    .LINE_NBR_p     ( LINE_NBR  ),
+    .QUAD_SETUP_p   ( 1         )
+  ) axi_qspi_xip_dut_i (
+    .clk            ( tb_clk            ),
+    .rst_n          ( tb_rst_n          ),
+    .i_axi_awaddr   ( tb_axi_awaddr     ),
+    .i_axi_awvalid  ( tb_axi_awvalid    ),
+    .i_axi_wdata    ( tb_axi_wdata      ),
+    .i_axi_wvalid   ( tb_axi_wvalid     ),
+    .i_axi_bready   ( tb_axi_bready     ),
+    .i_axi_araddr   ( tb_axi_araddr     ),
+    .i_axi_arvalid  ( tb_axi_arvalid    ),
+    .i_axi_rready   ( tb_axi_rready     ),
+    .o_axi_awready  ( dut_axi_awready   ),
+    .o_axi_wready   ( dut_axi_wready    ),
+    .o_axi_bresp    ( dut_axi_bresp     ),
+    .o_axi_bvalid   ( dut_axi_bvalid    ),
+    .o_axi_arready  ( dut_axi_arready   ),
+    .o_axi_rdata    ( dut_axi_rdata     ),
+    .o_axi_rresp    ( dut_axi_rresp     ),
+    .o_axi_rvalid   ( dut_axi_rvalid    ),
+    .o_qspi_sck     ( dut_qspi_sck      ),
+    .o_qspi_cs_n    ( dut_qspi_cs_n     ),
+    .o_qspi_dq      ( dut_qspi_dq       ),
+    .o_qspi_dq_oe   ( dut_qspi_dq_oe    ),
+    .i_qspi_dq      ( qspi_dq           )
+  );
+
+  qspi_flash_model #(
+    .DUMMY_CYCLES_p ( 4 ),
+    .WRR_BUSY_NS_p  ( 500 )
+  ) qspi_flash_model_inst (
+    .sck  ( dut_qspi_sck  ),
+    .cs_n ( dut_qspi_cs_n ),
+    .dq   ( qspi_dq       )
+  );
+
+endmodule : axi_qspi_xip_tb_top
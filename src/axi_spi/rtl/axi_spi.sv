@@ -0,0 +1,467 @@
+// AXI4-Lite SPI master with TX/RX FIFOs, chip-select control, threshold interrupts and DMA requests
+//
+// Register map (byte offsets):
+//   0x00  CTRL        RW  [0] CPOL, [1] CPHA, [2] LSB first, [4:3] frame size (8, 16, 24 or 32
+//                         bits), [5] RX disable (received frames are dropped, for write-only traffic)
+//   0x04  CLK_DIV     RW  SCK = clk / (2 * (CLK_DIV + 1)), 0 gives clk / 2
+//   0x08  CS          RW  [CS_NBR_p-1:0] selected slaves, [8] AUTO. Without AUTO the selected
+//                         CS_N pins are driven low directly. With AUTO they are only low while
+//                         frames are being shifted, from half an SCK period before the first
+//                         edge to half a period after the last one.
+//   0x0C  STATUS      RO  [0] busy, [1] TX empty, [2] TX full, [3] RX empty, [4] RX full,
+//                         [15:8] TX FIFO level, [23:16] RX FIFO level
+//   0x10  THRESH      RW  [7:0] TX threshold, [15:8] RX threshold
+//   0x14  IRQ_EN      RW  Enables for the IRQ_STATUS bits
+//   0x18  IRQ_STATUS  RW  [0] TX level <= TX threshold, [1] RX level > RX threshold (both live),
+//                         [2] done, [3] RX overflow, [4] TX overflow (sticky, write 1 to clear).
+//                         o_irq is high while an enabled bit is set.
+//   0x1C  FIFO_CLEAR  W   [0] flush the TX FIFO, [1] flush the RX FIFO
+//   0x20  TX_DATA     W   Push one frame, right aligned. Dropped (TX overflow) when full.
+//   0x24  RX_DATA     R   Pop one frame, right aligned. Reads 0 when empty.
+//   0x28  DMA_CTRL    RW  [0] drive o_dma_tx_req, [1] drive o_dma_rx_req
+//
+// Every word in the TX FIFO is one frame. Frames follow each other without gaps while the TX
+// FIFO has data, so the SCK rate is the bus rate. MISO is taken into an IOB flop and used one
+// clock after the sampling edge, which leaves the slave a full clock period of output delay at
+// clk / 2. Change CTRL and CLK_DIV only while STATUS.busy is clear.
+//
+// The DMA requests follow the threshold conditions: o_dma_tx_req while the TX FIFO level is at
+// or below the TX threshold, o_dma_rx_req while the RX FIFO level is above the RX threshold. A
+// DMA engine answers a request by moving words through TX_DATA/RX_DATA, like the CPU does.
+module axi_spi #(
+  parameter int unsigned AXI_ADDR_BW_p = 12,
+  parameter int unsigned FIFO_DEPTH_p  = 16,  // Power of two
+  parameter int unsigned CS_NBR_p      = 1
+)(
+  input  logic                     clk,
+  input  logic                     rst_n,
+  input  logic [AXI_ADDR_BW_p-1:0] i_axi_awaddr,
+  input  logic                     i_axi_awvalid,
+  input  logic [31:0]              i_axi_wdata,
+  input  logic                     i_axi_wvalid,
+  input  logic                     i_axi_bready,
+  input  logic [AXI_ADDR_BW_p-1:0] i_axi_araddr,
+  input  logic                     i_axi_arvalid,
+  input  logic                     i_axi_rready,
+  output logic                     o_axi_awready,
+  output logic                     o_axi_wready,
+  output logic [1:0]               o_axi_bresp,
+  output logic                     o_axi_bvalid,
+  output logic                     o_axi_arready,
+  output logic [31:0]              o_axi_rdata,
+  output logic [1:0]               o_axi_rresp,
+  output logic                     o_axi_rvalid,
+  output logic                     o_spi_sck,
+  output logic                     o_spi_mosi,
+  input  logic                     i_spi_miso,
+  output logic [CS_NBR_p-1:0]      o_spi_cs_n,
+  output logic                     o_irq,
+  output logic                     o_dma_tx_req,
+  output logic                     o_dma_rx_req
+);
+
+  localparam logic [1:0] RESP_OKAY = 2'b00;
+
+  localparam int unsigned PTR_BW_p = (FIFO_DEPTH_p > 1) ? $clog2(FIFO_DEPTH_p) : 1;
+  localparam int unsigned LVL_BW_p = $clog2(FIFO_DEPTH_p + 1);
+
+  localparam logic [7:0] ADDR_CTRL       = 8'h00;
+  localparam logic [7:0] ADDR_CLK_DIV    = 8'h04;
+  localparam logic [7:0] ADDR_CS         = 8'h08;
+  localparam logic [7:0] ADDR_STATUS     = 8'h0C;
+  localparam logic [7:0] ADDR_THRESH     = 8'h10;
+  localparam logic [7:0] ADDR_IRQ_EN     = 8'h14;
+  localparam logic [7:0] ADDR_IRQ_STATUS = 8'h18;
+  localparam logic [7:0] ADDR_FIFO_CLEAR = 8'h1C;
+  localparam logic [7:0] ADDR_TX_DATA    = 8'h20;
+  localparam logic [7:0] ADDR_RX_DATA    = 8'h24;
+  localparam logic [7:0] ADDR_DMA_CTRL   = 8'h28;
+
+  // Registers
+  logic                cpol;
+  logic                cpha;
+  logic                lsb_first;
+  logic [1:0]          frame_size;
+  logic                rx_disable;
+  logic [15:0]         clk_div;
+  logic [CS_NBR_p-1:0] cs_sel;
+  logic                cs_auto;
+  logic [7:0]          tx_thresh;
+  logic [7:0]          rx_thresh;
+  logic [4:0]          irq_en;
+  logic                irq_done;
+  logic                irq_rx_overflow;
+  logic                irq_tx_overflow;
+  logic                dma_tx_en;
+  logic                dma_rx_en;
+
+  // --------------------------------------------------------------------------
+  // Address decode
+  // --------------------------------------------------------------------------
+  logic [7:0] s_waddr;
+  logic [7:0] s_raddr;
+
+  assign s_waddr = 8'(i_axi_awaddr) & 8'hFC;
+  assign s_raddr = 8'(i_axi_araddr) & 8'hFC;
+
+  // Write and read requests are accepted when both AW and W are present and the previous
+  // response has been taken, so every register access completes in a single cycle.
+  logic s_wr_en;
+  logic s_rd_en;
+
+  assign s_wr_en       = i_axi_awvalid & i_axi_wvalid & (~o_axi_bvalid | i_axi_bready);
+  assign s_rd_en       = i_axi_arvalid & (~o_axi_rvalid | i_axi_rready);
+  assign o_axi_awready = s_wr_en;
+  assign o_axi_wready  = s_wr_en;
+  assign o_axi_arready = s_rd_en;
+
+  // --------------------------------------------------------------------------
+  // FIFOs
+  // --------------------------------------------------------------------------
+  logic [31:0]         tx_fifo [FIFO_DEPTH_p];
+  logic [PTR_BW_p-1:0] tx_wr_ptr;
+  logic [PTR_BW_p-1:0] tx_rd_ptr;
+  logic [LVL_BW_p-1:0] tx_level;
+  logic [31:0]         rx_fifo [FIFO_DEPTH_p];
+  logic [PTR_BW_p-1:0] rx_wr_ptr;
+  logic [PTR_BW_p-1:0] rx_rd_ptr;
+  logic [LVL_BW_p-1:0] rx_level;
+
+  logic        s_tx_empty;
+  logic        s_tx_full;
+  logic        s_rx_empty;
+  logic        s_rx_full;
+  logic        s_tx_push;
+  logic        s_tx_pop;
+  logic        s_tx_clear;
+  logic        s_rx_push;
+  logic        s_rx_pop;
+  logic        s_rx_clear;
+  logic [31:0] s_rx_word;
+
+  assign s_tx_empty = (tx_level == '0);
+  assign s_tx_full  = (tx_level == LVL_BW_p'(FIFO_DEPTH_p));
+  assign s_rx_empty = (rx_level == '0);
+  assign s_rx_full  = (rx_level == LVL_BW_p'(FIFO_DEPTH_p));
+
+  assign s_tx_push  = s_wr_en && s_waddr == ADDR_TX_DATA && !s_tx_full;
+  assign s_tx_clear = s_wr_en && s_waddr == ADDR_FIFO_CLEAR && i_axi_wdata[0];
+  assign s_rx_pop   = s_rd_en && s_raddr == ADDR_RX_DATA && !s_rx_empty;
+  assign s_rx_clear = s_wr_en && s_waddr == ADDR_FIFO_CLEAR && i_axi_wdata[1];
+
+  always_ff @(posedge clk) begin
+    if (s_tx_push) begin
+      tx_fifo[tx_wr_ptr] <= i_axi_wdata;
+    end
+    if (s_rx_push && !s_rx_full) begin
+      rx_fifo[rx_wr_ptr] <= s_rx_word;
+    end
+  end
+
+  always_ff @(posedge clk) begin
+    if (!rst_n || s_tx_clear) begin
+      tx_wr_ptr <= '0;
+      tx_rd_ptr <= '0;
+      tx_level  <= '0;
+    end else begin
+      if (s_tx_push) begin
+        tx_wr_ptr <= tx_wr_ptr + 1'b1;
+      end
+      if (s_tx_pop) begin
+        tx_rd_ptr <= tx_rd_ptr + 1'b1;
+      end
+      tx_level <= tx_level + LVL_BW_p'(s_tx_push) - LVL_BW_p'(s_tx_pop);
+    end
+  end
+
+  always_ff @(posedge clk) begin
+    if (!rst_n || s_rx_clear) begin
+      rx_wr_ptr <= '0;
+      rx_rd_ptr <= '0;
+      rx_level  <= '0;
+    end else begin
+      if (s_rx_push && !s_rx_full) begin
+        rx_wr_ptr <= rx_wr_ptr + 1'b1;
+      end
+      if (s_rx_pop) begin
+        rx_rd_ptr <= rx_rd_ptr + 1'b1;
+      end
+      rx_level <= rx_level + LVL_BW_p'(s_rx_push && !s_rx_full) - LVL_BW_p'(s_rx_pop);
+    end
+  end
+
+  // --------------------------------------------------------------------------
+  // Shift engine
+  // --------------------------------------------------------------------------
+  typedef enum logic [1:0] {
+    ST_IDLE,
+    ST_XFER,
+    ST_HOLD
+  } state_t;
+
+  state_t      state;
+  logic [15:0] div_cnt;
+  logic [4:0]  bit_cnt;
+  logic [31:0] tx_sh;
+  logic        s_tick;
+  logic        s_start;
+  logic        s_last_bit;
+  logic        s_leading;
+  logic [5:0]  s_bits;
+  logic [31:0] s_tx_aligned;
+  logic [31:0] s_tx_shifted;
+  logic        s_sample;
+  logic        s_active_nxt;
+
+  assign s_bits     = {1'b0, frame_size, 3'b111} + 6'd1;  // 8 * (frame_size + 1)
+  assign s_tick     = (div_cnt == clk_div);
+  assign s_start    = (state == ST_IDLE) && !s_tx_empty;
+  assign s_leading  = (o_spi_sck == cpol);
+  assign s_last_bit = (bit_cnt == 5'(s_bits - 6'd1));
+  assign s_tx_pop   = s_start || (state == ST_XFER && s_tick && !s_leading && s_last_bit &&
+                                  !s_tx_empty);
+
+  // The bit on MOSI is tx_sh[31] (MSB first, frames left aligned) or tx_sh[0] (LSB first)
+  assign s_tx_aligned = lsb_first ? tx_fifo[tx_rd_ptr] : tx_fifo[tx_rd_ptr] << (6'd32 - s_bits);
+  assign s_tx_shifted = lsb_first ? tx_sh >> 1 : tx_sh << 1;
+
+  // MISO is sampled on the leading edge with CPHA = 0 and on the trailing edge with CPHA = 1
+  assign s_sample = (state == ST_XFER) && s_tick && (s_leading != cpha);
+
+  // Chip selects are updated together with the first MOSI bit and released after the hold
+  assign s_active_nxt = s_start || (state == ST_XFER) || (state == ST_HOLD && !s_tick);
+
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      state      <= ST_IDLE;
+      div_cnt    <= '0;
+      bit_cnt    <= '0;
+      tx_sh      <= '0;
+      o_spi_sck  <= 1'b0;
+      o_spi_mosi <= 1'b0;
+    end else begin
+      div_cnt <= (state == ST_IDLE || s_tick) ? '0 : div_cnt + 1'b1;
+
+      unique case (state)
+        ST_IDLE: begin
+          o_spi_sck <= cpol;
+          bit_cnt   <= '0;
+          if (s_start) begin
+            state      <= ST_XFER;
+            tx_sh      <= s_tx_aligned;
+            o_spi_mosi <= lsb_first ? s_tx_aligned[0] : s_tx_aligned[31];
+          end
+        end
+
+        ST_XFER: begin
+          if (s_tick) begin
+            o_spi_sck <= ~o_spi_sck;
+            if (s_leading) begin
+              // CPHA = 1 puts the bit out on the leading edge
+              if (cpha) begin
+                o_spi_mosi <= lsb_first ? tx_sh[0] : tx_sh[31];
+                tx_sh      <= s_tx_shifted;
+              end
+            end else if (s_last_bit) begin
+              // Next frame back to back, its first bit goes out like any other bit would
+              bit_cnt <= '0;
+              if (!s_tx_empty) begin
+                tx_sh <= s_tx_aligned;
+                if (!cpha) begin
+                  o_spi_mosi <= lsb_first ? s_tx_aligned[0] : s_tx_aligned[31];
+                end
+              end else begin
+                state <= ST_HOLD;
+              end
+            end else begin
+              // CPHA = 0 puts the next bit out on the trailing edge
+              bit_cnt <= bit_cnt + 1'b1;
+              if (!cpha) begin
+                o_spi_mosi <= lsb_first ? s_tx_shifted[0] : s_tx_shifted[31];
+                tx_sh      <= s_tx_shifted;
+              end
+            end
+          end
+        end
+
+        ST_HOLD: begin
+          if (s_tick) begin
+            state <= ST_IDLE;
+          end
+        end
+
+        default: state <= ST_IDLE;
+      endcase
+    end
+  end
+
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      o_spi_cs_n <= '1;
+    end else begin
+      o_spi_cs_n <= ~(cs_auto ? (cs_sel & {CS_NBR_p{s_active_nxt}}) : cs_sel);
+    end
+  end
+
+  // --------------------------------------------------------------------------
+  // Receive path, MISO is used one clock after the sampling edge has left the pin
+  // --------------------------------------------------------------------------
+  (* IOB = "TRUE" *) logic miso_q;
+  logic [1:0]  sample_q;
+  logic [4:0]  rx_cnt;
+  logic [31:0] rx_sh;
+  logic [31:0] s_rx_next;
+
+  assign s_rx_next = lsb_first ? {miso_q, rx_sh[31:1]} : {rx_sh[30:0], miso_q};
+  assign s_rx_word = lsb_first ? s_rx_next >> (6'd32 - s_bits) :
+                                 s_rx_next & ({32{1'b1}} >> (6'd32 - s_bits));
+  assign s_rx_push = sample_q[1] && (rx_cnt == 5'(s_bits - 6'd1)) && !rx_disable;
+
+  always_ff @(posedge clk) begin
+    miso_q <= i_spi_miso;
+  end
+
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      sample_q <= '0;
+      rx_cnt   <= '0;
+      rx_sh    <= '0;
+    end else begin
+      sample_q <= {sample_q[0], s_sample};
+      if (sample_q[1]) begin
+        rx_sh  <= s_rx_next;
+        rx_cnt <= (rx_cnt == 5'(s_bits - 6'd1)) ? '0 : rx_cnt + 1'b1;
+      end
+    end
+  end
+
+  // --------------------------------------------------------------------------
+  // Control registers and interrupts
+  // --------------------------------------------------------------------------
+  logic       s_busy;
+  logic       busy_q;
+  logic       s_tx_low;
+  logic       s_rx_high;
+  logic [4:0] s_irq_status;
+
+  assign s_busy       = (state != ST_IDLE) || !s_tx_empty || (sample_q != '0);
+  assign s_tx_low     = (8'(tx_level) <= tx_thresh);
+  assign s_rx_high    = (8'(rx_level) > rx_thresh);
+  assign s_irq_status = {irq_tx_overflow, irq_rx_overflow, irq_done, s_rx_high, s_tx_low};
+  assign o_irq        = |(s_irq_status & irq_en);
+  assign o_dma_tx_req = dma_tx_en & s_tx_low;
+  assign o_dma_rx_req = dma_rx_en & s_rx_high;
+
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      cpol            <= 1'b0;
+      cpha            <= 1'b0;
+      lsb_first       <= 1'b0;
+      frame_size      <= '0;
+      rx_disable      <= 1'b0;
+      clk_div         <= '0;
+      cs_sel          <= '0;
+      cs_auto         <= 1'b0;
+      tx_thresh       <= '0;
+      rx_thresh       <= '0;
+      irq_en          <= '0;
+      irq_done        <= 1'b0;
+      irq_rx_overflow <= 1'b0;
+      irq_tx_overflow <= 1'b0;
+      dma_tx_en       <= 1'b0;
+      dma_rx_en       <= 1'b0;
+      busy_q          <= 1'b0;
+    end else begin
+      busy_q <= s_busy;
+
+      // New events are set after the clear, so an event arriving with the W1C is not lost
+      if (s_wr_en && s_waddr == ADDR_IRQ_STATUS) begin
+        irq_done        <= irq_done        & ~i_axi_wdata[2];
+        irq_rx_overflow <= irq_rx_overflow & ~i_axi_wdata[3];
+        irq_tx_overflow <= irq_tx_overflow & ~i_axi_wdata[4];
+      end
+      if (busy_q && !s_busy) begin
+        irq_done <= 1'b1;
+      end
+      if (s_rx_push && s_rx_full) begin
+        irq_rx_overflow <= 1'b1;
+      end
+      if (s_wr_en && s_waddr == ADDR_TX_DATA && s_tx_full) begin
+        irq_tx_overflow <= 1'b1;
+      end
+
+      if (s_wr_en) begin
+        unique case (s_waddr)
+          ADDR_CTRL: begin
+            cpol       <= i_axi_wdata[0];
+            cpha       <= i_axi_wdata[1];
+            lsb_first  <= i_axi_wdata[2];
+            frame_size <= i_axi_wdata[4:3];
+            rx_disable <= i_axi_wdata[5];
+          end
+          ADDR_CLK_DIV: clk_div <= i_axi_wdata[15:0];
+          ADDR_CS: begin
+            cs_sel  <= i_axi_wdata[CS_NBR_p-1:0];
+            cs_auto <= i_axi_wdata[8];
+          end
+          ADDR_THRESH: begin
+            tx_thresh <= i_axi_wdata[7:0];
+            rx_thresh <= i_axi_wdata[15:8];
+          end
+          ADDR_IRQ_EN: irq_en <= i_axi_wdata[4:0];
+          ADDR_DMA_CTRL: begin
+            dma_tx_en <= i_axi_wdata[0];
+            dma_rx_en <= i_axi_wdata[1];
+          end
+          default: ;
+        endcase
+      end
+    end
+  end
+
+  // --------------------------------------------------------------------------
+  // Responses
+  // --------------------------------------------------------------------------
+  logic [31:0] s_rdata;
+
+  always_comb begin
+    unique case (s_raddr)
+      ADDR_CTRL:       s_rdata = 32'({rx_disable, frame_size, lsb_first, cpha, cpol});
+      ADDR_CLK_DIV:    s_rdata = 32'(clk_div);
+      ADDR_CS:         s_rdata = {23'd0, cs_auto, 8'(cs_sel)};
+      ADDR_STATUS:     s_rdata = {8'd0, 8'(rx_level), 8'(tx_level), 3'd0,
+                                  s_rx_full, s_rx_empty, s_tx_full, s_tx_empty, s_busy};
+      ADDR_THRESH:     s_rdata = {16'd0, rx_thresh, tx_thresh};
+      ADDR_IRQ_EN:     s_rdata = 32'(irq_en);
+      ADDR_IRQ_STATUS: s_rdata = 32'(s_irq_status);
+      ADDR_RX_DATA:    s_rdata = s_rx_empty ? '0 : rx_fifo[rx_rd_ptr];
+      ADDR_DMA_CTRL:   s_rdata = {30'd0, dma_rx_en, dma_tx_en};
+      default:         s_rdata = '0;
+    endcase
+  end
+
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      o_axi_bvalid <= 1'b0;
+      o_axi_rvalid <= 1'b0;
+      o_axi_rdata  <= '0;
+    end else begin
+      if (s_wr_en) begin
+        o_axi_bvalid <= 1'b1;
+      end else if (i_axi_bready) begin
+        o_axi_bvalid <= 1'b0;
+      end
+
+      if (s_rd_en) begin
+        o_axi_rvalid <= 1'b1;
+        o_axi_rdata  <= s_rdata;
+      end else if (i_axi_rready) begin
+        o_axi_rvalid <= 1'b0;
+      end
+    end
+  end
+
+  assign o_axi_bresp = RESP_OKAY;
+  assign o_axi_rresp = RESP_OKAY;
+
+endmodule : axi_spi
@@ -0,0 +1,3 @@
+$AXI_SPI_PROJ_ROOT/rtl/axi_spi.sv
+$AXI_SPI_PROJ_ROOT/../../tb/src/spi_loopback_model.sv
+$AXI_SPI_PROJ_ROOT/tb/axi_spi_tb_top.sv
@@ -0,0 +1,382 @@
+module axi_spi_tb_top ();
+
+  timeunit 1ns;
+  timeprecision 1ps;
+
+  localparam int unsigned DEPTH  = 16;
+  localparam int unsigned CS_NBR = 4;   // One loopback slave per SPI mode
+
+  localparam logic [11:0] CTRL       = 12'h00;
+  localparam logic [11:0] CLK_DIV    = 12'h04;
+  localparam logic [11:0] CS         = 12'h08;
+  localparam logic [11:0] STATUS     = 12'h0C;
+  localparam logic [11:0] THRESH     = 12'h10;
+  localparam logic [11:0] IRQ_EN     = 12'h14;
+  localparam logic [11:0] IRQ_STATUS = 12'h18;
+  localparam logic [11:0] FIFO_CLEAR = 12'h1C;
+  localparam logic [11:0] TX_DATA    = 12'h20;
+  localparam logic [11:0] RX_DATA    = 12'h24;
+  localparam logic [11:0] DMA_CTRL   = 12'h28;
+
+  localparam logic [31:0] CS_AUTO    = 32'h0000_0100;
+
+  logic              tb_clk;
+  logic              tb_rst_n;
+  logic [11:0]       tb_axi_awaddr;
+  logic              tb_axi_awvalid;
+  logic [31:0]       tb_axi_wdata;
+  logic              tb_axi_wvalid;
+  logic              tb_axi_bready;
+  logic [11:0]       tb_axi_araddr;
+  logic              tb_axi_arvalid;
+  logic              tb_axi_rready;
+  logic              dut_axi_awready;
+  logic              dut_axi_wready;
+  logic [1:0]        dut_axi_bresp;
+  logic              dut_axi_bvalid;
+  logic              dut_axi_arready;
+  logic [31:0]       dut_axi_rdata;
+  logic [1:0]        dut_axi_rresp;
+  logic              dut_axi_rvalid;
+  logic              dut_sck;
+  logic              dut_mosi;
+  wire               tb_miso;
+  logic [CS_NBR-1:0] dut_cs_n;
+  logic              dut_irq;
+  logic              dut_dma_tx_req;
+  logic              dut_dma_rx_req;
+
+  // What each loopback slave will answer next, mirrors its shift register
+  logic [7:0] ref_sr [CS_NBR];
+
+  int errors = 0;
+
+  pullup (tb_miso);
+
+  // Generate clock
+  initial begin
+    tb_clk <= 1'b0;
+    forever #5ns tb_clk <= ~tb_clk;
+  end
+
+  task automatic axi_write(input logic [11:0] addr, input logic [31:0] data);
+    @(posedge tb_clk);
+    tb_axi_awaddr  <= addr;
+    tb_axi_awvalid <= 1'b1;
+    tb_axi_wdata   <= data;
+    tb_axi_wvalid  <= 1'b1;
+    tb_axi_bready  <= 1'b1;
+    do @(posedge tb_clk); while (!dut_axi_awready);
+    tb_axi_awvalid <= 1'b0;
+    tb_axi_wvalid  <= 1'b0;
+    while (!dut_axi_bvalid) @(posedge tb_clk);
+    @(posedge tb_clk);
+    tb_axi_bready  <= 1'b0;
+  endtask
+
+  task automatic axi_read(input logic [11:0] addr, output logic [31:0] data);
+    @(posedge tb_clk);
+    tb_axi_araddr  <= addr;
+    tb_axi_arvalid <= 1'b1;
+    tb_axi_rready  <= 1'b1;
+    do @(posedge tb_clk); while (!dut_axi_arready);
+    tb_axi_arvalid <= 1'b0;
+    while (!dut_axi_rvalid) @(posedge tb_clk);
+    data = dut_axi_rdata;
+    @(posedge tb_clk);
+    tb_axi_rready  <= 1'b0;
+  endtask
+
+  task automatic check_reg(input string name, input logic [11:0] addr, input logic [31:0] expected);
+    logic [31:0] data;
+    axi_read(addr, data);
+    if (data !== expected) begin
+      $error("%s: read %03h got %08h, expected %08h", name, addr, data, expected);
+      errors++;
+    end
+  endtask
+
+  task automatic wait_idle();
+    logic [31:0] status;
+    do axi_read(STATUS, status); while (status[0]);
+  endtask
+
+  // Expected answer of slave n to a frame: the bit stream delayed by 8 bits
+  function automatic logic [31:0] loopback(input int n, input logic [31:0] word, input int bits,
+                                           input bit lsb_first);
+    logic [31:0] result = '0;
+    for (int i = 0; i < bits; i++) begin
+      int   pos = lsb_first ? i : bits - 1 - i;
+      logic out = ref_sr[n][7];
+      ref_sr[n]   = {ref_sr[n][6:0], word[pos]};
+      result[pos] = out;
+    end
+    return result;
+  endfunction
+
+  // Send words to slave n with automatic chip select and check what comes back
+  task automatic transfer(input string name, input int n, input logic [31:0] words[$],
+                          input int bits, input bit lsb_first);
+    logic [31:0] data;
+    logic [31:0] mask = (bits == 32) ? '1 : (32'd1 << bits) - 1;
+    axi_write(CS, CS_AUTO | (32'd1 << n));
+    foreach (words[i]) begin
+      axi_write(TX_DATA, words[i]);
+    end
+    wait_idle();
+    foreach (words[i]) begin
+      logic [31:0] expected = loopback(n, words[i] & mask, bits, lsb_first);
+      axi_read(RX_DATA, data);
+      if (data !== expected) begin
+        $error("%s: frame %0d got %08h, expected %08h", name, i, data, expected);
+        errors++;
+      end
+    end
+    check_reg({name, " drained"}, STATUS, 32'h0000_000A);
+    if (dut_cs_n !== '1) begin
+      $error("%s: chip select still asserted", name);
+      errors++;
+    end
+  endtask
+
+  // Check that SCK runs without gaps at clk / 2 while a burst is in flight
+  task automatic check_sck_rate(input int edges);
+    time last;
+    @(posedge dut_sck);
+    last = $time;
+    repeat (edges) begin
+      @(posedge dut_sck);
+      if ($time - last != 20) begin
+        $error("SCK period %0d ns, expected 20 ns", $time - last);
+        errors++;
+      end
+      last = $time;
+    end
+  endtask
+
+  // Chip selects only change while SCK is idle
+  always @(dut_cs_n) begin
+    if (tb_rst_n === 1'b1 && dut_sck !== axi_spi_dut_i.cpol) begin
+      $error("Chip select changed while SCK was active");
+      errors++;
+    end
+  end
+
+  initial begin
+    logic [31:0] words[$];
+    logic [31:0] data;
+
+    tb_rst_n       <= 1'b0;
+    tb_axi_awaddr  <= '0;
+    tb_axi_awvalid <= 1'b0;
+    tb_axi_wdata   <= '0;
+    tb_axi_wvalid  <= 1'b0;
+    tb_axi_bready  <= 1'b0;
+    tb_axi_araddr  <= '0;
+    tb_axi_arvalid <= 1'b0;
+    tb_axi_rready  <= 1'b0;
+    foreach (ref_sr[n]) begin
+      ref_sr[n] = '0;
+    end
+    repeat (5) @(posedge tb_clk);
+    tb_rst_n <= 1'b1;
+
+    check_reg("reset status", STATUS, 32'h0000_000A);
+    check_reg("reset irq status", IRQ_STATUS, 32'h0000_0001);
+
+    // Mode 0, 8 bits, MSB first at clk / 2, back to back frames
+    words = {};
+    for (int i = 0; i < 12; i++) begin
+      words.push_back(32'h3C + 17 * i);
+    end
+    fork
+      transfer("mode 0", 0, words, 8, 0);
+      check_sck_rate(80);
+    join
+    check_reg("done", IRQ_STATUS, 32'h0000_0005);
+    axi_write(IRQ_STATUS, 32'h0000_0004);
+    check_reg("done cleared", IRQ_STATUS, 32'h0000_0001);
+
+    // The other modes at clk / 6
+    axi_write(CLK_DIV, 32'h0000_0002);
+    for (int m = 1; m < 4; m++) begin
+      axi_write(CTRL, m);
+      transfer($sformatf("mode %0d", m), m, '{32'hA5, 32'h0F, 32'hF0, 32'h81}, 8, 0);
+    end
+
+    // Frame sizes and bit order
+    axi_write(CLK_DIV, 32'h0000_0000);
+    axi_write(CTRL, 32'h0000_0018);
+    transfer("32 bit", 0, '{32'hDEAD_BEEF, 32'h0123_4567, 32'h89AB_CDEF}, 32, 0);
+    axi_write(CTRL, 32'h0000_000C);
+    transfer("16 bit LSB first", 0, '{32'h1234, 32'hABCD, 32'h00FF}, 16, 1);
+    axi_write(CTRL, 32'h0000_0010);
+    transfer("24 bit", 0, '{32'hFF12_3456, 32'h00AB_CDEF}, 24, 0);
+    axi_write(CTRL, 32'h0000_0000);
+
+    // Manual chip select
+    axi_write(CS, 32'h0000_0006);
+    repeat (2) @(posedge tb_clk);
+    if (dut_cs_n !== 4'b1001) begin
+      $error("manual chip select %b, expected 1001", dut_cs_n);
+      errors++;
+    end
+    axi_write(CS, 32'h0000_0000);
+
+    // RX threshold interrupt and DMA request
+    axi_write(THRESH, 32'h0000_0200);
+    axi_write(IRQ_EN, 32'h0000_0002);
+    axi_write(DMA_CTRL, 32'h0000_0003);
+    if (dut_irq !== 1'b0 || dut_dma_rx_req !== 1'b0 || dut_dma_tx_req !== 1'b1) begin
+      $error("threshold outputs before the transfer: irq %b rx_req %b tx_req %b", dut_irq,
+             dut_dma_rx_req, dut_dma_tx_req);
+      errors++;
+    end
+    axi_write(CS, CS_AUTO | 32'h1);
+    for (int i = 0; i < 3; i++) begin
+      axi_write(TX_DATA, i);
+    end
+    wait_idle();
+    if (dut_irq !== 1'b1 || dut_dma_rx_req !== 1'b1) begin
+      $error("RX level above the threshold not signalled");
+      errors++;
+    end
+    axi_read(RX_DATA, data);
+    void'(loopback(0, 0, 8, 0));
+    repeat (2) @(posedge tb_clk);
+    if (dut_irq !== 1'b0 || dut_dma_rx_req !== 1'b0) begin
+      $error("RX threshold signalled at the threshold");
+      errors++;
+    end
+    axi_write(FIFO_CLEAR, 32'h0000_0002);
+    void'(loopback(0, 1, 8, 0));
+    void'(loopback(0, 2, 8, 0));
+    check_reg("rx flushed", STATUS, 32'h0000_000A);
+    axi_write(DMA_CTRL, 32'h0000_0000);
+
+    // TX threshold and overflow: a slow clock lets the FIFO fill up
+    axi_write(CLK_DIV, 32'h0000_0040);
+    axi_write(THRESH, 32'h0000_0004);
+    axi_write(IRQ_EN, 32'h0000_0011);
+    for (int i = 0; i < DEPTH + 2; i++) begin
+      axi_write(TX_DATA, 32'h50 + i);
+    end
+    axi_read(IRQ_STATUS, data);
+    if (data[4] !== 1'b1 || data[0] !== 1'b0) begin
+      $error("TX overflow/threshold status %08h", data);
+      errors++;
+    end
+    axi_write(IRQ_STATUS, 32'h0000_0010);
+    axi_write(IRQ_EN, 32'h0000_0001);
+    if (dut_irq !== 1'b0) begin
+      $error("TX threshold IRQ with a full FIFO");
+      errors++;
+    end
+    wait (dut_irq === 1'b1);
+    axi_read(STATUS, data);
+    if (data[15:8] > 4) begin
+      $error("TX threshold IRQ at level %0d", data[15:8]);
+      errors++;
+    end
+
+    // The RX FIFO overflows, the frames that did not fit are lost
+    wait_idle();
+    axi_read(IRQ_STATUS, data);
+    if (data[3] !== 1'b1) begin
+      $error("RX overflow not flagged");
+      errors++;
+    end
+    for (int i = 0; i < DEPTH + 1; i++) begin
+      automatic logic [31:0] expected = loopback(0, 32'h50 + i, 8, 0);
+      if (i < DEPTH) begin
+        axi_read(RX_DATA, data);
+        if (data !== expected) begin
+          $error("overflow: frame %0d got %08h, expected %08h", i, data, expected);
+          errors++;
+        end
+      end
+    end
+    check_reg("rx empty after overflow", STATUS, 32'h0000_000A);
+    axi_write(IRQ_STATUS, 32'h0000_001C);
+    axi_write(IRQ_EN, 32'h0000_0000);
+
+    // RX disabled: nothing is stored
+    axi_write(CLK_DIV, 32'h0000_0000);
+    axi_write(CTRL, 32'h0000_0020);
+    for (int i = 0; i < 3; i++) begin
+      axi_write(TX_DATA, 32'h77);
+      void'(loopback(0, 32'h77, 8, 0));
+    end
+    wait_idle();
+    check_reg("rx disabled", STATUS, 32'h0000_000A);
+    check_reg("no overflow", IRQ_STATUS, 32'h0000_0005);
+
+    if (errors == 0) begin
+      $display("PASSED");
+    end else begin
+      $display("FAILED with %0d errors", errors);
+    end
+    $finish;
+  end
+
+  spi_loopback_model #(.CPOL_p(0), .CPHA_p(0)) spi_slave_mode0_i (
+    .sck  ( dut_sck     ),
+    .cs_n ( dut_cs_n[0] ),
+    .mosi ( dut_mosi    ),
+    .miso ( tb_miso     )
+  );
+
+  spi_loopback_model #(.CPOL_p(0), .CPHA_p(1)) spi_slave_mode1_i (
+    .sck  ( dut_sck     ),
+    .cs_n ( dut_cs_n[1] ),
+    .mosi ( dut_mosi    ),
+    .miso ( tb_miso     )
+  );
+
+  spi_loopback_model #(.CPOL_p(1), .CPHA_p(0)) spi_slave_mode2_i (
+    .sck  ( dut_sck     ),
+    .cs_n ( dut_cs_n[2] ),
+    .mosi ( dut_mosi    ),
+    .miso ( tb_miso     )
+  );
+
+  spi_loopback_model #(.CPOL_p(1), .CPHA_p(1)) spi_slave_mode3_i (
+    .sck  ( dut_sck     ),
+    .cs_n ( dut_cs_n[3] ),
+    .mosi ( dut_mosi    ),
+    .miso ( tb_miso     )
+  );
+
+  axi_spi #(
+    .AXI_ADDR_BW_p ( 12     ),
+    .FIFO_DEPTH_p  ( DEPTH  ),
+    .CS_NBR_p      ( CS_NBR )
+  ) axi_spi_dut_i (
+    .clk            ( tb_clk            ),
+    .rst_n          ( tb_rst_n          ),
+    .i_axi_awaddr   ( tb_axi_awaddr     ),
+    .i_axi_awvalid  ( tb_axi_awvalid    ),
+    .i_axi_wdata    ( tb_axi_wdata      ),
+    .i_axi_wvalid   ( tb_axi_wvalid     ),
+    .i_axi_bready   ( tb_axi_bready     ),
+    .i_axi_araddr   ( tb_axi_araddr     ),
+    .i_axi_arvalid  ( tb_axi_arvalid    ),
+    .i_axi_rready   ( tb_axi_rready     ),
+    .o_axi_awready  ( dut_axi_awready   ),
+    .o_axi_wready   ( dut_axi_wready    ),
+    .o_axi_bresp    ( dut_axi_bresp     ),
+    .o_axi_bvalid   ( dut_axi_bvalid    ),
+    .o_axi_arready  ( dut_axi_arready   ),
+    .o_axi_rdata    ( dut_axi_rdata     ),
+    .o_axi_rresp    ( dut_axi_rresp     ),
+    .o_axi_rvalid   ( dut_axi_rvalid    ),
+    .o_spi_sck      ( dut_sck           ),
+    .o_spi_mosi     ( dut_mosi          ),
+    .i_spi_miso     ( tb_miso           ),
+    .o_spi_cs_n     ( dut_cs_n          ),
+    .o_irq          ( dut_irq           ),
+    .o_dma_tx_req   ( dut_dma_tx_req    ),
+    .o_dma_rx_req   ( dut_dma_rx_req    )
+  );
+
+endmodule : axi_spi_tb_top
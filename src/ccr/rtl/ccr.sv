@@ -1,22 +1,35 @@
+// The MMCM runs its VCO at 600 MHz (100 MHz input * 6). CLKOUT0 is the CPU/memory clock
+// (600 / CPU_CLK_DIVIDE_p), CLKOUT1 the peripheral clock (600 / PERIPH_CLK_DIVIDE_p). Each clock
+// gets its own synchronous reset: the peripheral reset is released first and the CPU reset only
+// after it has been seen in the CPU domain, so the CPU never talks to a peripheral in reset.
+//
+// Reset is released RST_GUARD_CYCLES_p cycles after the MMCM reports lock. LOCKED already means
+// the outputs are stable, so the guard only has to cover the reset synchronizers. The button
+// debouncer powers up in the released state, the debounce time is only paid for real presses.
 module ccr #(
-  parameter int BTN_DEBOUNCE_COUNTER_VALUE_p = 100000, // This corresponds to 100ms on 100 MHz clock
-  parameter int PLL_LOCK_COUNTER_VALUE_p = 100000 // This corresponds to 100ms on 100 MHz clock
+  parameter int BTN_DEBOUNCE_COUNTER_VALUE_p = 100000, // This corresponds to 1ms on 100 MHz clock
+  parameter int RST_GUARD_CYCLES_p = 64,
+  parameter real CPU_CLK_DIVIDE_p = 6.0, // 100 MHz
+  parameter int PERIPH_CLK_DIVIDE_p = 6  // 100 MHz
 )(
   input logic i_clk,
   input logic i_btn_rst_n,
   output logic o_clk,
-  output logic o_rst_n
+  output logic o_rst_n,
+  output logic o_periph_clk,
+  output logic o_periph_rst_n
 );
 
   // Intermediate signals
   logic s_clk;
+  logic s_periph_clk;
   logic s_clk_fb;
   logic s_rst_n;
   logic s_locked;
 
   // Drive outputs
   assign o_clk = s_clk;
-  assign o_rst_n = s_rst_n;
+  assign o_periph_clk = s_periph_clk;
 
   // First we want to sample and debounce the input button
   logic [$clog2(BTN_DEBOUNCE_COUNTER_VALUE_p)-1:0] btn_debounce_counter;
@@ -29,6 +42,11 @@ module ccr #(
   `ifndef SIM
   initial begin
     btn_debounce_counter = BTN_DEBOUNCE_COUNTER_VALUE_p;
+    btn_rst_n_stage_1 = 1'b1;
+    btn_rst_n_stage_2 = 1'b1;
+    btn_rst_n_stage_3 = 1'b1;
+    btn_rst_n_stage_4 = 1'b1;
+    btn_debounced = 1'b1;
   end
   `endif
 
@@ -60,13 +78,13 @@ module ccr #(
     .CLKFBOUT_PHASE(0.0),      // Phase offset in degrees of CLKFB (-360.000-360.000).
     .CLKIN1_PERIOD(10.000),    // Input clock period in ns to ps resolution (i.e. 33.333 is 30 MHz).
     // CLKOUT0_DIVIDE - CLKOUT6_DIVIDE: Divide amount for each CLKOUT (1-128)
-    .CLKOUT1_DIVIDE(1),
+    .CLKOUT1_DIVIDE(PERIPH_CLK_DIVIDE_p),
     .CLKOUT2_DIVIDE(1),
     .CLKOUT3_DIVIDE(1),
     .CLKOUT4_DIVIDE(1),
     .CLKOUT5_DIVIDE(1),
     .CLKOUT6_DIVIDE(1),
-    .CLKOUT0_DIVIDE_F(6.0),    // Divide amount for CLKOUT0 (1.000-128.000).
+    .CLKOUT0_DIVIDE_F(CPU_CLK_DIVIDE_p), // Divide amount for CLKOUT0 (1.000-128.000).
     // CLKOUT0_DUTY_CYCLE - CLKOUT6_DUTY_CYCLE: Duty cycle for each CLKOUT (0.01-0.99).
     .CLKOUT0_DUTY_CYCLE(0.5),
     .CLKOUT1_DUTY_CYCLE(0.5),
@@ -92,7 +110,7 @@ module ccr #(
     // Clock Outputs: 1-bit (each) output: User configurable clock outputs
     .CLKOUT0    ( s_clk       ),   // 1-bit output: CLKOUT0
     .CLKOUT0B   ( /* OPEN */  ),   // 1-bit output: Inverted CLKOUT0
-    .CLKOUT1    ( /* OPEN */  ),   // 1-bit output: CLKOUT1
+    .CLKOUT1    ( s_periph_clk ),  // 1-bit output: CLKOUT1
     .CLKOUT1B   ( /* OPEN */  ),   // 1-bit output: Inverted CLKOUT1
     .CLKOUT2    ( /* OPEN */  ),   // 1-bit output: CLKOUT2
     .CLKOUT2B   ( /* OPEN */  ),   // 1-bit output: Inverted CLKOUT2
@@ -115,19 +133,36 @@ module ccr #(
     .CLKFBIN    ( s_clk_fb    )    // 1-bit input: Feedback clock
   );
 
-  logic [$clog2(PLL_LOCK_COUNTER_VALUE_p)-1:0] s_rst_cnt;  
+  logic [$clog2(RST_GUARD_CYCLES_p+1)-1:0] s_rst_cnt;
   logic s_clear_counter;
 
   // Now use the synchronized version
   always_ff @(posedge s_clk) begin
     s_clear_counter <= ~(s_locked & btn_debounced);
-    s_rst_n <= (s_rst_cnt == PLL_LOCK_COUNTER_VALUE_p);
-  
+    s_rst_n <= (s_rst_cnt == RST_GUARD_CYCLES_p);
+
     if (s_clear_counter) begin
       s_rst_cnt <= '0;
-    end else if (s_rst_cnt != PLL_LOCK_COUNTER_VALUE_p) begin
+    end else if (s_rst_cnt != RST_GUARD_CYCLES_p) begin
       s_rst_cnt <= s_rst_cnt + 1;
     end
   end
 
+  // Peripheral domain reset, synchronized from the CPU domain
+  (* ASYNC_REG = "TRUE" *) logic [1:0] periph_rst_n_sync;
+
+  always_ff @(posedge s_periph_clk) begin
+    periph_rst_n_sync <= {periph_rst_n_sync[0], s_rst_n};
+  end
+
+  assign o_periph_rst_n = periph_rst_n_sync[1];
+
+  // CPU domain reset, released once the peripheral domain is out of reset
+  (* ASYNC_REG = "TRUE" *) logic [1:0] cpu_rst_n_sync;
+
+  always_ff @(posedge s_clk) begin
+    cpu_rst_n_sync <= {cpu_rst_n_sync[0], periph_rst_n_sync[1]};
+    o_rst_n <= s_rst_n & cpu_rst_n_sync[1];
+  end
+
 endmodule : ccr
@@ -7,6 +7,8 @@ module ccr_tb_top ();
   logic tb_sysrst_n;
   logic dut_clk;
   logic dut_rst_n;
+  logic dut_periph_clk;
+  logic dut_periph_rst_n;
 
   // Generate clock
   initial begin
@@ -21,6 +23,9 @@ module ccr_tb_top ();
     tb_sysrst_n <= 1'b1;
 
     wait (dut_rst_n == 1'b1);
+    if (dut_periph_rst_n !== 1'b1) begin
+      $error("CPU reset released before the peripheral reset");
+    end
     repeat (10) @(posedge tb_clk);
 
     tb_sysrst_n <= 1'b0;
@@ -34,13 +39,17 @@ module ccr_tb_top ();
   end
 
   ccr #(
-    .SYSRST_DEBOUNCE_COUNTER_VALUE_p(15),
-    .PLL_LOCK_COUNTER_VALUE_p(20)
+    .BTN_DEBOUNCE_COUNTER_VALUE_p(15),
+    .RST_GUARD_CYCLES_p(20),
+    .CPU_CLK_DIVIDE_p(5.0),
+    .PERIPH_CLK_DIVIDE_p(6)
   ) ccr_dut_i (
-    .i_clk      ( tb_clk      ),
-    .i_btn_rst_n ( tb_sysrst_n ),
-    .o_clk      ( dut_clk     ),
-    .o_rst_n    ( dut_rst_n   )
+    .i_clk          ( tb_clk           ),
+    .i_btn_rst_n    ( tb_sysrst_n      ),
+    .o_clk          ( dut_clk          ),
+    .o_rst_n        ( dut_rst_n        ),
+    .o_periph_clk   ( dut_periph_clk   ),
+    .o_periph_rst_n ( dut_periph_rst_n )
   );
 
 endmodule : ccr_tb_top
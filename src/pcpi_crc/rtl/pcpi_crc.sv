@@ -0,0 +1,107 @@
+// PCPI co-processor for checksum and byte manipulation
+//
+// All instructions are R-type on the custom-1 opcode (7'b0101011) with funct7 = 0:
+//
+//   funct3  mnemonic             operation
+//   ------  -------------------  -----------------------------------------------------------
+//   3'b000  crc32.w rd, rs1, rs2 rd = CRC-32 state rs1 updated with the 4 bytes of rs2
+//                                (little-endian, i.e. a word loaded from a byte buffer)
+//   3'b001  crc32.b rd, rs1, rs2 rd = CRC-32 state rs1 updated with the byte rs2[7:0]
+//   3'b100  swz     rd, rs1, rs2 rd byte i = rs1 byte rs2[2i+1:2i] (rs2 = 0x1B swaps bytes)
+//   3'b101  bfextu  rd, rs1, rs2 rd = rs1[rs2[4:0] +: rs2[9:5]+1], zero extended
+//
+// The CRC state is the raw reflected register (no pre/post inversion), so the instructions
+// drop into the crc32_update() loop of sw/lib/crc.c. The result is registered and the
+// instruction completes one cycle after pcpi_valid, o_pcpi_wait is never used.
+module pcpi_crc #(
+  parameter logic [31:0] CRC32_POLY_p = 32'hEDB8_8320  // Reflected IEEE 802.3 polynomial
+)(
+  input  logic        clk,
+  input  logic        rst_n,
+  input  logic        i_pcpi_valid,
+  input  logic [31:0] i_pcpi_insn,
+  input  logic [31:0] i_pcpi_rs1,
+  input  logic [31:0] i_pcpi_rs2,
+  output logic        o_pcpi_wr,
+  output logic [31:0] o_pcpi_rd,
+  output logic        o_pcpi_wait,
+  output logic        o_pcpi_ready
+);
+
+  localparam logic [6:0] OPCODE_CUSTOM_1 = 7'b0101011;
+  localparam logic [2:0] FUNCT3_CRC32_W  = 3'b000;
+  localparam logic [2:0] FUNCT3_CRC32_B  = 3'b001;
+  localparam logic [2:0] FUNCT3_SWZ      = 3'b100;
+  localparam logic [2:0] FUNCT3_BFEXTU   = 3'b101;
+
+  // One bit-serial CRC step per data bit, LSB first. Unrolled by synthesis into an XOR tree.
+  function automatic logic [31:0] crc32_byte(input logic [31:0] crc, input logic [7:0] data);
+    for (int i = 0; i < 8; i++) begin
+      crc = (crc >> 1) ^ (CRC32_POLY_p & {32{crc[0] ^ data[i]}});
+    end
+    return crc;
+  endfunction
+
+  logic [2:0]  s_funct3;
+  logic        s_insn_match;
+  logic [31:0] s_result;
+  logic [31:0] s_crc32_w;
+  logic [31:0] s_swz;
+  logic [31:0] s_bf_mask;
+
+  assign s_funct3 = i_pcpi_insn[14:12];
+
+  always_comb begin
+    s_insn_match = 1'b0;
+    if (i_pcpi_valid && i_pcpi_insn[6:0] == OPCODE_CUSTOM_1 && i_pcpi_insn[31:25] == 7'b0) begin
+      unique case (s_funct3)
+        FUNCT3_CRC32_W,
+        FUNCT3_CRC32_B,
+        FUNCT3_SWZ,
+        FUNCT3_BFEXTU: s_insn_match = 1'b1;
+        default:       s_insn_match = 1'b0;
+      endcase
+    end
+  end
+
+  assign s_crc32_w = crc32_byte(crc32_byte(crc32_byte(crc32_byte(i_pcpi_rs1,
+                       i_pcpi_rs2[7:0]), i_pcpi_rs2[15:8]), i_pcpi_rs2[23:16]), i_pcpi_rs2[31:24]);
+
+  always_comb begin
+    for (int i = 0; i < 4; i++) begin
+      s_swz[8*i +: 8] = i_pcpi_rs1[8*i_pcpi_rs2[2*i +: 2] +: 8];
+    end
+  end
+
+  // Field width is rs2[9:5] + 1, so a width field of 31 selects all 32 bits
+  assign s_bf_mask = 32'hFFFF_FFFF >> (5'd31 - i_pcpi_rs2[9:5]);
+
+  always_comb begin
+    unique case (s_funct3)
+      FUNCT3_CRC32_W: s_result = s_crc32_w;
+      FUNCT3_CRC32_B: s_result = crc32_byte(i_pcpi_rs1, i_pcpi_rs2[7:0]);
+      FUNCT3_SWZ:     s_result = s_swz;
+      FUNCT3_BFEXTU:  s_result = (i_pcpi_rs1 >> i_pcpi_rs2[4:0]) & s_bf_mask;
+      default:        s_result = '0;
+    endcase
+  end
+
+  // The core holds pcpi_valid until it has seen pcpi_ready, so the ready pulse is suppressed
+  // in the cycle after it was raised to avoid executing the same instruction twice.
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      o_pcpi_ready <= 1'b0;
+      o_pcpi_wr    <= 1'b0;
+    end else begin
+      o_pcpi_ready <= s_insn_match & ~o_pcpi_ready;
+      o_pcpi_wr    <= s_insn_match & ~o_pcpi_ready;
+    end
+  end
+
+  always_ff @(posedge clk) begin
+    o_pcpi_rd <= s_result;
+  end
+
+  assign o_pcpi_wait = 1'b0;
+
+endmodule : pcpi_crc
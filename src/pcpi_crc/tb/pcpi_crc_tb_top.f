@@ -0,0 +1,2 @@
+$PCPI_CRC_PROJ_ROOT/rtl/pcpi_crc.sv
+$PCPI_CRC_PROJ_ROOT/tb/pcpi_crc_tb_top.sv
@@ -0,0 +1,148 @@
+module pcpi_crc_tb_top ();
+
+  timeunit 1ns;
+  timeprecision 1ps;
+
+  localparam logic [2:0] CRC32_W = 3'b000;
+  localparam logic [2:0] CRC32_B = 3'b001;
+  localparam logic [2:0] SWZ     = 3'b100;
+  localparam logic [2:0] BFEXTU  = 3'b101;
+
+  logic        tb_clk;
+  logic        tb_rst_n;
+  logic        tb_pcpi_valid;
+  logic [31:0] tb_pcpi_insn;
+  logic [31:0] tb_pcpi_rs1;
+  logic [31:0] tb_pcpi_rs2;
+  logic        dut_pcpi_wr;
+  logic [31:0] dut_pcpi_rd;
+  logic        dut_pcpi_wait;
+  logic        dut_pcpi_ready;
+
+  int errors = 0;
+
+  // Generate clock
+  initial begin
+    tb_clk <= 1'b0;
+    forever #5ns tb_clk <= ~tb_clk;
+  end
+
+  // Behaves like PicoRV32: hold pcpi_valid until pcpi_ready, give up after 16 cycles
+  task automatic pcpi_exec(input logic [31:0] insn, input logic [31:0] rs1,
+                           input logic [31:0] rs2, output logic ready, output logic [31:0] rd);
+    ready = 1'b0;
+    rd = 'x;
+    @(posedge tb_clk);
+    tb_pcpi_valid <= 1'b1;
+    tb_pcpi_insn  <= insn;
+    tb_pcpi_rs1   <= rs1;
+    tb_pcpi_rs2   <= rs2;
+    for (int i = 0; i < 16; i++) begin
+      @(posedge tb_clk);
+      if (dut_pcpi_ready) begin
+        ready = 1'b1;
+        rd = dut_pcpi_rd;
+        if (!dut_pcpi_wr) begin
+          $error("pcpi_wr not set with pcpi_ready");
+          errors++;
+        end
+        break;
+      end
+    end
+    tb_pcpi_valid <= 1'b0;
+    // A second ready pulse would retire the instruction twice
+    @(posedge tb_clk);
+    if (dut_pcpi_ready) begin
+      $error("Spurious pcpi_ready after completion");
+      errors++;
+    end
+  endtask
+
+  task automatic check(input string name, input logic [2:0] funct3, input logic [31:0] rs1,
+                       input logic [31:0] rs2, input logic [31:0] expected);
+    logic ready;
+    logic [31:0] rd;
+    pcpi_exec({7'b0, 5'd12, 5'd11, funct3, 5'd10, 7'b0101011}, rs1, rs2, ready, rd);
+    if (!ready || rd !== expected) begin
+      $error("%s: rs1=%08h rs2=%08h got %08h (ready=%0b), expected %08h",
+             name, rs1, rs2, rd, ready, expected);
+      errors++;
+    end
+  endtask
+
+  initial begin
+    logic ready;
+    logic [31:0] rd;
+    logic [31:0] crc;
+
+    tb_rst_n      <= 1'b0;
+    tb_pcpi_valid <= 1'b0;
+    tb_pcpi_insn  <= '0;
+    tb_pcpi_rs1   <= '0;
+    tb_pcpi_rs2   <= '0;
+    repeat (5) @(posedge tb_clk);
+    tb_rst_n <= 1'b1;
+
+    // CRC-32 check value: crc32("123456789") = 0xCBF43926
+    check("crc32.w 1234", CRC32_W, 32'hFFFF_FFFF, 32'h3433_3231, 32'h641C_1F5C);
+    check("crc32.w 5678", CRC32_W, 32'h641C_1F5C, 32'h3837_3635, 32'h651F_2550);
+    check("crc32.b 9",    CRC32_B, 32'h651F_2550, 32'h0000_0039, 32'h340B_C6D9);
+    check("crc32.w",      CRC32_W, 32'h0000_0000, 32'hDEAD_BEEF, 32'h3B1E_BF03);
+    check("crc32.b",      CRC32_B, 32'h1234_5678, 32'hFFFF_FFA5, 32'hF870_9A3F);
+
+    // Word update equals four byte updates
+    crc = 32'h89AB_CDEF;
+    begin
+      logic [31:0] word_rd;
+      pcpi_exec({7'b0, 5'd12, 5'd11, CRC32_W, 5'd10, 7'b0101011}, crc, 32'hA1B2_C3D4, ready, word_rd);
+      for (int i = 0; i < 4; i++) begin
+        pcpi_exec({7'b0, 5'd12, 5'd11, CRC32_B, 5'd10, 7'b0101011}, crc,
+                  32'hA1B2_C3D4 >> (8*i), ready, crc);
+      end
+      if (crc !== word_rd) begin
+        $error("crc32.w %08h != 4x crc32.b %08h", word_rd, crc);
+        errors++;
+      end
+    end
+
+    check("swz bswap",    SWZ,     32'h4433_2211, 32'h0000_001B, 32'h1122_3344);
+    check("swz identity", SWZ,     32'h4433_2211, 32'h0000_00E4, 32'h4433_2211);
+    check("swz splat",    SWZ,     32'h4433_2211, 32'h0000_0055, 32'h2222_2222);
+    check("bfextu 8+:12", BFEXTU,  32'hDEAD_BEEF, {22'b0, 5'd11, 5'd8},  32'h0000_0DBE);
+    check("bfextu 0+:32", BFEXTU,  32'hDEAD_BEEF, {22'b0, 5'd31, 5'd0},  32'hDEAD_BEEF);
+    check("bfextu 31+:1", BFEXTU,  32'hDEAD_BEEF, {22'b0, 5'd0,  5'd31}, 32'h0000_0001);
+
+    // Instructions that belong to other units (MUL, unused funct3) must be ignored
+    pcpi_exec({7'b0000001, 5'd12, 5'd11, 3'b000, 5'd10, 7'b0110011}, 32'd3, 32'd5, ready, rd);
+    if (ready) begin
+      $error("Responded to a MUL instruction");
+      errors++;
+    end
+    pcpi_exec({7'b0, 5'd12, 5'd11, 3'b111, 5'd10, 7'b0101011}, 32'd3, 32'd5, ready, rd);
+    if (ready) begin
+      $error("Responded to an unimplemented funct3");
+      errors++;
+    end
+
+    if (errors == 0) begin
+      $display("PASSED");
+    end else begin
+      $display("FAILED with %0d errors", errors);
+    end
+    $finish;
+  end
+
+  pcpi_crc pcpi_crc_dut_i (
+    .clk          ( tb_clk          ),
+    .rst_n        ( tb_rst_n        ),
+    .i_pcpi_valid ( tb_pcpi_valid   ),
+    .i_pcpi_insn  ( tb_pcpi_insn    ),
+    .i_pcpi_rs1   ( tb_pcpi_rs1     ),
+    .i_pcpi_rs2   ( tb_pcpi_rs2     ),
+    .o_pcpi_wr    ( dut_pcpi_wr     ),
+    .o_pcpi_rd    ( dut_pcpi_rd     ),
+    .o_pcpi_wait  ( dut_pcpi_wait   ),
+    .o_pcpi_ready ( dut_pcpi_ready  )
+  );
+
+endmodule : pcpi_crc_tb_top
@@ -0,0 +1,287 @@
+// PCPI co-processor for packed 8/16-bit arithmetic and multiply-accumulate
+//
+// All instructions are R-type on the custom-2 opcode (7'b1011011). funct7 selects the group,
+// funct3 the operation. Lanes are the 4 bytes (8) or 2 halfwords (16) of a register.
+//
+//   funct7  funct3  mnemonic    operation
+//   ------  ------  ----------  ---------------------------------------------------------------
+//   0       0..3    add8 sub8 add16 sub16       lane-wise, wrapping
+//   1       0..3    kadd8 ksub8 kadd16 ksub16   lane-wise, signed saturation
+//   1       4..7    ukadd8 uksub8 ukadd16 uksub16  lane-wise, unsigned saturation
+//   2       0..3    cmpeq8 cmplt8 cmpeq16 cmplt16  lane = all ones when true (signed lt)
+//   2       4..7    max8 min8 max16 min16       lane-wise signed
+//   3       0       dot8        rd = sum of the 4 signed byte products
+//   3       1       dot16       rd = sum of the 2 signed halfword products (low 32 bits)
+//   3       2       mac8        acc += dot8,  rd = acc[31:0]
+//   3       3       mac16       acc += dot16, rd = acc[31:0]
+//   3       4       accrd       rd = acc >>> rs1[5:0], saturated to 32 bits
+//   3       5       accwr       acc = {rs2, rs1}, rd is not written
+//
+// acc is a 64-bit accumulator private to this unit (one per core). Every instruction takes two
+// cycles after pcpi_valid: the first registers the lane results and the products, the second
+// accumulates and responds, which keeps the multipliers off the accumulator path. That is well
+// inside the PicoRV32 PCPI timeout, so o_pcpi_wait is never used.
+module pcpi_simd (
+  input  logic        clk,
+  input  logic        rst_n,
+  input  logic        i_pcpi_valid,
+  input  logic [31:0] i_pcpi_insn,
+  input  logic [31:0] i_pcpi_rs1,
+  input  logic [31:0] i_pcpi_rs2,
+  output logic        o_pcpi_wr,
+  output logic [31:0] o_pcpi_rd,
+  output logic        o_pcpi_wait,
+  output logic        o_pcpi_ready
+);
+
+  localparam logic [6:0] OPCODE_CUSTOM_2 = 7'b1011011;
+  localparam logic [1:0] GROUP_WRAP      = 2'd0;
+  localparam logic [1:0] GROUP_SAT       = 2'd1;
+  localparam logic [1:0] GROUP_CMP       = 2'd2;
+  localparam logic [1:0] GROUP_MAC       = 2'd3;
+  localparam logic [2:0] FUNCT3_DOT8     = 3'd0;
+  localparam logic [2:0] FUNCT3_DOT16    = 3'd1;
+  localparam logic [2:0] FUNCT3_MAC8     = 3'd2;
+  localparam logic [2:0] FUNCT3_MAC16    = 3'd3;
+  localparam logic [2:0] FUNCT3_ACCRD    = 3'd4;
+  localparam logic [2:0] FUNCT3_ACCWR    = 3'd5;
+
+  // --------------------------------------------------------------------------
+  // Lane helpers
+  // --------------------------------------------------------------------------
+  function automatic logic [7:0] sat8s(input logic signed [8:0] v);
+    if (v > 9'sd127) begin
+      return 8'h7F;
+    end else if (v < -9'sd128) begin
+      return 8'h80;
+    end
+    return v[7:0];
+  endfunction
+
+  function automatic logic [15:0] sat16s(input logic signed [16:0] v);
+    if (v > 17'sd32767) begin
+      return 16'h7FFF;
+    end else if (v < -17'sd32768) begin
+      return 16'h8000;
+    end
+    return v[15:0];
+  endfunction
+
+  // Unsigned saturation: v is the 9/17-bit result of an add (carry) or subtract (borrow)
+  function automatic logic [7:0] sat8u(input logic [8:0] v, input logic sub);
+    return v[8] ? (sub ? 8'h00 : 8'hFF) : v[7:0];
+  endfunction
+
+  function automatic logic [15:0] sat16u(input logic [16:0] v, input logic sub);
+    return v[16] ? (sub ? 16'h0000 : 16'hFFFF) : v[15:0];
+  endfunction
+
+  // --------------------------------------------------------------------------
+  // Decode
+  // --------------------------------------------------------------------------
+  logic [1:0] s_group;
+  logic [2:0] s_funct3;
+  logic       s_insn_match;
+  logic       s_start;
+
+  // Stage 1
+  logic        s1_valid;
+  logic [1:0]  s1_group;
+  logic [2:0]  s1_funct3;
+  logic [31:0] s1_lane;
+  logic [31:0] s1_rs1;
+  logic [31:0] s1_rs2;
+  logic signed [17:0] s1_dot8;
+  logic signed [32:0] s1_dot16;
+
+  logic signed [63:0] acc;
+
+  assign s_group  = i_pcpi_insn[26:25];
+  assign s_funct3 = i_pcpi_insn[14:12];
+
+  always_comb begin
+    s_insn_match = 1'b0;
+    if (i_pcpi_valid && i_pcpi_insn[6:0] == OPCODE_CUSTOM_2 && i_pcpi_insn[31:27] == 5'b0) begin
+      if (s_group == GROUP_WRAP) begin
+        s_insn_match = ~s_funct3[2];
+      end else if (s_group == GROUP_MAC) begin
+        s_insn_match = s_funct3 <= FUNCT3_ACCWR;
+      end else begin
+        s_insn_match = 1'b1;
+      end
+    end
+  end
+
+  // The core holds pcpi_valid until it has seen pcpi_ready, a new instruction is only started
+  // when neither stage holds the previous one.
+  assign s_start = s_insn_match & ~s1_valid & ~o_pcpi_ready;
+
+  // --------------------------------------------------------------------------
+  // Stage 1: lane operations and products
+  // --------------------------------------------------------------------------
+  logic [31:0]        s_lane;
+  logic signed [17:0] s_dot8;
+  logic signed [32:0] s_dot16;
+
+  always_comb begin
+    s_lane = '0;
+    unique case (s_group)
+      GROUP_WRAP: begin
+        for (int i = 0; i < 4; i++) begin
+          s_lane[8*i +: 8] = s_funct3[0] ? i_pcpi_rs1[8*i +: 8] - i_pcpi_rs2[8*i +: 8]
+                                         : i_pcpi_rs1[8*i +: 8] + i_pcpi_rs2[8*i +: 8];
+        end
+        if (s_funct3[1]) begin
+          for (int i = 0; i < 2; i++) begin
+            s_lane[16*i +: 16] = s_funct3[0] ? i_pcpi_rs1[16*i +: 16] - i_pcpi_rs2[16*i +: 16]
+                                             : i_pcpi_rs1[16*i +: 16] + i_pcpi_rs2[16*i +: 16];
+          end
+        end
+      end
+      GROUP_SAT: begin
+        for (int i = 0; i < 4; i++) begin
+          if (s_funct3[2]) begin
+            s_lane[8*i +: 8] = sat8u(s_funct3[0] ? {1'b0, i_pcpi_rs1[8*i +: 8]} - i_pcpi_rs2[8*i +: 8]
+                                                 : {1'b0, i_pcpi_rs1[8*i +: 8]} + i_pcpi_rs2[8*i +: 8],
+                                     s_funct3[0]);
+          end else begin
+            s_lane[8*i +: 8] = sat8s(s_funct3[0]
+              ? $signed({i_pcpi_rs1[8*i+7], i_pcpi_rs1[8*i +: 8]}) - $signed({i_pcpi_rs2[8*i+7], i_pcpi_rs2[8*i +: 8]})
+              : $signed({i_pcpi_rs1[8*i+7], i_pcpi_rs1[8*i +: 8]}) + $signed({i_pcpi_rs2[8*i+7], i_pcpi_rs2[8*i +: 8]}));
+          end
+        end
+        if (s_funct3[1]) begin
+          for (int i = 0; i < 2; i++) begin
+            if (s_funct3[2]) begin
+              s_lane[16*i +: 16] = sat16u(s_funct3[0] ? {1'b0, i_pcpi_rs1[16*i +: 16]} - i_pcpi_rs2[16*i +: 16]
+                                                      : {1'b0, i_pcpi_rs1[16*i +: 16]} + i_pcpi_rs2[16*i +: 16],
+                                          s_funct3[0]);
+            end else begin
+              s_lane[16*i +: 16] = sat16s(s_funct3[0]
+                ? $signed({i_pcpi_rs1[16*i+15], i_pcpi_rs1[16*i +: 16]}) - $signed({i_pcpi_rs2[16*i+15], i_pcpi_rs2[16*i +: 16]})
+                : $signed({i_pcpi_rs1[16*i+15], i_pcpi_rs1[16*i +: 16]}) + $signed({i_pcpi_rs2[16*i+15], i_pcpi_rs2[16*i +: 16]}));
+            end
+          end
+        end
+      end
+      GROUP_CMP: begin
+        // funct3[2]: max/min instead of a mask, funct3[0]: lt (min) instead of eq (max)
+        for (int i = 0; i < 4; i++) begin
+          logic lt8;
+          lt8 = $signed(i_pcpi_rs1[8*i +: 8]) < $signed(i_pcpi_rs2[8*i +: 8]);
+          if (s_funct3[2]) begin
+            s_lane[8*i +: 8] = (lt8 ^ ~s_funct3[0]) ? i_pcpi_rs1[8*i +: 8] : i_pcpi_rs2[8*i +: 8];
+          end else begin
+            s_lane[8*i +: 8] = {8{s_funct3[0] ? lt8 : i_pcpi_rs1[8*i +: 8] == i_pcpi_rs2[8*i +: 8]}};
+          end
+        end
+        if (s_funct3[1]) begin
+          for (int i = 0; i < 2; i++) begin
+            logic lt16;
+            lt16 = $signed(i_pcpi_rs1[16*i +: 16]) < $signed(i_pcpi_rs2[16*i +: 16]);
+            if (s_funct3[2]) begin
+              s_lane[16*i +: 16] = (lt16 ^ ~s_funct3[0]) ? i_pcpi_rs1[16*i +: 16] : i_pcpi_rs2[16*i +: 16];
+            end else begin
+              s_lane[16*i +: 16] = {16{s_funct3[0] ? lt16 : i_pcpi_rs1[16*i +: 16] == i_pcpi_rs2[16*i +: 16]}};
+            end
+          end
+        end
+      end
+      default: s_lane = '0;
+    endcase
+  end
+
+  // Products are assigned to full-width signed temporaries first, the operands are only as wide
+  // as a lane and would otherwise lose the upper product bits.
+  always_comb begin
+    logic signed [15:0] p8;
+    logic signed [31:0] p16_lo;
+    logic signed [31:0] p16_hi;
+    s_dot8 = '0;
+    for (int i = 0; i < 4; i++) begin
+      p8 = $signed(i_pcpi_rs1[8*i +: 8]) * $signed(i_pcpi_rs2[8*i +: 8]);
+      s_dot8 += p8;
+    end
+    p16_lo  = $signed(i_pcpi_rs1[15:0]) * $signed(i_pcpi_rs2[15:0]);
+    p16_hi  = $signed(i_pcpi_rs1[31:16]) * $signed(i_pcpi_rs2[31:16]);
+    s_dot16 = p16_lo + p16_hi;
+  end
+
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      s1_valid <= 1'b0;
+    end else begin
+      s1_valid <= s_start;
+    end
+  end
+
+  always_ff @(posedge clk) begin
+    if (s_start) begin
+      s1_group  <= s_group;
+      s1_funct3 <= s_funct3;
+      s1_lane   <= s_lane;
+      s1_rs1    <= i_pcpi_rs1;
+      s1_rs2    <= i_pcpi_rs2;
+      s1_dot8   <= s_dot8;
+      s1_dot16  <= s_dot16;
+    end
+  end
+
+  // --------------------------------------------------------------------------
+  // Stage 2: accumulate and respond
+  // --------------------------------------------------------------------------
+  logic signed [63:0] s_acc_next;
+  logic signed [63:0] s_acc_shifted;
+  logic [31:0]        s_result;
+
+  assign s_acc_shifted = acc >>> s1_rs1[5:0];
+
+  always_comb begin
+    s_acc_next = acc;
+    s_result   = s1_lane;
+    if (s1_group == GROUP_MAC) begin
+      unique case (s1_funct3)
+        FUNCT3_DOT8:  s_result = 32'(s1_dot8);
+        FUNCT3_DOT16: s_result = s1_dot16[31:0];
+        FUNCT3_MAC8: begin
+          s_acc_next = acc + s1_dot8;
+          s_result   = s_acc_next[31:0];
+        end
+        FUNCT3_MAC16: begin
+          s_acc_next = acc + s1_dot16;
+          s_result   = s_acc_next[31:0];
+        end
+        FUNCT3_ACCRD: begin
+          if (s_acc_shifted[63:31] != {33{s_acc_shifted[63]}}) begin
+            s_result = s_acc_shifted[63] ? 32'h8000_0000 : 32'h7FFF_FFFF;
+          end else begin
+            s_result = s_acc_shifted[31:0];
+          end
+        end
+        FUNCT3_ACCWR: s_acc_next = {s1_rs2, s1_rs1};
+        default: ;
+      endcase
+    end
+  end
+
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      acc          <= '0;
+      o_pcpi_ready <= 1'b0;
+      o_pcpi_wr    <= 1'b0;
+    end else begin
+      if (s1_valid) begin
+        acc <= s_acc_next;
+      end
+      o_pcpi_ready <= s1_valid;
+      o_pcpi_wr    <= s1_valid & ~(s1_group == GROUP_MAC && s1_funct3 == FUNCT3_ACCWR);
+    end
+  end
+
+  always_ff @(posedge clk) begin
+    o_pcpi_rd <= s_result;
+  end
+
+  assign o_pcpi_wait = 1'b0;
+
+endmodule : pcpi_simd
@@ -0,0 +1,2 @@
+$PCPI_SIMD_PROJ_ROOT/rtl/pcpi_simd.sv
+$PCPI_SIMD_PROJ_ROOT/tb/pcpi_simd_tb_top.sv
@@ -0,0 +1,213 @@
+module pcpi_simd_tb_top ();
+
+  timeunit 1ns;
+  timeprecision 1ps;
+
+  // {funct7[1:0], funct3}
+  localparam logic [4:0] ADD8    = 5'b00_000;
+  localparam logic [4:0] SUB8    = 5'b00_001;
+  localparam logic [4:0] ADD16   = 5'b00_010;
+  localparam logic [4:0] SUB16   = 5'b00_011;
+  localparam logic [4:0] KADD8   = 5'b01_000;
+  localparam logic [4:0] KSUB8   = 5'b01_001;
+  localparam logic [4:0] KADD16  = 5'b01_010;
+  localparam logic [4:0] KSUB16  = 5'b01_011;
+  localparam logic [4:0] UKADD8  = 5'b01_100;
+  localparam logic [4:0] UKSUB8  = 5'b01_101;
+  localparam logic [4:0] UKADD16 = 5'b01_110;
+  localparam logic [4:0] UKSUB16 = 5'b01_111;
+  localparam logic [4:0] CMPEQ8  = 5'b10_000;
+  localparam logic [4:0] CMPLT8  = 5'b10_001;
+  localparam logic [4:0] CMPEQ16 = 5'b10_010;
+  localparam logic [4:0] CMPLT16 = 5'b10_011;
+  localparam logic [4:0] MAX8    = 5'b10_100;
+  localparam logic [4:0] MIN8    = 5'b10_101;
+  localparam logic [4:0] MAX16   = 5'b10_110;
+  localparam logic [4:0] MIN16   = 5'b10_111;
+  localparam logic [4:0] DOT8    = 5'b11_000;
+  localparam logic [4:0] DOT16   = 5'b11_001;
+  localparam logic [4:0] MAC8    = 5'b11_010;
+  localparam logic [4:0] MAC16   = 5'b11_011;
+  localparam logic [4:0] ACCRD   = 5'b11_100;
+  localparam logic [4:0] ACCWR   = 5'b11_101;
+
+  logic        tb_clk;
+  logic        tb_rst_n;
+  logic        tb_pcpi_valid;
+  logic [31:0] tb_pcpi_insn;
+  logic [31:0] tb_pcpi_rs1;
+  logic [31:0] tb_pcpi_rs2;
+  logic        dut_pcpi_wr;
+  logic [31:0] dut_pcpi_rd;
+  logic        dut_pcpi_wait;
+  logic        dut_pcpi_ready;
+
+  int errors = 0;
+
+  // Generate clock
+  initial begin
+    tb_clk <= 1'b0;
+    forever #5ns tb_clk <= ~tb_clk;
+  end
+
+  function automatic logic [31:0] encode(input logic [4:0] op);
+    return {5'b0, op[4:3], 5'd12, 5'd11, op[2:0], 5'd10, 7'b1011011};
+  endfunction
+
+  // Behaves like PicoRV32: hold pcpi_valid until pcpi_ready, give up after 16 cycles
+  task automatic pcpi_exec(input logic [31:0] insn, input logic [31:0] rs1,
+                           input logic [31:0] rs2, output logic ready, output logic wr,
+                           output logic [31:0] rd);
+    ready = 1'b0;
+    wr = 1'b0;
+    rd = 'x;
+    @(posedge tb_clk);
+    tb_pcpi_valid <= 1'b1;
+    tb_pcpi_insn  <= insn;
+    tb_pcpi_rs1   <= rs1;
+    tb_pcpi_rs2   <= rs2;
+    for (int i = 0; i < 16; i++) begin
+      @(posedge tb_clk);
+      if (dut_pcpi_ready) begin
+        ready = 1'b1;
+        wr = dut_pcpi_wr;
+        rd = dut_pcpi_rd;
+        break;
+      end
+    end
+    tb_pcpi_valid <= 1'b0;
+    // A second ready pulse would retire the instruction twice
+    @(posedge tb_clk);
+    if (dut_pcpi_ready) begin
+      $error("Spurious pcpi_ready after completion");
+      errors++;
+    end
+  endtask
+
+  task automatic check(input string name, input logic [4:0] op, input logic [31:0] rs1,
+                       input logic [31:0] rs2, input logic [31:0] expected);
+    logic ready;
+    logic wr;
+    logic [31:0] rd;
+    pcpi_exec(encode(op), rs1, rs2, ready, wr, rd);
+    if (!ready || !wr || rd !== expected) begin
+      $error("%s: rs1=%08h rs2=%08h got %08h (ready=%0b wr=%0b), expected %08h",
+             name, rs1, rs2, rd, ready, wr, expected);
+      errors++;
+    end
+  endtask
+
+  task automatic acc_write(input logic [63:0] value);
+    logic ready;
+    logic wr;
+    logic [31:0] rd;
+    pcpi_exec(encode(ACCWR), value[31:0], value[63:32], ready, wr, rd);
+    if (!ready || wr) begin
+      $error("accwr: ready=%0b wr=%0b, expected a response without a register write", ready, wr);
+      errors++;
+    end
+  endtask
+
+  initial begin
+    logic ready;
+    logic wr;
+    logic [31:0] rd;
+
+    tb_rst_n      <= 1'b0;
+    tb_pcpi_valid <= 1'b0;
+    tb_pcpi_insn  <= '0;
+    tb_pcpi_rs1   <= '0;
+    tb_pcpi_rs2   <= '0;
+    repeat (5) @(posedge tb_clk);
+    tb_rst_n <= 1'b1;
+
+    // Wrapping lanes, carries must not cross lanes
+    check("add8",    ADD8,    32'h01FF_7F80, 32'h0101_0101, 32'h0200_8081);
+    check("sub8",    SUB8,    32'h0000_0000, 32'h0101_0101, 32'hFFFF_FFFF);
+    check("add16",   ADD16,   32'h7FFF_FFFF, 32'h0001_0001, 32'h8000_0000);
+    check("sub16",   SUB16,   32'h0001_0000, 32'h0001_0001, 32'h0000_FFFF);
+
+    // Saturating lanes
+    check("kadd8",   KADD8,   32'h7F80_0110, 32'h01FF_FFF0, 32'h7F80_0000);
+    check("ksub8",   KSUB8,   32'h807F_0005, 32'h01FF_0103, 32'h807F_FF02);
+    check("kadd16",  KADD16,  32'h7FFF_8000, 32'h0001_FFFF, 32'h7FFF_8000);
+    check("ksub16",  KSUB16,  32'h0000_8000, 32'h8000_0001, 32'h7FFF_8000);
+    check("ukadd8",  UKADD8,  32'hFF80_0100, 32'h0180_0100, 32'hFFFF_0200);
+    check("uksub8",  UKSUB8,  32'h0080_05FF, 32'h017F_0601, 32'h0001_00FE);
+    check("ukadd16", UKADD16, 32'hFFFF_0001, 32'h0001_0001, 32'hFFFF_0002);
+    check("uksub16", UKSUB16, 32'h0001_0005, 32'h0002_0003, 32'h0000_0002);
+
+    // Compares (signed) and min/max
+    check("cmpeq8",  CMPEQ8,  32'h1122_3344, 32'h1100_3300, 32'hFF00_FF00);
+    check("cmplt8",  CMPLT8,  32'h8001_7F00, 32'h0002_8000, 32'hFFFF_0000);
+    check("cmpeq16", CMPEQ16, 32'h1234_5678, 32'h1234_5679, 32'hFFFF_0000);
+    check("cmplt16", CMPLT16, 32'h8000_0001, 32'h7FFF_0001, 32'hFFFF_0000);
+    check("max8",    MAX8,    32'h8001_7F05, 32'h0002_8005, 32'h0002_7F05);
+    check("min8",    MIN8,    32'h8001_7F05, 32'h0002_8005, 32'h8001_8005);
+    check("max16",   MAX16,   32'h8000_0005, 32'h0001_FFFF, 32'h0001_0005);
+    check("min16",   MIN16,   32'h8000_0005, 32'h0001_FFFF, 32'h8000_FFFF);
+
+    // Dot products: 4*4 + 3*-3 + 2*2 + 1*-1 = 10, 2 * (-32768)^2 = 2^31
+    check("dot8",    DOT8,    32'h0102_0304, 32'hFF02_FD04, 32'h0000_000A);
+    check("dot16",   DOT16,   32'h8000_8000, 32'h8000_8000, 32'h8000_0000);
+
+    // Accumulator: 2*4 + 3*5 = 23, then 4 * (1 * -1) = -4
+    acc_write(64'd0);
+    check("mac16",   MAC16,   32'h0002_0003, 32'h0004_0005, 32'd23);
+    check("mac8",    MAC8,    32'h0101_0101, 32'hFFFF_FFFF, 32'd19);
+    check("accrd",   ACCRD,   32'd0,         32'd0,         32'd19);
+
+    // Read back with a shift and saturation
+    acc_write(64'h7FFF_FFFF_FFFF_FFFF);
+    check("accrd sat+", ACCRD, 32'd0,  32'd0, 32'h7FFF_FFFF);
+    check("accrd >>32", ACCRD, 32'd32, 32'd0, 32'h7FFF_FFFF);
+    check("mac16 wrap", MAC16, 32'h0000_0001, 32'h0000_0001, 32'h0000_0000);
+    check("accrd >>63", ACCRD, 32'd63, 32'd0, 32'hFFFF_FFFF);
+    check("accrd sat-", ACCRD, 32'd0,  32'd0, 32'h8000_0000);
+    acc_write(64'hFFFF_FFFF_FFFF_FF00);
+    check("accrd >>4",  ACCRD, 32'd4,  32'd0, 32'hFFFF_FFF0);
+
+    // Instructions that belong to other units or unused encodings must be ignored
+    pcpi_exec({7'b0, 5'd12, 5'd11, 3'b000, 5'd10, 7'b0101011}, 32'd3, 32'd5, ready, wr, rd);
+    if (ready) begin
+      $error("Responded to a custom-1 instruction");
+      errors++;
+    end
+    pcpi_exec({7'b0, 5'd12, 5'd11, 3'b100, 5'd10, 7'b1011011}, 32'd3, 32'd5, ready, wr, rd);
+    if (ready) begin
+      $error("Responded to an unimplemented wrapping funct3");
+      errors++;
+    end
+    pcpi_exec({7'b0000011, 5'd12, 5'd11, 3'b110, 5'd10, 7'b1011011}, 32'd3, 32'd5, ready, wr, rd);
+    if (ready) begin
+      $error("Responded to an unimplemented MAC funct3");
+      errors++;
+    end
+    pcpi_exec({7'b0000100, 5'd12, 5'd11, 3'b000, 5'd10, 7'b1011011}, 32'd3, 32'd5, ready, wr, rd);
+    if (ready) begin
+      $error("Responded to an unused funct7");
+      errors++;
+    end
+
+    if (errors == 0) begin
+      $display("PASSED");
+    end else begin
+      $display("FAILED with %0d errors", errors);
+    end
+    $finish;
+  end
+
+  pcpi_simd pcpi_simd_dut_i (
+    .clk          ( tb_clk          ),
+    .rst_n        ( tb_rst_n        ),
+    .i_pcpi_valid ( tb_pcpi_valid   ),
+    .i_pcpi_insn  ( tb_pcpi_insn    ),
+    .i_pcpi_rs1   ( tb_pcpi_rs1     ),
+    .i_pcpi_rs2   ( tb_pcpi_rs2     ),
+    .o_pcpi_wr    ( dut_pcpi_wr     ),
+    .o_pcpi_rd    ( dut_pcpi_rd     ),
+    .o_pcpi_wait  ( dut_pcpi_wait   ),
+    .o_pcpi_ready ( dut_pcpi_ready  )
+  );
+
+endmodule : pcpi_simd_tb_top
@@ -0,0 +1,418 @@
+// UART to AXI4-Lite debug bridge
+//
+// Listens on the UART RX pin next to the UART peripheral and, once unlocked, turns a small binary
+// protocol into AXI4-Lite reads and writes as its own crossbar master, so the host can load
+// memory and inspect registers without running code on the CPU. 8N1 at BAUD_p.
+//
+// The bridge is passive until it sees the unlock sequence ESC 'D' 'B' 'G' (1B 44 42 47). It then
+// answers 'K' and raises o_active: the top level routes the TX pin to the bridge and holds the
+// peripheral's RX input idle until the session is closed. The unlock bytes themselves also reach
+// the peripheral. Commands (multi-byte values little-endian, every reply ends with one status
+// byte, 'K' = OK, 'E' = AXI error response or RX overrun):
+//
+//   'W' addr[4] n  data[4 * (n+1)]  write n+1 words from addr upwards       -> 'K'/'E'
+//   'R' addr[4] n                    read n+1 words                  -> data[4 * (n+1)], 'K'/'E'
+//   'H' h                            h[0] = 1: hold the cores in reset, 0: release  -> 'K'
+//   'S'                              ping                                    -> 'K'
+//   'Q'                              close the session                       -> 'K'
+//   anything else                                                            -> '?'
+//
+// 'H' answers once i_halted matches the request. The CPU side finishes its outstanding bus
+// transaction before it is put in reset, see picorv32_soc_top. An incomplete command is dropped
+// after TIMEOUT_CYCLES_p without a byte and the bridge waits for the next command.
+module uart_axi_bridge #(
+  parameter int unsigned CLK_FREQ_p       = 100_000_000,
+  parameter int unsigned BAUD_p           = 921_600,
+  parameter int unsigned TIMEOUT_CYCLES_p = 1 << 24
+)(
+  input  logic        clk,
+  input  logic        rst_n,
+  // Serial line (i_rx is asynchronous)
+  input  logic        i_rx,
+  output logic        o_tx,
+  output logic        o_active,
+  // Core reset request and acknowledge
+  output logic        o_halt_req,
+  input  logic        i_halted,
+  // AXI4-Lite master
+  output logic [31:0] o_m_axi_awaddr,
+  output logic [2:0]  o_m_axi_awprot,
+  output logic        o_m_axi_awvalid,
+  input  logic        i_m_axi_awready,
+  output logic [31:0] o_m_axi_wdata,
+  output logic [3:0]  o_m_axi_wstrb,
+  output logic        o_m_axi_wvalid,
+  input  logic        i_m_axi_wready,
+  input  logic [1:0]  i_m_axi_bresp,
+  input  logic        i_m_axi_bvalid,
+  output logic        o_m_axi_bready,
+  output logic [31:0] o_m_axi_araddr,
+  output logic [2:0]  o_m_axi_arprot,
+  output logic        o_m_axi_arvalid,
+  input  logic        i_m_axi_arready,
+  input  logic [31:0] i_m_axi_rdata,
+  input  logic [1:0]  i_m_axi_rresp,
+  input  logic        i_m_axi_rvalid,
+  output logic        o_m_axi_rready
+);
+
+  localparam logic [1:0]  RESP_OKAY  = 2'b00;
+  localparam int unsigned DIV_p      = CLK_FREQ_p / BAUD_p;
+  localparam int unsigned DIV_BW_p   = $clog2(DIV_p + 1);
+  localparam int unsigned TMO_BW_p   = $clog2(TIMEOUT_CYCLES_p + 1);
+  localparam logic [31:0] UNLOCK_p   = 32'h4742_441B; // ESC 'D' 'B' 'G', first byte in [7:0]
+
+  // --------------------------------------------------------------------------
+  // Receiver
+  // --------------------------------------------------------------------------
+  (* ASYNC_REG = "TRUE" *) logic [1:0] rx_sync;
+  logic                rx_busy;
+  logic [DIV_BW_p-1:0] rx_cnt;
+  logic [3:0]          rx_bit;
+  logic [7:0]          rx_shift;
+  logic                rx_strobe;
+
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      rx_sync   <= 2'b11;
+      rx_busy   <= 1'b0;
+      rx_cnt    <= '0;
+      rx_bit    <= '0;
+      rx_shift  <= '0;
+      rx_strobe <= 1'b0;
+    end else begin
+      rx_sync   <= {rx_sync[0], i_rx};
+      rx_strobe <= 1'b0;
+      if (!rx_busy) begin
+        // Start bit: sample it again in the middle of the bit
+        if (!rx_sync[1]) begin
+          rx_busy <= 1'b1;
+          rx_cnt  <= DIV_BW_p'(DIV_p / 2);
+          rx_bit  <= '0;
+        end
+      end else if (rx_cnt != '0) begin
+        rx_cnt <= rx_cnt - 1'b1;
+      end else begin
+        rx_cnt <= DIV_BW_p'(DIV_p - 1);
+        rx_bit <= rx_bit + 1'b1;
+        if (rx_bit == 4'd0) begin
+          // A glitch, not a start bit
+          rx_busy <= ~rx_sync[1];
+        end else if (rx_bit <= 4'd8) begin
+          rx_shift <= {rx_sync[1], rx_shift[7:1]};
+        end else begin
+          // Bytes with a framing error are dropped
+          rx_busy   <= 1'b0;
+          rx_strobe <= rx_sync[1];
+        end
+      end
+    end
+  end
+
+  // One byte of buffering: the command logic only takes bytes while it is not waiting on AXI
+  logic       rx_pend;
+  logic [7:0] rx_byte;
+  logic       rx_take;
+  logic       rx_overrun;
+
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      rx_pend <= 1'b0;
+    end else if (rx_strobe) begin
+      rx_pend <= 1'b1;
+    end else if (rx_take) begin
+      rx_pend <= 1'b0;
+    end
+  end
+
+  always_ff @(posedge clk) begin
+    if (rx_strobe) begin
+      rx_byte <= rx_shift;
+    end
+  end
+
+  // --------------------------------------------------------------------------
+  // Transmitter
+  // --------------------------------------------------------------------------
+  logic                tx_start;
+  logic [7:0]          tx_data;
+  logic                tx_busy;
+  logic [DIV_BW_p-1:0] tx_cnt;
+  logic [3:0]          tx_bit;
+  logic [9:0]          tx_shift;
+
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      tx_busy  <= 1'b0;
+      tx_cnt   <= '0;
+      tx_bit   <= '0;
+      tx_shift <= '1;
+    end else if (!tx_busy) begin
+      if (tx_start) begin
+        tx_busy  <= 1'b1;
+        tx_cnt   <= DIV_BW_p'(DIV_p - 1);
+        tx_bit   <= '0;
+        tx_shift <= {1'b1, tx_data, 1'b0};
+      end
+    end else if (tx_cnt != '0) begin
+      tx_cnt <= tx_cnt - 1'b1;
+    end else begin
+      tx_cnt   <= DIV_BW_p'(DIV_p - 1);
+      tx_bit   <= tx_bit + 1'b1;
+      tx_shift <= {1'b1, tx_shift[9:1]};
+      if (tx_bit == 4'd9) begin
+        tx_busy <= 1'b0;
+      end
+    end
+  end
+
+  assign o_tx = tx_shift[0];
+
+  // --------------------------------------------------------------------------
+  // Command decoder and AXI master
+  // --------------------------------------------------------------------------
+  typedef enum logic [3:0] {
+    ST_LOCKED,
+    ST_CMD,
+    ST_HEADER,
+    ST_WDATA,
+    ST_WREQ,
+    ST_WRESP,
+    ST_RREQ,
+    ST_RRESP,
+    ST_RDATA,
+    ST_HALT_ARG,
+    ST_HALT_WAIT,
+    ST_REPLY,
+    ST_CLOSE
+  } state_t;
+
+  state_t              state;
+  state_t              reply_next;
+  logic [7:0]          reply_byte;
+  logic [7:0]          cmd;
+  logic [2:0]          byte_idx;
+  logic [31:0]         addr;
+  logic [7:0]          words_left;
+  logic [31:0]         data;
+  logic                aw_done;
+  logic                w_done;
+  logic                err;
+  logic [TMO_BW_p-1:0] idle_cnt;
+
+  assign rx_take = rx_pend && (state inside {ST_LOCKED, ST_CMD, ST_HEADER, ST_WDATA, ST_HALT_ARG});
+
+  // Status of a finished burst, overruns are sticky for the burst they happened in
+  assign rx_overrun = rx_strobe && rx_pend && !rx_take;
+
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      state      <= ST_LOCKED;
+      reply_next <= ST_CMD;
+      reply_byte <= '0;
+      cmd        <= '0;
+      byte_idx   <= '0;
+      addr       <= '0;
+      words_left <= '0;
+      data       <= '0;
+      aw_done    <= 1'b0;
+      w_done     <= 1'b0;
+      err        <= 1'b0;
+      idle_cnt   <= '0;
+      o_active   <= 1'b0;
+      o_halt_req <= 1'b0;
+      tx_start   <= 1'b0;
+      tx_data    <= '0;
+    end else begin
+      tx_start <= 1'b0;
+      if (rx_overrun) begin
+        err <= 1'b1;
+      end
+
+      // Drop a half-received command when the host went away
+      if (state inside {ST_HEADER, ST_WDATA, ST_HALT_ARG} && !rx_take) begin
+        idle_cnt <= idle_cnt + 1'b1;
+        if (idle_cnt == TMO_BW_p'(TIMEOUT_CYCLES_p)) begin
+          state <= ST_CMD;
+        end
+      end else begin
+        idle_cnt <= '0;
+      end
+
+      unique case (state)
+        ST_LOCKED: begin
+          if (rx_take) begin
+            if (rx_byte == UNLOCK_p[8*byte_idx +: 8]) begin
+              byte_idx <= byte_idx + 1'b1;
+              if (byte_idx == 3'd3) begin
+                byte_idx   <= '0;
+                o_active   <= 1'b1;
+                reply_byte <= "K";
+                reply_next <= ST_CMD;
+                state      <= ST_REPLY;
+              end
+            end else begin
+              byte_idx <= (rx_byte == UNLOCK_p[7:0]) ? 3'd1 : 3'd0;
+            end
+          end
+        end
+
+        ST_CMD: begin
+          if (rx_take) begin
+            cmd        <= rx_byte;
+            byte_idx   <= '0;
+            err        <= 1'b0;
+            reply_byte <= "K";
+            reply_next <= ST_CMD;
+            unique case (rx_byte)
+              "W", "R": state <= ST_HEADER;
+              "H":      state <= ST_HALT_ARG;
+              "S":      state <= ST_REPLY;
+              "Q": begin
+                reply_next <= ST_CLOSE;
+                state      <= ST_REPLY;
+              end
+              default: begin
+                reply_byte <= "?";
+                state      <= ST_REPLY;
+              end
+            endcase
+          end
+        end
+
+        // addr[4] then the word count - 1
+        ST_HEADER: begin
+          if (rx_take) begin
+            byte_idx <= byte_idx + 1'b1;
+            if (byte_idx < 3'd4) begin
+              addr[8*byte_idx[1:0] +: 8] <= rx_byte;
+            end else begin
+              addr[1:0]  <= 2'b00;
+              words_left <= rx_byte;
+              byte_idx   <= '0;
+              state      <= (cmd == "W") ? ST_WDATA : ST_RREQ;
+            end
+          end
+        end
+
+        ST_WDATA: begin
+          if (rx_take) begin
+            data[8*byte_idx[1:0] +: 8] <= rx_byte;
+            byte_idx <= byte_idx + 1'b1;
+            if (byte_idx == 3'd3) begin
+              byte_idx <= '0;
+              aw_done  <= 1'b0;
+              w_done   <= 1'b0;
+              state    <= ST_WREQ;
+            end
+          end
+        end
+
+        ST_WREQ: begin
+          if (i_m_axi_awready) begin
+            aw_done <= 1'b1;
+          end
+          if (i_m_axi_wready) begin
+            w_done <= 1'b1;
+          end
+          if ((aw_done || i_m_axi_awready) && (w_done || i_m_axi_wready)) begin
+            state <= ST_WRESP;
+          end
+        end
+
+        ST_WRESP: begin
+          if (i_m_axi_bvalid) begin
+            err  <= err | (i_m_axi_bresp != RESP_OKAY);
+            addr <= addr + 32'd4;
+            if (words_left == '0) begin
+              reply_byte <= (err || i_m_axi_bresp != RESP_OKAY || rx_overrun) ? "E" : "K";
+              reply_next <= ST_CMD;
+              state      <= ST_REPLY;
+            end else begin
+              words_left <= words_left - 1'b1;
+              state      <= ST_WDATA;
+            end
+          end
+        end
+
+        ST_RREQ: begin
+          if (i_m_axi_arready) begin
+            state <= ST_RRESP;
+          end
+        end
+
+        ST_RRESP: begin
+          if (i_m_axi_rvalid) begin
+            data     <= i_m_axi_rdata;
+            err      <= err | (i_m_axi_rresp != RESP_OKAY);
+            byte_idx <= '0;
+            state    <= ST_RDATA;
+          end
+        end
+
+        ST_RDATA: begin
+          if (!tx_busy && !tx_start) begin
+            tx_data  <= data[8*byte_idx[1:0] +: 8];
+            tx_start <= 1'b1;
+            byte_idx <= byte_idx + 1'b1;
+            if (byte_idx == 3'd3) begin
+              addr <= addr + 32'd4;
+              if (words_left == '0) begin
+                reply_byte <= (err || rx_overrun) ? "E" : "K";
+                reply_next <= ST_CMD;
+                state      <= ST_REPLY;
+              end else begin
+                words_left <= words_left - 1'b1;
+                state      <= ST_RREQ;
+              end
+            end
+          end
+        end
+
+        ST_HALT_ARG: begin
+          if (rx_take) begin
+            o_halt_req <= rx_byte[0];
+            state      <= ST_HALT_WAIT;
+          end
+        end
+
+        ST_HALT_WAIT: begin
+          if (i_halted == o_halt_req) begin
+            state <= ST_REPLY;
+          end
+        end
+
+        ST_REPLY: begin
+          if (!tx_busy && !tx_start) begin
+            tx_data  <= reply_byte;
+            tx_start <= 1'b1;
+            state    <= reply_next;
+          end
+        end
+
+        // Keep the line until the last reply has left
+        ST_CLOSE: begin
+          if (!tx_busy && !tx_start) begin
+            o_active <= 1'b0;
+            state    <= ST_LOCKED;
+          end
+        end
+
+        default: state <= ST_LOCKED;
+      endcase
+    end
+  end
+
+  assign o_m_axi_awaddr  = addr;
+  assign o_m_axi_awprot  = 3'b000;
+  assign o_m_axi_awvalid = (state == ST_WREQ) && !aw_done;
+  assign o_m_axi_wdata   = data;
+  assign o_m_axi_wstrb   = 4'hF;
+  assign o_m_axi_wvalid  = (state == ST_WREQ) && !w_done;
+  assign o_m_axi_bready  = (state == ST_WRESP);
+  assign o_m_axi_araddr  = addr;
+  assign o_m_axi_arprot  = 3'b000;
+  assign o_m_axi_arvalid = (state == ST_RREQ);
+  assign o_m_axi_rready  = (state == ST_RRESP);
+
+endmodule : uart_axi_bridge
@@ -0,0 +1,2 @@
+$UART_AXI_BRIDGE_PROJ_ROOT/rtl/uart_axi_bridge.sv
+$UART_AXI_BRIDGE_PROJ_ROOT/tb/uart_axi_bridge_tb_top.sv
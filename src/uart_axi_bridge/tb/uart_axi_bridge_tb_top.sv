@@ -0,0 +1,358 @@
+module uart_axi_bridge_tb_top ();
+
+  timeunit 1ns;
+  timeprecision 1ps;
+
+  localparam int unsigned CLK_FREQ = 100_000_000;
+  localparam int unsigned BAUD     = 10_000_000;     // 10 clock cycles per bit
+  localparam int unsigned TIMEOUT  = 2000;
+  localparam realtime     BIT      = 100ns;
+  localparam logic [31:0] BAD_ADDR = 32'h0000_5000;  // Slave answers SLVERR
+
+  logic        tb_clk;
+  logic        tb_rst_n;
+  logic        tb_rx;
+  logic        dut_tx;
+  logic        dut_active;
+  logic        dut_halt_req;
+  logic        tb_halted;
+
+  logic [31:0] slv_awaddr;
+  logic [2:0]  slv_awprot;
+  logic        slv_awvalid;
+  logic        slv_awready;
+  logic [31:0] slv_wdata;
+  logic [3:0]  slv_wstrb;
+  logic        slv_wvalid;
+  logic        slv_wready;
+  logic [1:0]  slv_bresp;
+  logic        slv_bvalid;
+  logic        slv_bready;
+  logic [31:0] slv_araddr;
+  logic [2:0]  slv_arprot;
+  logic        slv_arvalid;
+  logic        slv_arready;
+  logic [31:0] slv_rdata;
+  logic [1:0]  slv_rresp;
+  logic        slv_rvalid;
+  logic        slv_rready;
+
+  logic [31:0] slv_mem [logic [31:0]];
+  byte         rx_data[$];
+
+  int errors = 0;
+
+  // Generate clock
+  initial begin
+    tb_clk <= 1'b0;
+    forever #5ns tb_clk <= ~tb_clk;
+  end
+
+  // --------------------------------------------------------------------------
+  // Slave: AW and W in any order, B after a few cycles, reads in two cycles
+  // --------------------------------------------------------------------------
+  initial begin
+    logic [31:0] addr;
+    logic [31:0] data;
+
+    slv_awready <= 1'b0;
+    slv_wready  <= 1'b0;
+    slv_bvalid  <= 1'b0;
+    slv_bresp   <= 2'b00;
+    forever begin
+      fork
+        begin
+          do @(posedge tb_clk); while (!slv_awvalid);
+          // Stall the address channel for a couple of cycles
+          repeat (2) @(posedge tb_clk);
+          slv_awready <= 1'b1;
+          addr = slv_awaddr;
+          @(posedge tb_clk);
+          slv_awready <= 1'b0;
+        end
+        begin
+          do @(posedge tb_clk); while (!slv_wvalid);
+          slv_wready <= 1'b1;
+          data = slv_wdata;
+          if (slv_wstrb != 4'hF) begin
+            $error("Unexpected write strobe %b", slv_wstrb);
+            errors++;
+          end
+          @(posedge tb_clk);
+          slv_wready <= 1'b0;
+        end
+      join
+      if (addr == BAD_ADDR) begin
+        slv_bresp <= 2'b10;
+      end else begin
+        slv_bresp <= 2'b00;
+        slv_mem[addr] = data;
+      end
+      repeat (3) @(posedge tb_clk);
+      slv_bvalid <= 1'b1;
+      do @(posedge tb_clk); while (!slv_bready);
+      slv_bvalid <= 1'b0;
+    end
+  end
+
+  initial begin
+    slv_arready <= 1'b0;
+    slv_rvalid  <= 1'b0;
+    slv_rdata   <= '0;
+    slv_rresp   <= 2'b00;
+    forever begin
+      @(posedge tb_clk);
+      if (slv_arvalid) begin
+        slv_arready <= 1'b1;
+        @(posedge tb_clk);
+        slv_arready <= 1'b0;
+        slv_rvalid  <= 1'b1;
+        slv_rdata   <= slv_mem.exists(slv_araddr) ? slv_mem[slv_araddr] : 32'hDEAD_DEAD;
+        slv_rresp   <= (slv_araddr == BAD_ADDR) ? 2'b10 : 2'b00;
+        do @(posedge tb_clk); while (!slv_rready);
+        slv_rvalid  <= 1'b0;
+      end
+    end
+  end
+
+  // The cores acknowledge a halt request some time later
+  initial begin
+    tb_halted <= 1'b0;
+    forever begin
+      @(dut_halt_req);
+      repeat (20) @(posedge tb_clk);
+      tb_halted <= dut_halt_req;
+    end
+  end
+
+  // --------------------------------------------------------------------------
+  // Serial line
+  // --------------------------------------------------------------------------
+  initial begin
+    logic [7:0] data;
+    forever begin
+      @(negedge dut_tx);
+      #(BIT / 2);
+      for (int i = 0; i < 8; i++) begin
+        #(BIT);
+        data[i] = dut_tx;
+      end
+      #(BIT);
+      if (dut_tx !== 1'b1) begin
+        $error("Invalid stop bit");
+        errors++;
+      end
+      rx_data.push_back(data);
+    end
+  end
+
+  task automatic send_byte(input logic [7:0] data);
+    tb_rx = 1'b0;
+    #(BIT);
+    for (int i = 0; i < 8; i++) begin
+      tb_rx = data[i];
+      #(BIT);
+    end
+    tb_rx = 1'b1;
+    #(BIT);
+  endtask
+
+  task automatic send_word(input logic [31:0] data);
+    for (int i = 0; i < 4; i++) begin
+      send_byte(data[8*i +: 8]);
+    end
+  endtask
+
+  // Wait for nbr reply bytes, returns them in data. Gives up after 200 bit times per byte.
+  task automatic receive(input int nbr, output byte data[$]);
+    data = {};
+    for (int i = 0; i < nbr; i++) begin
+      fork : wait_byte
+        wait (rx_data.size() > 0);
+        #(200 * BIT);
+      join_any
+      disable wait_byte;
+      if (rx_data.size() == 0) begin
+        return;
+      end
+      data.push_back(rx_data.pop_front());
+    end
+  endtask
+
+  task automatic expect_status(input string name, input byte expected);
+    byte data[$];
+    receive(1, data);
+    if (data.size() != 1 || data[0] != expected) begin
+      $error("%s: expected status '%c', got %p", name, expected, data);
+      errors++;
+    end
+  endtask
+
+  task automatic bridge_write(input logic [31:0] addr, input logic [31:0] data[$],
+                              input byte status);
+    send_byte("W");
+    send_word(addr);
+    send_byte(data.size() - 1);
+    foreach (data[i]) begin
+      send_word(data[i]);
+    end
+    expect_status($sformatf("write %08h", addr), status);
+  endtask
+
+  task automatic bridge_read(input logic [31:0] addr, input logic [31:0] expected[$],
+                             input byte status);
+    byte data[$];
+    send_byte("R");
+    send_word(addr);
+    send_byte(expected.size() - 1);
+    receive(4 * expected.size() + 1, data);
+    if (data.size() != 4 * expected.size() + 1) begin
+      $error("read %08h: got %0d bytes, expected %0d", addr, data.size(),
+             4 * expected.size() + 1);
+      errors++;
+      return;
+    end
+    foreach (expected[i]) begin
+      logic [31:0] word = {data[4*i+3], data[4*i+2], data[4*i+1], data[4*i]};
+      if (word !== expected[i]) begin
+        $error("read %08h word %0d: got %08h, expected %08h", addr, i, word, expected[i]);
+        errors++;
+      end
+    end
+    if (data[$] != status) begin
+      $error("read %08h: expected status '%c', got '%c'", addr, status, data[$]);
+      errors++;
+    end
+  endtask
+
+  initial begin
+    byte data[$];
+
+    tb_rst_n <= 1'b0;
+    tb_rx     = 1'b1;
+    repeat (5) @(posedge tb_clk);
+    tb_rst_n <= 1'b1;
+    repeat (5) @(posedge tb_clk);
+
+    // Locked: ordinary traffic is ignored, a partial unlock sequence followed by the full one works
+    send_byte("S");
+    send_byte(8'h1B);
+    send_byte("D");
+    send_byte("x");
+    receive(1, data);
+    if (data.size() != 0 || dut_active) begin
+      $error("Bridge answered while locked");
+      errors++;
+    end
+    send_byte(8'h1B);
+    send_byte(8'h1B);
+    send_byte("D");
+    send_byte("B");
+    send_byte("G");
+    expect_status("unlock", "K");
+    if (!dut_active) begin
+      $error("o_active not set after unlock");
+      errors++;
+    end
+
+    send_byte("S");
+    expect_status("ping", "K");
+    send_byte("x");
+    expect_status("unknown command", "?");
+
+    // Bursts, the low address bits are ignored
+    bridge_write(32'h0000_4000, '{32'h1111_1111, 32'h2222_2222, 32'h3333_3333}, "K");
+    bridge_write(32'h0000_400E, '{32'hCAFE_F00D}, "K");
+    bridge_read(32'h0000_4000, '{32'h1111_1111, 32'h2222_2222, 32'h3333_3333, 32'hCAFE_F00D},
+                "K");
+
+    // Error responses are reported, the burst still completes
+    bridge_write(BAD_ADDR - 4, '{32'h4444_4444, 32'h5555_5555, 32'h6666_6666}, "E");
+    if (slv_mem[BAD_ADDR + 4] !== 32'h6666_6666) begin
+      $error("Write burst stopped at the error");
+      errors++;
+    end
+    bridge_read(BAD_ADDR, '{32'hDEAD_DEAD}, "E");
+    bridge_read(BAD_ADDR - 4, '{32'h4444_4444}, "K");
+
+    // Halt handshake
+    send_byte("H");
+    send_byte(8'h01);
+    expect_status("halt", "K");
+    if (!dut_halt_req || !tb_halted) begin
+      $error("Halt answered before the cores were halted");
+      errors++;
+    end
+    send_byte("H");
+    send_byte(8'h00);
+    expect_status("resume", "K");
+    if (dut_halt_req || tb_halted) begin
+      $error("Resume answered before the cores were released");
+      errors++;
+    end
+
+    // An incomplete command is dropped after the timeout
+    send_byte("W");
+    send_byte(8'h00);
+    send_byte(8'h40);
+    repeat (TIMEOUT + 100) @(posedge tb_clk);
+    send_byte("S");
+    expect_status("ping after timeout", "K");
+
+    // Close the session
+    send_byte("Q");
+    expect_status("close", "K");
+    repeat (20) @(posedge tb_clk);
+    if (dut_active) begin
+      $error("o_active still set after close");
+      errors++;
+    end
+    send_byte("S");
+    receive(1, data);
+    if (data.size() != 0) begin
+      $error("Bridge answered after close");
+      errors++;
+    end
+
+    if (errors == 0) begin
+      $display("PASSED");
+    end else begin
+      $display("FAILED with %0d errors", errors);
+    end
+    $finish;
+  end
+
+  uart_axi_bridge #(
+    .CLK_FREQ_p       ( CLK_FREQ  ),
+    .BAUD_p           ( BAUD      ),
+    .TIMEOUT_CYCLES_p ( TIMEOUT   )
+  ) uart_axi_bridge_dut_i (
+    .clk              ( tb_clk        ),
+    .rst_n            ( tb_rst_n      ),
+    .i_rx             ( tb_rx         ),
+    .o_tx             ( dut_tx        ),
+    .o_active         ( dut_active    ),
+    .o_halt_req       ( dut_halt_req  ),
+    .i_halted         ( tb_halted     ),
+    .o_m_axi_awaddr   ( slv_awaddr    ),
+    .o_m_axi_awprot   ( slv_awprot    ),
+    .o_m_axi_awvalid  ( slv_awvalid   ),
+    .i_m_axi_awready  ( slv_awready   ),
+    .o_m_axi_wdata    ( slv_wdata     ),
+    .o_m_axi_wstrb    ( slv_wstrb     ),
+    .o_m_axi_wvalid   ( slv_wvalid    ),
+    .i_m_axi_wready   ( slv_wready    ),
+    .i_m_axi_bresp    ( slv_bresp     ),
+    .i_m_axi_bvalid   ( slv_bvalid    ),
+    .o_m_axi_bready   ( slv_bready    ),
+    .o_m_axi_araddr   ( slv_araddr    ),
+    .o_m_axi_arprot   ( slv_arprot    ),
+    .o_m_axi_arvalid  ( slv_arvalid   ),
+    .i_m_axi_arready  ( slv_arready   ),
+    .i_m_axi_rdata    ( slv_rdata     ),
+    .i_m_axi_rresp    ( slv_rresp     ),
+    .i_m_axi_rvalid   ( slv_rvalid    ),
+    .o_m_axi_rready   ( slv_rready    )
+  );
+
+endmodule : uart_axi_bridge_tb_top
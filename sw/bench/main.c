@@ -0,0 +1,249 @@
+// main.c - Fixed compute benchmark for comparing PicoRV32 configurations
+//
+// Runs a set of small kernels that stress different parts of the core (shifter, multiplier,
+// divider, branches, load-use, stores) and ends with ebreak. No peripherals are touched except the
+// LEDs, which receive an 8-bit signature of the results at the end: every configuration
+// must produce the same signature. Cycle and instruction counts are reported by the
+// testbench when the core traps.
+#include <stdint.h>
+
+#define LED_BASE             0x00002000
+
+#define CRC_LEN              512
+#define MAT_N                12
+#define SORT_LEN             128
+#define DIV_ITERATIONS       256
+#define BITS_ITERATIONS      512
+#define LIST_LEN             64
+#define LIST_PASSES          16
+#define STORE_WORDS          256
+#define STORE_PASSES         4
+#define MMIO_WRITES          256
+
+static volatile uint32_t *leds = (volatile uint32_t *)LED_BASE;
+
+static uint8_t  crc_buf[CRC_LEN];
+static int32_t  mat_a[MAT_N][MAT_N];
+static int32_t  mat_b[MAT_N][MAT_N];
+static int32_t  mat_c[MAT_N][MAT_N];
+static uint32_t sort_buf[SORT_LEN];
+
+typedef struct node {
+    struct node *next;
+    uint32_t     value;
+} node_t;
+
+static node_t list_nodes[LIST_LEN];
+
+static uint32_t store_buf[STORE_WORDS];
+
+uint32_t *irq(uint32_t *regs, uint32_t irqs)
+{
+    return regs;
+}
+
+static uint32_t lcg(uint32_t *state)
+{
+    *state = *state * 1664525U + 1013904223U;
+    return *state;
+}
+
+/* -------------------------------------------------------------------------- */
+/*  Kernels                                                                   */
+/* -------------------------------------------------------------------------- */
+
+// Bitwise CRC-32: shifts, xor and a data dependent branch per bit
+__attribute__((noinline))
+static uint32_t kernel_crc(void)
+{
+    uint32_t crc = 0xFFFFFFFFU;
+
+    for (int i = 0; i < CRC_LEN; i++) {
+        crc ^= crc_buf[i];
+        for (int b = 0; b < 8; b++) {
+            if (crc & 1)
+                crc = (crc >> 1) ^ 0xEDB88320U;
+            else
+                crc >>= 1;
+        }
+    }
+    return ~crc;
+}
+
+// Integer matrix multiply: MUL throughput and address arithmetic
+__attribute__((noinline))
+static uint32_t kernel_matmul(void)
+{
+    uint32_t sum = 0;
+
+    for (int i = 0; i < MAT_N; i++) {
+        for (int j = 0; j < MAT_N; j++) {
+            int32_t acc = 0;
+            for (int k = 0; k < MAT_N; k++)
+                acc += mat_a[i][k] * mat_b[k][j];
+            mat_c[i][j] = acc;
+            sum += (uint32_t)acc;
+        }
+    }
+    return sum;
+}
+
+// Insertion sort: loads, stores and unpredictable branches
+__attribute__((noinline))
+static uint32_t kernel_sort(void)
+{
+    for (int i = 1; i < SORT_LEN; i++) {
+        uint32_t key = sort_buf[i];
+        int j = i - 1;
+
+        while (j >= 0 && sort_buf[j] > key) {
+            sort_buf[j + 1] = sort_buf[j];
+            j--;
+        }
+        sort_buf[j + 1] = key;
+    }
+    return sort_buf[0] ^ sort_buf[SORT_LEN / 2] ^ sort_buf[SORT_LEN - 1];
+}
+
+// Euclid's GCD and decimal digit sums: DIV/REM latency
+__attribute__((noinline))
+static uint32_t kernel_div(void)
+{
+    uint32_t seed = 0x2545F491U;
+    uint32_t sum = 0;
+
+    for (int i = 0; i < DIV_ITERATIONS; i++) {
+        uint32_t a = lcg(&seed) | 1;
+        uint32_t b = (lcg(&seed) >> 8) | 1;
+
+        while (b) {
+            uint32_t t = a % b;
+            a = b;
+            b = t;
+        }
+        sum += a;
+
+        for (uint32_t v = seed; v; v /= 10)
+            sum += v % 10;
+    }
+    return sum;
+}
+
+// Variable shifts, rotates and popcount: sensitive to the shifter implementation
+__attribute__((noinline))
+static uint32_t kernel_bits(void)
+{
+    uint32_t seed = 0x9E3779B9U;
+    uint32_t acc = 0;
+
+    for (int i = 0; i < BITS_ITERATIONS; i++) {
+        uint32_t v = lcg(&seed);
+        uint32_t n = v >> 27;
+        uint32_t rot = (v << n) | (v >> ((32 - n) & 31));
+        uint32_t pop = 0;
+
+        for (uint32_t x = rot; x; x &= x - 1)
+            pop++;
+        acc = (acc ^ rot) + (pop << (v & 15));
+    }
+    return acc;
+}
+
+// Pointer chasing through a shuffled list: load-use stalls
+__attribute__((noinline))
+static uint32_t kernel_list(void)
+{
+    uint32_t sum = 0;
+
+    for (int pass = 0; pass < LIST_PASSES; pass++) {
+        for (node_t *n = &list_nodes[0]; n; n = n->next)
+            sum += n->value ^ (uint32_t)pass;
+    }
+    return sum;
+}
+
+// Buffer fills and back-to-back peripheral register writes: every store waits for its write
+// response unless the posted-write buffer is enabled. The LEDs are rewritten with their current
+// value so the testbench log stays quiet.
+__attribute__((noinline))
+static uint32_t kernel_store(void)
+{
+    uint32_t led = *leds;
+    uint32_t sum = 0;
+
+    for (int pass = 0; pass < STORE_PASSES; pass++) {
+        uint8_t *bytes = (uint8_t *)store_buf;
+
+        for (int i = 0; i < STORE_WORDS; i++)
+            store_buf[i] = (uint32_t)(i * pass);
+        for (int i = 0; i < STORE_WORDS; i += 4)
+            bytes[i] = (uint8_t)pass;
+    }
+    for (int i = 0; i < MMIO_WRITES; i++)
+        *leds = led;
+
+    for (int i = 0; i < STORE_WORDS; i++)
+        sum = (sum << 1 | sum >> 31) ^ store_buf[i];
+    return sum;
+}
+
+/* -------------------------------------------------------------------------- */
+/*  Setup                                                                     */
+/* -------------------------------------------------------------------------- */
+
+static void bench_init(void)
+{
+    uint32_t seed = 1;
+    uint8_t order[LIST_LEN];
+
+    for (int i = 0; i < CRC_LEN; i++)
+        crc_buf[i] = (uint8_t)lcg(&seed);
+
+    for (int i = 0; i < MAT_N; i++) {
+        for (int j = 0; j < MAT_N; j++) {
+            mat_a[i][j] = (int32_t)(lcg(&seed) >> 20) - 2048;
+            mat_b[i][j] = (int32_t)(lcg(&seed) >> 20) - 2048;
+        }
+    }
+
+    for (int i = 0; i < SORT_LEN; i++)
+        sort_buf[i] = lcg(&seed);
+
+    // Fisher-Yates shuffle of the visiting order, node 0 stays the head
+    for (int i = 0; i < LIST_LEN; i++)
+        order[i] = (uint8_t)i;
+    for (int i = LIST_LEN - 1; i > 1; i--) {
+        int j = 1 + (int)((lcg(&seed) >> 16) % (uint32_t)i);
+        uint8_t t = order[i];
+        order[i] = order[j];
+        order[j] = t;
+    }
+    for (int i = 0; i < LIST_LEN; i++) {
+        list_nodes[order[i]].value = lcg(&seed);
+        list_nodes[order[i]].next = (i + 1 < LIST_LEN) ? &list_nodes[order[i + 1]] : 0;
+    }
+}
+
+int main(void)
+{
+    uint32_t sig = 0;
+
+    bench_init();
+
+    sig ^= kernel_crc();
+    sig = (sig << 5 | sig >> 27) ^ kernel_matmul();
+    sig = (sig << 5 | sig >> 27) ^ kernel_sort();
+    sig = (sig << 5 | sig >> 27) ^ kernel_div();
+    sig = (sig << 5 | sig >> 27) ^ kernel_bits();
+    sig = (sig << 5 | sig >> 27) ^ kernel_list();
+    sig = (sig << 5 | sig >> 27) ^ kernel_store();
+
+    // Fold the signature onto the LEDs, the testbench prints every LED change
+    sig ^= sig >> 16;
+    sig ^= sig >> 8;
+    *leds = sig & 0xFF;
+
+    __asm__ volatile ("ebreak");
+
+    return 0;
+}
@@ -0,0 +1,280 @@
+// main.c - Cycle benchmark of DSP kernels, scalar C against the pcpi_simd co-processor
+#include <stdint.h>
+#include "uart.h"
+#include "fmt.h"
+#include "pcpi_simd.h"
+
+#define UART_BASE_ADDR       0x00003000
+
+#define DOT8_LEN             1024
+#define DOT16_LEN            512
+#define FIR_TAPS             16
+#define FIR_LEN              256
+#define SAT_LEN              512
+
+static uart_t uart0;
+
+/* Lanes are accessed as words by the SIMD kernels, the unions keep that free of aliasing issues */
+static union { int8_t b[DOT8_LEN]; uint32_t w[DOT8_LEN / 4]; } dot8_a, dot8_b;
+static union { int16_t h[DOT16_LEN]; uint32_t w[DOT16_LEN / 2]; } dot16_a, dot16_b;
+static union { int16_t h[FIR_LEN + FIR_TAPS]; uint32_t w[(FIR_LEN + FIR_TAPS) / 2]; } fir_x;
+static union { int16_t h[SAT_LEN]; uint32_t w[SAT_LEN / 2]; } sat_a, sat_b, sat_y0, sat_y1;
+static int16_t fir_y0[FIR_LEN];
+static int16_t fir_y1[FIR_LEN];
+
+/* Q15 low-pass, sum |h| < 1.25 so a 32-bit accumulator cannot overflow */
+static const int16_t fir_h[FIR_TAPS] = {
+    -256, -512, 0, 1024, 2560, 4096, 5376, 6144,
+    6144, 5376, 4096, 2560, 1024, 0, -512, -256
+};
+
+/*
+ * Coefficient pairs for mac16. Even outputs start on a word boundary and use (h0,h1), (h2,h3)...
+ * Odd outputs start one sample early so the loads stay aligned, with the taps moved up by one:
+ * (0,h0), (h1,h2) ... (h15,0).
+ */
+static uint32_t fir_h_even[FIR_TAPS / 2];
+static uint32_t fir_h_odd[FIR_TAPS / 2 + 1];
+
+static volatile uint32_t sink;
+static uint32_t failures;
+static uint32_t seed = 0x9E3779B9U;
+
+/* -------------------------------------------------------------------------- */
+/*  Helpers                                                                   */
+/* -------------------------------------------------------------------------- */
+
+static inline uint32_t rdcycle(void)
+{
+    uint32_t cycles;
+    __asm__ volatile ("rdcycle %0" : "=r"(cycles));
+    return cycles;
+}
+
+uint32_t *irq(uint32_t *regs, uint32_t irqs)
+{
+    return regs;
+}
+
+static uint32_t rand32(void)
+{
+    seed = seed * 1664525U + 1013904223U;
+    return seed;
+}
+
+static int16_t sat16(int32_t v)
+{
+    if (v > 32767)
+        return 32767;
+    if (v < -32768)
+        return -32768;
+    return (int16_t)v;
+}
+
+static void report(const char *name, uint32_t scalar, uint32_t simd, int ok)
+{
+    uint32_t ratio = simd ? (scalar * 100U) / simd : 0;
+
+    if (!ok)
+        failures++;
+    uart_printf(&uart0, "%-26s %9u %9u %5u.%02ux  %s\r\n", name, scalar, simd,
+                ratio / 100, ratio % 100, ok ? "ok" : "MISMATCH");
+}
+
+/* -------------------------------------------------------------------------- */
+/*  Kernels                                                                   */
+/* -------------------------------------------------------------------------- */
+
+__attribute__((noinline))
+static int32_t scalar_dot8(const int8_t *a, const int8_t *b, uint32_t n)
+{
+    int32_t sum = 0;
+
+    for (uint32_t i = 0; i < n; i++)
+        sum += a[i] * b[i];
+    return sum;
+}
+
+__attribute__((noinline))
+static int32_t simd_dot8(const uint32_t *a, const uint32_t *b, uint32_t n)
+{
+    pcpi_accclr();
+    for (uint32_t i = 0; i < n / 4; i++)
+        pcpi_mac8(a[i], b[i]);
+    return pcpi_accrd(0);
+}
+
+__attribute__((noinline))
+static int32_t scalar_dot16(const int16_t *a, const int16_t *b, uint32_t n)
+{
+    int32_t sum = 0;
+
+    for (uint32_t i = 0; i < n; i++)
+        sum += a[i] * b[i];
+    return sum;
+}
+
+__attribute__((noinline))
+static int32_t simd_dot16(const uint32_t *a, const uint32_t *b, uint32_t n)
+{
+    pcpi_accclr();
+    for (uint32_t i = 0; i < n / 2; i++)
+        pcpi_mac16(a[i], b[i]);
+    return pcpi_accrd(0);
+}
+
+__attribute__((noinline))
+static void scalar_fir(int16_t *y, const int16_t *x, const int16_t *h, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        int32_t acc = 0;
+        for (uint32_t k = 0; k < FIR_TAPS; k++)
+            acc += x[i + k] * h[k];
+        y[i] = sat16(acc >> 15);
+    }
+}
+
+__attribute__((noinline))
+static void simd_fir(int16_t *y, const uint32_t *x, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i += 2) {
+        const uint32_t *xw = &x[i / 2];
+
+        pcpi_accclr();
+        for (uint32_t k = 0; k < FIR_TAPS / 2; k++)
+            pcpi_mac16(xw[k], fir_h_even[k]);
+        y[i] = sat16(pcpi_accrd(15));
+
+        pcpi_accclr();
+        for (uint32_t k = 0; k < FIR_TAPS / 2 + 1; k++)
+            pcpi_mac16(xw[k], fir_h_odd[k]);
+        y[i + 1] = sat16(pcpi_accrd(15));
+    }
+}
+
+__attribute__((noinline))
+static void scalar_add_sat16(int16_t *y, const int16_t *a, const int16_t *b, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++)
+        y[i] = sat16(a[i] + b[i]);
+}
+
+__attribute__((noinline))
+static void simd_add_sat16(uint32_t *y, const uint32_t *a, const uint32_t *b, uint32_t n)
+{
+    for (uint32_t i = 0; i < n / 2; i++)
+        y[i] = pcpi_kadd16(a[i], b[i]);
+}
+
+/* -------------------------------------------------------------------------- */
+/*  Benchmarks                                                                */
+/* -------------------------------------------------------------------------- */
+
+static void bench_dot8(void)
+{
+    uint32_t t0, t1, t2;
+    int32_t a, b;
+
+    t0 = rdcycle();
+    a = scalar_dot8(dot8_a.b, dot8_b.b, DOT8_LEN);
+    t1 = rdcycle();
+    b = simd_dot8(dot8_a.w, dot8_b.w, DOT8_LEN);
+    t2 = rdcycle();
+    report("dot product int8 x1024", t1 - t0, t2 - t1, a == b);
+}
+
+static void bench_dot16(void)
+{
+    uint32_t t0, t1, t2;
+    int32_t a, b;
+
+    t0 = rdcycle();
+    a = scalar_dot16(dot16_a.h, dot16_b.h, DOT16_LEN);
+    t1 = rdcycle();
+    b = simd_dot16(dot16_a.w, dot16_b.w, DOT16_LEN);
+    t2 = rdcycle();
+    report("dot product int16 x512", t1 - t0, t2 - t1, a == b);
+}
+
+static void bench_fir(void)
+{
+    uint32_t t0, t1, t2;
+    int ok = 1;
+
+    t0 = rdcycle();
+    scalar_fir(fir_y0, fir_x.h, fir_h, FIR_LEN);
+    t1 = rdcycle();
+    simd_fir(fir_y1, fir_x.w, FIR_LEN);
+    t2 = rdcycle();
+
+    for (uint32_t i = 0; i < FIR_LEN; i++)
+        ok &= fir_y0[i] == fir_y1[i];
+    report("FIR Q15 16 taps x256", t1 - t0, t2 - t1, ok);
+}
+
+static void bench_add_sat16(void)
+{
+    uint32_t t0, t1, t2;
+    int ok = 1;
+
+    t0 = rdcycle();
+    scalar_add_sat16(sat_y0.h, sat_a.h, sat_b.h, SAT_LEN);
+    t1 = rdcycle();
+    simd_add_sat16(sat_y1.w, sat_a.w, sat_b.w, SAT_LEN);
+    t2 = rdcycle();
+
+    for (uint32_t i = 0; i < SAT_LEN; i++)
+        ok &= sat_y0.h[i] == sat_y1.h[i];
+    report("saturating add int16 x512", t1 - t0, t2 - t1, ok);
+}
+
+int main(void) {
+
+    /*
+     * Initialize UART
+     *   8 data bits, 1 stop bit, no parity, 921600 baud rate
+     */
+    uart_init(&uart0, UART_BASE_ADDR);
+    uart_configure(&uart0, UART_CFG_DATA_8 | UART_CFG_BAUD_921600);
+    uart_fifo_clear(&uart0, UART_FIFO_CLEAR_TX | UART_FIFO_CLEAR_RX);
+
+    for (uint32_t i = 0; i < DOT8_LEN; i++) {
+        dot8_a.b[i] = (int8_t)rand32();
+        dot8_b.b[i] = (int8_t)rand32();
+    }
+    for (uint32_t i = 0; i < DOT16_LEN; i++) {
+        /* Keep 512 products inside a 32-bit sum for the scalar reference */
+        dot16_a.h[i] = (int16_t)rand32() >> 5;
+        dot16_b.h[i] = (int16_t)rand32() >> 5;
+    }
+    for (uint32_t i = 0; i < FIR_LEN + FIR_TAPS; i++)
+        fir_x.h[i] = (int16_t)rand32();
+    for (uint32_t i = 0; i < SAT_LEN; i++) {
+        sat_a.h[i] = (int16_t)rand32();
+        sat_b.h[i] = (int16_t)rand32();
+    }
+
+    fir_h_odd[0] = pcpi_pack16(0, fir_h[0]);
+    for (uint32_t k = 0; k < FIR_TAPS / 2; k++) {
+        fir_h_even[k] = pcpi_pack16(fir_h[2 * k], fir_h[2 * k + 1]);
+        if (k > 0)
+            fir_h_odd[k] = pcpi_pack16(fir_h[2 * k - 1], fir_h[2 * k]);
+    }
+    fir_h_odd[FIR_TAPS / 2] = pcpi_pack16(fir_h[FIR_TAPS - 1], 0);
+
+    uart_printf(&uart0, "\r\n%-26s %9s %9s %9s\r\n", "benchmark (cycles)", "scalar", "simd", "speedup");
+    bench_dot8();
+    bench_dot16();
+    bench_fir();
+    bench_add_sat16();
+    uart_printf(&uart0, "%s\r\n", failures ? "FAILED" : "PASSED");
+
+    /* Wait for the TX FIFO to drain so simulation captures the full report */
+    while (!(uart_get_status(&uart0) & UART_STATUS_TX_FIFO_EMPTY))
+        ;
+
+    sink = failures;
+    __asm__ volatile ("ebreak");
+
+    return 0;
+}
@@ -0,0 +1,182 @@
+// main.c - Dual-core example and partitioned workload benchmark
+//
+// Needs the SoC built with ENABLE_DUAL_CORE_p = 1. Core 0 boots through the bootloader as
+// usual, core 1 is released from reset by main() and enters secondary_main() through the jump
+// at 0x4008 (see start.S). Both cores print a greeting under a spinlock, hammer a shared
+// counter to check the lock, and then count primes below PRIME_LIMIT, first on core 0 alone and
+// then split between the two cores. Work is handed out and results returned through the
+// mailboxes. On a single-core build only the single-core part runs.
+#include <stdint.h>
+#include "uart.h"
+#include "fmt.h"
+#include "mailbox.h"
+
+#define UART_BASE_ADDR       0x00003000
+
+#define PRIME_LIMIT          20000
+#define COUNTER_ITERATIONS   1000
+
+// Spinlocks
+#define LOCK_UART            0
+#define LOCK_COUNTER         1
+
+// Commands sent from core 0 to core 1, each followed by one argument word
+#define CMD_COUNTER          1    // arg: iterations, replies with 0 when done
+#define CMD_PRIMES           2    // arg: limit, replies with the prime count of its share
+
+static uart_t uart0;
+
+static volatile uint32_t shared_counter;
+
+/* -------------------------------------------------------------------------- */
+/*  Helpers                                                                   */
+/* -------------------------------------------------------------------------- */
+
+static inline uint32_t rdcycle(void)
+{
+    uint32_t cycles;
+    __asm__ volatile ("rdcycle %0" : "=r"(cycles));
+    return cycles;
+}
+
+uint32_t *irq(uint32_t *regs, uint32_t irqs)
+{
+    return regs;
+}
+
+static void hello(void)
+{
+    spin_lock(LOCK_UART);
+    uart_printf(&uart0, "Hello from core %u of %u\r\n", core_id(), core_count());
+    spin_unlock(LOCK_UART);
+}
+
+static void counter_run(uint32_t iterations)
+{
+    for (uint32_t i = 0; i < iterations; i++) {
+        spin_lock(LOCK_COUNTER);
+        shared_counter = shared_counter + 1;
+        spin_unlock(LOCK_COUNTER);
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+/*  Workload                                                                  */
+/* -------------------------------------------------------------------------- */
+
+static int is_prime(uint32_t n)
+{
+    for (uint32_t d = 3; d * d <= n; d += 2) {
+        if (n % d == 0)
+            return 0;
+    }
+    return 1;
+}
+
+// Count primes among the odd numbers first, first + step, ... below limit. Splitting the odd
+// numbers by n % 4 gives both cores a near equal share of the work.
+__attribute__((noinline))
+static uint32_t count_primes(uint32_t limit, uint32_t first, uint32_t step)
+{
+    uint32_t count = 0;
+
+    for (uint32_t n = first; n < limit; n += step)
+        count += is_prime(n);
+    return count;
+}
+
+/* -------------------------------------------------------------------------- */
+/*  Core 1                                                                    */
+/* -------------------------------------------------------------------------- */
+
+void secondary_main(void)
+{
+    hello();
+
+    for (;;) {
+        uint32_t cmd = mbox_recv();
+        uint32_t arg = mbox_recv();
+
+        switch (cmd) {
+        case CMD_COUNTER:
+            counter_run(arg);
+            mbox_send(0, 0);
+            break;
+        case CMD_PRIMES:
+            mbox_send(0, count_primes(arg, 5, 4));
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+/*  Core 0                                                                    */
+/* -------------------------------------------------------------------------- */
+
+int main(void) {
+    uint32_t cores;
+    uint32_t t0, t1;
+    uint32_t single, dual;
+    uint32_t single_cycles, dual_cycles;
+
+    /*
+     * Initialize UART
+     *   8 data bits, 1 stop bit, no parity, 921600 baud rate
+     */
+    uart_init(&uart0, UART_BASE_ADDR);
+    uart_configure(&uart0, UART_CFG_DATA_8 | UART_CFG_BAUD_921600);
+    uart_fifo_clear(&uart0, UART_FIFO_CLEAR_TX | UART_FIFO_CLEAR_RX);
+
+    cores = core_count();
+    if (cores > 1)
+        core_release(1);
+    hello();
+
+    // Shared counter under a spinlock, both cores increment concurrently
+    if (cores > 1) {
+        mbox_send(1, CMD_COUNTER);
+        mbox_send(1, COUNTER_ITERATIONS);
+    }
+    counter_run(COUNTER_ITERATIONS);
+    if (cores > 1)
+        mbox_recv();
+
+    spin_lock(LOCK_UART);
+    uart_printf(&uart0, "Shared counter: %u (expected %u) %s\r\n", shared_counter,
+                cores * COUNTER_ITERATIONS,
+                shared_counter == cores * COUNTER_ITERATIONS ? "ok" : "MISMATCH");
+    spin_unlock(LOCK_UART);
+
+    // Prime count below PRIME_LIMIT, 2 is counted separately
+    t0 = rdcycle();
+    single = 1 + count_primes(PRIME_LIMIT, 3, 2);
+    t1 = rdcycle();
+    single_cycles = t1 - t0;
+
+    uart_printf(&uart0, "\r\nprimes < %u\r\n", PRIME_LIMIT);
+    uart_printf(&uart0, "1 core:  %u primes, %u cycles\r\n", single, single_cycles);
+
+    if (cores > 1) {
+        t0 = rdcycle();
+        mbox_send(1, CMD_PRIMES);
+        mbox_send(1, PRIME_LIMIT);
+        dual = 1 + count_primes(PRIME_LIMIT, 3, 4);
+        dual += mbox_recv();
+        t1 = rdcycle();
+        dual_cycles = t1 - t0;
+
+        uint32_t ratio = dual_cycles ? (single_cycles * 100U) / dual_cycles : 0;
+        uart_printf(&uart0, "2 cores: %u primes, %u cycles, speedup %u.%02ux %s\r\n", dual,
+                    dual_cycles, ratio / 100, ratio % 100, dual == single ? "ok" : "MISMATCH");
+    }
+
+    /* Wait for the TX FIFO to drain so simulation captures the full report */
+    while (!(uart_get_status(&uart0) & UART_STATUS_TX_FIFO_EMPTY))
+        ;
+
+    __asm__ volatile ("ebreak");
+
+    return 0;
+}
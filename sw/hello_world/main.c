@@ -3,25 +3,49 @@
 #include "uart.h"
 #include "irq.h"
 #include "timer.h"
+#include "gpio.h"
+#ifdef PROFILE
+#include "profiler.h"
+#endif
 
-#define LED_BASE             0x00002000
 #define UART_BASE_ADDR       0x00003000
 #define TIMER_BASE_ADDR      0x00001000
 
 uint32_t const one_second_prescaler = 9999;
 uint32_t const one_second_timer     = 9999;
 
-volatile uint32_t *leds = (volatile uint32_t *)LED_BASE;
-volatile uint32_t *text = (volatile uint32_t *)(LED_BASE + 4);
+// Lit LED, kept in software so the rotation is a single store to OUT_TGL
+static uint32_t led_state = 0x1;
+// Non-zero while the lit LED is driven by its PWM channel
+static int dimmed;
 
 static uart_t uart0;
 static timer_t timer0;
 
 uint32_t *irq(uint32_t *regs, uint32_t irqs)
 {
+#ifdef PROFILE
+  // PicoRV32 timer interrupt drives the PC sampler
+  if (irqs & PROFILER_IRQ_MASK) {
+    profiler_sample(regs);
+  }
+#endif
+
   // Timer interrupt
   if (timer_get_status(&timer0)) {
-    *leds = (*leds << 1) | ((*leds & (1 << 7)) >> 7);
+    uint32_t next = ((led_state << 1) | (led_state >> 7)) & 0xFF;
+    gpio_toggle(led_state ^ next);
+    led_state = next;
+    if (dimmed)
+      gpio_pwm_enable(led_state);
+  }
+
+  // BTNC toggles PWM dimming of the lit LED
+  if (irqs & (1 << GPIO_IRQ)) {
+    if (gpio_irq_ack() & GPIO_BTNC) {
+      dimmed = !dimmed;
+      gpio_pwm_enable(dimmed ? led_state : 0);
+    }
   }
 
   return regs;
@@ -29,14 +53,20 @@ uint32_t *irq(uint32_t *regs, uint32_t irqs)
 
 int main(void) {
 
-  // Enable timer interrupt
-  irq_setmask(~(1 << 2));
+  // Enable timer and GPIO interrupts
+  irq_setmask(~((1 << 2) | (1 << GPIO_IRQ)));
 
   // Global interrupt enable
   irq_setie(0x1);
 
   // Initialize a single LED
-  *leds = 0x1;
+  gpio_write(led_state);
+
+  // PWM at 100 MHz / (100 * 256) ~ 3.9 kHz, 1/8 brightness when dimmed
+  gpio_pwm_config(99, 255);
+  for (uint32_t n = 0; n < 8; n++)
+    gpio_pwm_duty(n, 32);
+  gpio_irq_enable(GPIO_BTNC, 0);
   
   /*
      * 1-second tick @ 100 MHz:
@@ -56,11 +86,23 @@ int main(void) {
   uart_fifo_clear(&uart0, UART_FIFO_CLEAR_TX | UART_FIFO_CLEAR_RX);
   uart_write(&uart0, (const uint8_t *)"UART initialized!\r\n", 19);
 
+#ifdef PROFILE
+  profiler_start(0);
+
+  /* Echo loop, flushing profiler samples while waiting for input */
+  while (1) {
+    uint8_t c;
+    profiler_poll(&uart0);
+    if (uart_trygetc(&uart0, &c))
+      uart_putc(&uart0, c);
+  }
+#else
   /* Echo loop */
   while (1) {
     uint8_t c = uart_getc(&uart0);
     uart_putc(&uart0, c);
   }
+#endif
 
   __asm__ volatile ("ebreak");
 
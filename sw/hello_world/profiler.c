@@ -0,0 +1,110 @@
+#include "profiler.h"
+#include "irq.h"
+
+/* Provided by start.S */
+extern void _set_picorv32_timer(uint32_t cycles);
+
+/* -------------------------------------------------------------------------- */
+/*  Sample ring — written by the IRQ handler, drained by profiler_poll()      */
+/* -------------------------------------------------------------------------- */
+
+static volatile uint32_t ring_pc[PROFILER_RING_SIZE];
+static volatile uint32_t ring_ra[PROFILER_RING_SIZE];
+static volatile uint32_t ring_head;
+static volatile uint32_t ring_tail;
+static volatile uint32_t dropped;
+static uint32_t dropped_reported;
+static volatile uint32_t period_cycles;
+
+/* -------------------------------------------------------------------------- */
+/*  Private helpers                                                           */
+/* -------------------------------------------------------------------------- */
+
+static uint8_t *put_varint(uint8_t *p, int32_t delta)
+{
+    uint32_t v = ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31);
+
+    while (v >= 0x80) {
+        *p++ = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    *p++ = (uint8_t)v;
+    return p;
+}
+
+/* -------------------------------------------------------------------------- */
+/*  Public API                                                                */
+/* -------------------------------------------------------------------------- */
+
+void profiler_start(uint32_t period)
+{
+    period_cycles = period ? period : PROFILER_DEFAULT_PERIOD;
+    irq_setmask(irq_getmask() & ~PROFILER_IRQ_MASK);
+    _set_picorv32_timer(period_cycles);
+}
+
+void profiler_stop(void)
+{
+    period_cycles = 0;
+    _set_picorv32_timer(0);
+    irq_setmask(irq_getmask() | PROFILER_IRQ_MASK);
+}
+
+void profiler_sample(const uint32_t *regs)
+{
+    uint32_t head = ring_head;
+    uint32_t next = (head + 1) % PROFILER_RING_SIZE;
+
+    if (next == ring_tail) {
+        dropped++;
+    } else {
+        ring_pc[head] = regs[0] & ~1U;
+        ring_ra[head] = regs[1];
+        ring_head = next;
+    }
+
+    /* The PicoRV32 timer is one-shot, re-arm it for the next sample */
+    if (period_cycles)
+        _set_picorv32_timer(period_cycles);
+}
+
+uint32_t profiler_poll(uart_t *dev)
+{
+    /* Header + worst case of two 5-byte varints per sample + checksum */
+    uint8_t frame[5 + PROFILER_BATCH_SIZE * 10 + 1];
+    uint8_t *p = &frame[5];
+    uint32_t prev_pc = 0;
+    uint32_t prev_ra = 0;
+    uint32_t count = 0;
+    uint32_t tail = ring_tail;
+    uint32_t head = ring_head;
+    uint32_t lost = dropped - dropped_reported;
+
+    if (tail == head && lost == 0)
+        return 0;
+
+    while (tail != head && count < PROFILER_BATCH_SIZE) {
+        p = put_varint(p, (int32_t)(ring_pc[tail] - prev_pc));
+        p = put_varint(p, (int32_t)(ring_ra[tail] - prev_ra));
+        prev_pc = ring_pc[tail];
+        prev_ra = ring_ra[tail];
+        tail = (tail + 1) % PROFILER_RING_SIZE;
+        count++;
+    }
+    ring_tail = tail;
+    dropped_reported += lost;
+
+    frame[0] = PROFILER_SYNC0;
+    frame[1] = PROFILER_SYNC1;
+    frame[2] = (uint8_t)count;
+    frame[3] = (uint8_t)(lost > 0xFF ? 0xFF : lost);
+    frame[4] = (uint8_t)(p - &frame[5]);
+
+    uint8_t sum = 0;
+    for (uint8_t *q = &frame[2]; q < p; q++)
+        sum += *q;
+    *p++ = sum;
+
+    uart_write(dev, frame, (size_t)(p - frame));
+    return count;
+}
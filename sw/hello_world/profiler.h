@@ -0,0 +1,63 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdint.h>
+#include "uart.h"
+
+/* -------------------------------------------------------------------------- */
+/*  Configuration                                                             */
+/* -------------------------------------------------------------------------- */
+
+/* PicoRV32 IRQ line used by the built-in timer instruction */
+#define PROFILER_IRQ                0
+#define PROFILER_IRQ_MASK           (1U << PROFILER_IRQ)
+
+/* Number of samples buffered between the IRQ handler and profiler_poll() */
+#define PROFILER_RING_SIZE          64
+
+/* Maximum number of samples emitted in a single frame */
+#define PROFILER_BATCH_SIZE         16
+
+/* Default sampling period in CPU cycles (prime, to avoid aliasing with loops) */
+#define PROFILER_DEFAULT_PERIOD     10007
+
+/* -------------------------------------------------------------------------- */
+/*  Frame format (all multi-byte fields little-endian)                        */
+/*                                                                            */
+/*    0xA5 'P' | count | dropped | len | payload[len] | checksum              */
+/*                                                                            */
+/*  payload  : count x { zigzag-varint(pc - prev_pc), zigzag-varint(ra -      */
+/*             prev_ra) }, prev_* start from 0 in every frame                 */
+/*  dropped  : samples lost to ring overflow since the previous frame         */
+/*  checksum : 8-bit sum of count, dropped, len and payload bytes             */
+/* -------------------------------------------------------------------------- */
+#define PROFILER_SYNC0              0xA5
+#define PROFILER_SYNC1              'P'
+
+/* -------------------------------------------------------------------------- */
+/*  API                                                                       */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * Arm the PicoRV32 timer and unmask PROFILER_IRQ.
+ * @param period  Sampling period in CPU cycles (0 selects the default).
+ */
+void profiler_start(uint32_t period);
+
+/** Stop sampling. Samples already buffered can still be flushed. */
+void profiler_stop(void);
+
+/**
+ * Record one sample. Call from irq() when PROFILER_IRQ_MASK is set in irqs.
+ * regs is the irq_regs array from start.S: regs[0] holds the interrupted PC
+ * (q0) and regs[1] holds the interrupted return address (x1).
+ */
+void profiler_sample(const uint32_t *regs);
+
+/**
+ * Emit at most one frame of buffered samples over the UART.
+ * Call from the main loop. Returns the number of samples sent.
+ */
+uint32_t profiler_poll(uart_t *dev);
+
+#endif /* PROFILER_H */
@@ -3,16 +3,16 @@
 #include "uart.h"
 #include "irq.h"
 #include "timer.h"
+#include "gpio.h"
 
-#define LED_BASE             0x00002000
 #define UART_BASE_ADDR       0x00003000
 #define TIMER_BASE_ADDR      0x00001000
 
 uint32_t const one_second_prescaler = 0;
 uint32_t const one_second_timer     = 999;
 
-volatile uint32_t *leds = (volatile uint32_t *)LED_BASE;
-volatile uint32_t *text = (volatile uint32_t *)(LED_BASE + 4);
+// Lit LED, kept in software so the rotation is a single store to OUT_TGL
+static uint32_t led_state = 0x1;
 volatile uint32_t irq_count = 0;
 
 static uart_t uart0;
@@ -22,7 +22,9 @@ uint32_t *irq(uint32_t *regs, uint32_t irqs)
 {
   // Timer interrupt
   if (timer_get_status(&timer0)) {
-    *leds = (*leds << 1) | ((*leds & (1 << 7)) >> 7);
+    uint32_t next = ((led_state << 1) | (led_state >> 7)) & 0xFF;
+    gpio_toggle(led_state ^ next);
+    led_state = next;
     irq_count++;
   }
 
@@ -42,7 +44,7 @@ int main(void) {
   irq_setie(0x1);
 
   // Initialize a single LED
-  *leds = 0x1;
+  gpio_write(led_state);
   
   /*
      * 1-second tick @ 100 MHz:
@@ -0,0 +1,99 @@
+// main.c - Execute-in-place example
+//
+// Runs from the QSPI flash image at 0x01C00000 (see picorv32.ld). Prints where it is running
+// from and times the same checksum loop fetched from flash and from SRAM (.ramtext), which
+// shows the cost of line fills in the XIP cache versus single cycle SRAM fetches.
+#include <stdint.h>
+#include "uart.h"
+#include "fmt.h"
+
+#define LED_BASE             0x00002000
+#define UART_BASE_ADDR       0x00003000
+
+#define BUF_WORDS            1024
+#define RUNS                 4
+
+static uart_t uart0;
+
+static uint32_t buf[BUF_WORDS];
+
+static inline uint32_t rdcycle(void)
+{
+    uint32_t cycles;
+    __asm__ volatile ("rdcycle %0" : "=r"(cycles));
+    return cycles;
+}
+
+uint32_t *irq(uint32_t *regs, uint32_t irqs)
+{
+    return regs;
+}
+
+// Same body for both copies so only the fetch location differs
+static inline __attribute__((always_inline))
+uint32_t checksum_body(const uint32_t *p, uint32_t n)
+{
+    uint32_t sum = 0;
+
+    for (uint32_t i = 0; i < n; i++)
+        sum = ((sum << 5) | (sum >> 27)) ^ p[i];
+    return sum;
+}
+
+__attribute__((noinline))
+static uint32_t checksum_flash(const uint32_t *p, uint32_t n)
+{
+    return checksum_body(p, n);
+}
+
+__attribute__((noinline, section(".ramtext")))
+static uint32_t checksum_sram(const uint32_t *p, uint32_t n)
+{
+    return checksum_body(p, n);
+}
+
+int main(void) {
+    uint32_t t0, t1;
+    uint32_t sum_flash = 0, sum_sram = 0;
+    uint32_t cycles_flash, cycles_sram;
+
+    *(volatile uint32_t *)LED_BASE = 0x81;
+
+    /*
+     * Initialize UART
+     *   8 data bits, 1 stop bit, no parity, 921600 baud rate
+     */
+    uart_init(&uart0, UART_BASE_ADDR);
+    uart_configure(&uart0, UART_CFG_DATA_8 | UART_CFG_BAUD_921600);
+    uart_fifo_clear(&uart0, UART_FIFO_CLEAR_TX | UART_FIFO_CLEAR_RX);
+
+    uart_printf(&uart0, "Hello from flash! main at %p, checksum_sram at %p\r\n",
+                (void *)main, (void *)checksum_sram);
+
+    for (uint32_t i = 0; i < BUF_WORDS; i++)
+        buf[i] = i * 0x9E3779B9U;
+
+    t0 = rdcycle();
+    for (int r = 0; r < RUNS; r++)
+        sum_flash += checksum_flash(buf, BUF_WORDS);
+    t1 = rdcycle();
+    cycles_flash = t1 - t0;
+
+    t0 = rdcycle();
+    for (int r = 0; r < RUNS; r++)
+        sum_sram += checksum_sram(buf, BUF_WORDS);
+    t1 = rdcycle();
+    cycles_sram = t1 - t0;
+
+    uart_printf(&uart0, "checksum from flash: %08x, %u cycles\r\n", sum_flash, cycles_flash);
+    uart_printf(&uart0, "checksum from SRAM:  %08x, %u cycles %s\r\n", sum_sram, cycles_sram,
+                sum_flash == sum_sram ? "ok" : "MISMATCH");
+
+    /* Wait for the TX FIFO to drain so simulation captures the full report */
+    while (!(uart_get_status(&uart0) & UART_STATUS_TX_FIFO_EMPTY))
+        ;
+
+    __asm__ volatile ("ebreak");
+
+    return 0;
+}
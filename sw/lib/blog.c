@@ -0,0 +1,48 @@
+#include "blog.h"
+
+/* -------------------------------------------------------------------------- */
+/*  Private helpers                                                           */
+/* -------------------------------------------------------------------------- */
+
+static uint8_t *put_varint(uint8_t *p, uint32_t value)
+{
+    uint32_t v = (value << 1) ^ (uint32_t)((int32_t)value >> 31);
+
+    while (v >= 0x80) {
+        *p++ = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    *p++ = (uint8_t)v;
+    return p;
+}
+
+/* -------------------------------------------------------------------------- */
+/*  Public API                                                                */
+/* -------------------------------------------------------------------------- */
+
+uint32_t blog_write(uart_t *dev, uint32_t id, const uint32_t *args, uint32_t nargs)
+{
+    /* Header + worst case of a 5-byte varint for the ID and each argument + checksum */
+    uint8_t frame[3 + (1 + BLOG_MAX_ARGS) * 5 + 1];
+    uint8_t *p = &frame[3];
+    uint8_t sum;
+
+    if (nargs > BLOG_MAX_ARGS)
+        nargs = BLOG_MAX_ARGS;
+
+    p = put_varint(p, id);
+    for (uint32_t i = 0; i < nargs; i++)
+        p = put_varint(p, args[i]);
+
+    frame[0] = BLOG_SYNC0;
+    frame[1] = BLOG_SYNC1;
+    frame[2] = (uint8_t)(p - &frame[3]);
+
+    sum = 0;
+    for (uint8_t *q = &frame[2]; q < p; q++)
+        sum += *q;
+    *p++ = sum;
+
+    uart_write(dev, frame, (size_t)(p - frame));
+    return (uint32_t)(p - frame);
+}
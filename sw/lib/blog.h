@@ -0,0 +1,64 @@
+#ifndef BLOG_H
+#define BLOG_H
+
+#include <stdint.h>
+#include "uart.h"
+
+/* -------------------------------------------------------------------------- */
+/*  Deferred-format binary logging                                            */
+/*                                                                            */
+/*  BLOG(dev, "fmt", args...) sends the address of the format string and the  */
+/*  raw argument words instead of formatted text. The strings live in the     */
+/*  .blog section, which the linker script keeps out of the image:            */
+/*                                                                            */
+/*      .blog 0 (INFO) : { KEEP(*(.blog*)) }                                  */
+/*                                                                            */
+/*  so the string ID is its offset in .blog. sw/tools/blog_decode.py reads    */
+/*  the strings back from firmware.elf and formats on the host. Conversions   */
+/*  are those of uart_printf() except %s: arguments are 32-bit words, cast    */
+/*  pointers to uint32_t. The format is still checked by the compiler.        */
+/*                                                                            */
+/*  Frames share the UART with plain text, the decoder passes that through:   */
+/*                                                                            */
+/*    0xA5 'L' | len | payload[len] | checksum                                */
+/*                                                                            */
+/*  payload  : zigzag-varint(id), then zigzag-varint(arg) per argument        */
+/*  checksum : 8-bit sum of len and payload bytes                             */
+/* -------------------------------------------------------------------------- */
+#define BLOG_SYNC0                  0xA5
+#define BLOG_SYNC1                  'L'
+
+/* Arguments per message */
+#define BLOG_MAX_ARGS               8
+
+/**
+ * Log a message and evaluate to the number of bytes sent. Expands to a static format string in
+ * .blog and a blog_write() call, a message with a few small arguments is 5-15 bytes on the wire.
+ */
+#define BLOG(dev, fmt, ...)                                                         \
+    ({                                                                              \
+        static const char blog_fmt_[] __attribute__((section(".blog"), used)) = fmt; \
+        const uint32_t blog_args_[] = { 0, ##__VA_ARGS__ };                         \
+        _Static_assert(sizeof(blog_args_) / sizeof(uint32_t) - 1 <= BLOG_MAX_ARGS,  \
+                       "too many BLOG arguments");                                  \
+        if (0)                                                                      \
+            blog_check_format(fmt, ##__VA_ARGS__);                                  \
+        blog_write((dev), (uint32_t)(uintptr_t)blog_fmt_, &blog_args_[1],           \
+                   sizeof(blog_args_) / sizeof(uint32_t) - 1);                      \
+    })
+
+/**
+ * Send one frame (blocking, like uart_write()). Frames are built on the stack and sent with a
+ * single uart_write(), so logging from an IRQ handler only needs the caller to keep the main
+ * loop from writing the same UART at the same time. Returns the number of bytes sent.
+ */
+uint32_t blog_write(uart_t *dev, uint32_t id, const uint32_t *args, uint32_t nargs);
+
+/* Never called, lets the compiler check BLOG() arguments against the format */
+static inline __attribute__((format(printf, 1, 2)))
+void blog_check_format(const char *fmt, ...)
+{
+    (void)fmt;
+}
+
+#endif /* BLOG_H */
@@ -0,0 +1,33 @@
+#ifndef CRC_H
+#define CRC_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* -------------------------------------------------------------------------- */
+/*  CRC-32 (IEEE 802.3, reflected polynomial 0xEDB88320)                      */
+/*  Same result as zlib.crc32() / binascii.crc32() on the host.               */
+/*  Build with -DHAVE_PCPI_CRC to use the pcpi_crc instructions instead of    */
+/*  the lookup table (requires ENABLE_PCPI_CRC_p in the SoC).                 */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * Update a raw CRC-32 state (no pre/post inversion). Use this to checksum
+ * data that arrives in pieces: start from 0xFFFFFFFF and invert the result.
+ */
+uint32_t crc32_update(uint32_t crc, const void *data, size_t len);
+
+/** One-shot CRC-32 of a buffer. */
+uint32_t crc32(const void *data, size_t len);
+
+/* -------------------------------------------------------------------------- */
+/*  CRC-16/CCITT-FALSE (polynomial 0x1021, init 0xFFFF, not reflected)        */
+/* -------------------------------------------------------------------------- */
+
+/** Update a CRC-16/CCITT state. */
+uint16_t crc16_ccitt_update(uint16_t crc, const void *data, size_t len);
+
+/** One-shot CRC-16/CCITT-FALSE of a buffer. */
+uint16_t crc16_ccitt(const void *data, size_t len);
+
+#endif /* CRC_H */
@@ -0,0 +1,188 @@
+#include "fmt.h"
+
+/* -------------------------------------------------------------------------- */
+/*  Private helpers                                                           */
+/* -------------------------------------------------------------------------- */
+
+typedef struct {
+    uart_t *dev;
+    int     len;
+    int     total;
+    uint8_t buf[FMT_BUF_SIZE];
+} fmt_sink_t;
+
+static void sink_flush(fmt_sink_t *s)
+{
+    if (s->len) {
+        uart_write(s->dev, s->buf, (size_t)s->len);
+        s->total += s->len;
+        s->len = 0;
+    }
+}
+
+static inline void sink_put(fmt_sink_t *s, char c)
+{
+    if (s->len == FMT_BUF_SIZE)
+        sink_flush(s);
+    s->buf[s->len++] = (uint8_t)c;
+}
+
+static void sink_pad(fmt_sink_t *s, char c, int count)
+{
+    while (count-- > 0)
+        sink_put(s, c);
+}
+
+/* x / 10 for any 32-bit x: 0xCCCCCCCD / 2^35 rounds up 1/10 closely enough */
+static inline uint32_t div10(uint32_t x)
+{
+    return (uint32_t)(((uint64_t)x * 0xCCCCCCCDU) >> 35);
+}
+
+static int fmt_xtoa(char *buf, uint32_t value, int upper)
+{
+    const char *digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    int n = 0;
+    char tmp[8];
+
+    do {
+        tmp[n++] = digits[value & 0xF];
+        value >>= 4;
+    } while (value);
+
+    for (int i = 0; i < n; i++)
+        buf[i] = tmp[n - 1 - i];
+    return n;
+}
+
+/* -------------------------------------------------------------------------- */
+/*  Public API                                                                */
+/* -------------------------------------------------------------------------- */
+
+int fmt_utoa(char *buf, uint32_t value)
+{
+    char tmp[10];
+    int n = 0;
+
+    do {
+        uint32_t q = div10(value);
+        tmp[n++] = (char)('0' + (value - q * 10));
+        value = q;
+    } while (value);
+
+    for (int i = 0; i < n; i++)
+        buf[i] = tmp[n - 1 - i];
+    return n;
+}
+
+int uart_vprintf(uart_t *dev, const char *fmt, va_list ap)
+{
+    fmt_sink_t s;
+
+    s.dev = dev;
+    s.len = 0;
+    s.total = 0;
+
+    for (; *fmt; fmt++) {
+        if (*fmt != '%') {
+            sink_put(&s, *fmt);
+            continue;
+        }
+
+        int left = 0;
+        char pad = ' ';
+        int width = 0;
+
+        fmt++;
+        for (;; fmt++) {
+            if (*fmt == '-')
+                left = 1;
+            else if (*fmt == '0')
+                pad = '0';
+            else
+                break;
+        }
+        while (*fmt >= '0' && *fmt <= '9')
+            width = width * 10 + (*fmt++ - '0');
+        while (*fmt == 'l')
+            fmt++;
+
+        char num[12];
+        const char *str = num;
+        int len = 0;
+        int neg = 0;
+
+        switch (*fmt) {
+        case 'd':
+        case 'i': {
+            int32_t v = va_arg(ap, int32_t);
+            neg = v < 0;
+            len = fmt_utoa(num, neg ? -(uint32_t)v : (uint32_t)v);
+            break;
+        }
+        case 'u':
+            len = fmt_utoa(num, va_arg(ap, uint32_t));
+            break;
+        case 'x':
+        case 'X':
+            len = fmt_xtoa(num, va_arg(ap, uint32_t), *fmt == 'X');
+            break;
+        case 'p':
+            len = fmt_xtoa(num + 2, (uint32_t)(uintptr_t)va_arg(ap, void *), 0) + 2;
+            num[0] = '0';
+            num[1] = 'x';
+            break;
+        case 'c':
+            num[0] = (char)va_arg(ap, int);
+            len = 1;
+            break;
+        case 's':
+            str = va_arg(ap, const char *);
+            if (!str)
+                str = "(null)";
+            while (str[len])
+                len++;
+            break;
+        case '%':
+            num[0] = '%';
+            len = 1;
+            break;
+        case '\0':
+            fmt--;
+            continue;
+        default:
+            /* Unknown conversion, print it verbatim */
+            num[0] = '%';
+            num[1] = *fmt;
+            len = 2;
+            break;
+        }
+
+        int fill = width - len - neg;
+
+        if (neg && pad == '0')
+            sink_put(&s, '-');
+        if (!left)
+            sink_pad(&s, pad, fill);
+        if (neg && pad != '0')
+            sink_put(&s, '-');
+        for (int i = 0; i < len; i++)
+            sink_put(&s, str[i]);
+        if (left)
+            sink_pad(&s, ' ', fill);
+    }
+
+    sink_flush(&s);
+    return s.total;
+}
+
+int uart_printf(uart_t *dev, const char *fmt, ...)
+{
+    va_list ap;
+    int n;
+
+    va_start(ap, fmt);
+    n = uart_vprintf(dev, fmt, ap);
+    va_end(ap);
+    return n;
+}
@@ -0,0 +1,36 @@
+#ifndef FMT_H
+#define FMT_H
+
+#include <stdint.h>
+#include <stdarg.h>
+#include "uart.h"
+
+/* -------------------------------------------------------------------------- */
+/*  Minimal printf for the UART driver                                        */
+/*                                                                            */
+/*  Supported conversions: %d %i %u %x %X %p %c %s %%                         */
+/*  Supported modifiers  : '-' (left align), '0' (zero pad), field width,     */
+/*                         'l' (accepted and ignored, long is 32-bit)         */
+/*                                                                            */
+/*  Output is staged in a small stack buffer and handed to uart_write() in    */
+/*  chunks. Decimal conversion divides by 10 with a reciprocal multiply       */
+/*  (MULHU), avoiding the multi-cycle PicoRV32 divider.                       */
+/* -------------------------------------------------------------------------- */
+
+/** Size of the on-stack staging buffer used by uart_printf(). */
+#define FMT_BUF_SIZE 64
+
+/** Format and transmit (blocking). Returns the number of bytes sent. */
+int uart_printf(uart_t *dev, const char *fmt, ...)
+    __attribute__((format(printf, 2, 3)));
+
+/** va_list variant of uart_printf(). */
+int uart_vprintf(uart_t *dev, const char *fmt, va_list ap);
+
+/**
+ * Convert an unsigned value to decimal. buf must hold at least 10 bytes.
+ * Returns the number of digits written (no terminator).
+ */
+int fmt_utoa(char *buf, uint32_t value);
+
+#endif /* FMT_H */
@@ -0,0 +1,88 @@
+#ifndef GPIO_H
+#define GPIO_H
+
+#include <stdint.h>
+
+/* -------------------------------------------------------------------------- */
+/*  GPIO: LEDs, switches and buttons (src/axi_gpio)                           */
+/*                                                                            */
+/*  Output bits are changed with single stores to the SET/CLR/TGL aliases,    */
+/*  no read-modify-write, so an interrupt handler and the main loop can both  */
+/*  drive LEDs without a critical section. Inputs are debounced in hardware   */
+/*  and edges raise GPIO_IRQ (level, cleared through GPIO_IRQ_STATUS).        */
+/*  Outputs with their PWM_EN bit set follow the PWM channel instead of OUT.  */
+/* -------------------------------------------------------------------------- */
+
+#define GPIO_BASE_ADDR        0x00002000
+
+#define GPIO_OUT              0x00
+#define GPIO_OUT_SET          0x04
+#define GPIO_OUT_CLR          0x08
+#define GPIO_OUT_TGL          0x0C
+#define GPIO_IN               0x10
+#define GPIO_IRQ_RISE_EN      0x14
+#define GPIO_IRQ_FALL_EN      0x18
+#define GPIO_IRQ_STATUS       0x1C
+#define GPIO_PWM_EN           0x20
+#define GPIO_PWM_PERIOD       0x24
+#define GPIO_PWM_PRESCALE     0x28
+#define GPIO_PWM_DUTY(n)      (0x40 + 4 * (n))
+
+/* Input pins on the Nexys Video */
+#define GPIO_SW(n)            (1U << (n))
+#define GPIO_BTNC             (1U << 8)
+#define GPIO_BTND             (1U << 9)
+#define GPIO_BTNL             (1U << 10)
+#define GPIO_BTNR             (1U << 11)
+#define GPIO_BTNU             (1U << 12)
+
+#define GPIO_IRQ              6    /**< PicoRV32 IRQ raised while an edge is pending */
+
+#define GPIO_REG(off) (*(volatile uint32_t *)(GPIO_BASE_ADDR + (off)))
+
+static inline void gpio_write(uint32_t value)  { GPIO_REG(GPIO_OUT) = value; }
+static inline uint32_t gpio_output(void)       { return GPIO_REG(GPIO_OUT); }
+static inline void gpio_set(uint32_t mask)     { GPIO_REG(GPIO_OUT_SET) = mask; }
+static inline void gpio_clear(uint32_t mask)   { GPIO_REG(GPIO_OUT_CLR) = mask; }
+static inline void gpio_toggle(uint32_t mask)  { GPIO_REG(GPIO_OUT_TGL) = mask; }
+static inline uint32_t gpio_read(void)         { return GPIO_REG(GPIO_IN); }
+
+/** Flag rising and/or falling edges of the inputs in mask, replaces the previous setting. */
+static inline void gpio_irq_enable(uint32_t rise_mask, uint32_t fall_mask)
+{
+    GPIO_REG(GPIO_IRQ_RISE_EN) = rise_mask;
+    GPIO_REG(GPIO_IRQ_FALL_EN) = fall_mask;
+}
+
+/** Return the pending edges and acknowledge them. */
+static inline uint32_t gpio_irq_ack(void)
+{
+    uint32_t status = GPIO_REG(GPIO_IRQ_STATUS);
+
+    GPIO_REG(GPIO_IRQ_STATUS) = status;
+    return status;
+}
+
+/**
+ * Configure the shared PWM counter: it advances every prescale + 1 clock cycles and counts
+ * 0 .. period, so the PWM frequency is fclk / ((prescale + 1) * (period + 1)).
+ */
+static inline void gpio_pwm_config(uint32_t prescale, uint32_t period)
+{
+    GPIO_REG(GPIO_PWM_PRESCALE) = prescale;
+    GPIO_REG(GPIO_PWM_PERIOD) = period;
+}
+
+/** Output n is high for duty counts per period, duty > period keeps it high. */
+static inline void gpio_pwm_duty(uint32_t n, uint32_t duty)
+{
+    GPIO_REG(GPIO_PWM_DUTY(n)) = duty;
+}
+
+/** Select PWM (bit set) or the OUT register (bit clear) for each output. */
+static inline void gpio_pwm_enable(uint32_t mask)
+{
+    GPIO_REG(GPIO_PWM_EN) = mask;
+}
+
+#endif /* GPIO_H */
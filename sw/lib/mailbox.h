@@ -0,0 +1,101 @@
+#ifndef MAILBOX_H
+#define MAILBOX_H
+
+#include <stdint.h>
+
+/* -------------------------------------------------------------------------- */
+/*  Inter-core mailbox and spinlocks (src/axi_mailbox)                        */
+/*                                                                            */
+/*  Mailbox n is the inbox of core n and holds a few words. Spinlocks are     */
+/*  taken by reading the lock register (0 means the reader now owns it) and   */
+/*  released by writing it. The hardware identifies the calling core, so the  */
+/*  same code runs on both cores. Only meaningful with ENABLE_DUAL_CORE_p = 1 */
+/*  (core 1 stays in reset otherwise).                                        */
+/* -------------------------------------------------------------------------- */
+
+#define MBOX_BASE_ADDR        0x00009000
+
+#define MBOX_CORE_ID          0x000
+#define MBOX_CORE_NBR         0x004
+#define MBOX_CORE_CTRL        0x008
+#define MBOX_IRQ_EN           0x00C
+#define MBOX_DATA(n)          (0x020 + 8 * (n))
+#define MBOX_STATUS(n)        (0x024 + 8 * (n))
+#define MBOX_LOCK(i)          (0x100 + 4 * (i))
+
+#define MBOX_STATUS_NOT_EMPTY (1U << 0)
+#define MBOX_STATUS_FULL      (1U << 1)
+
+#define MBOX_LOCK_NBR         16
+#define MBOX_IRQ              4    /**< PicoRV32 IRQ raised by the core 0 inbox */
+
+#define MBOX_REG(off) (*(volatile uint32_t *)(MBOX_BASE_ADDR + (off)))
+
+/** Index of the calling core. */
+static inline uint32_t core_id(void)
+{
+    return MBOX_REG(MBOX_CORE_ID);
+}
+
+/** Number of cores in the SoC. */
+static inline uint32_t core_count(void)
+{
+    return MBOX_REG(MBOX_CORE_NBR);
+}
+
+/** Release core n from reset, it starts at PROGADDR_RESET_CORE1_p. */
+static inline void core_release(uint32_t n)
+{
+    MBOX_REG(MBOX_CORE_CTRL) |= 1U << n;
+}
+
+/** Put core n back into reset. */
+static inline void core_hold(uint32_t n)
+{
+    MBOX_REG(MBOX_CORE_CTRL) &= ~(1U << n);
+}
+
+/** Send a word to core n, waits while its inbox is full. */
+static inline void mbox_send(uint32_t n, uint32_t value)
+{
+    while (MBOX_REG(MBOX_STATUS(n)) & MBOX_STATUS_FULL)
+        ;
+    MBOX_REG(MBOX_DATA(n)) = value;
+}
+
+/** Non-zero when the calling core has a word waiting. */
+static inline int mbox_pending(void)
+{
+    return MBOX_REG(MBOX_STATUS(core_id())) & MBOX_STATUS_NOT_EMPTY;
+}
+
+/** Receive a word for the calling core, waits until one arrives. */
+static inline uint32_t mbox_recv(void)
+{
+    uint32_t id = core_id();
+
+    while (!(MBOX_REG(MBOX_STATUS(id)) & MBOX_STATUS_NOT_EMPTY))
+        ;
+    return MBOX_REG(MBOX_DATA(id));
+}
+
+/** Take spinlock i, spins until it is free. */
+static inline void spin_lock(uint32_t i)
+{
+    while (MBOX_REG(MBOX_LOCK(i)) != 0)
+        ;
+}
+
+/** Try to take spinlock i once, returns non-zero on success. */
+static inline int spin_trylock(uint32_t i)
+{
+    return MBOX_REG(MBOX_LOCK(i)) == 0;
+}
+
+/** Release spinlock i. */
+static inline void spin_unlock(uint32_t i)
+{
+    MBOX_REG(MBOX_LOCK(i)) = 0;
+}
+
+#endif /* MAILBOX_H */
@@ -0,0 +1,211 @@
+#include <stdint.h>
+#include "mem.h"
+
+/* Keep GCC from turning the byte loops below back into memcpy/memset calls */
+#pragma GCC optimize ("no-tree-loop-distribute-patterns")
+
+/* -------------------------------------------------------------------------- */
+/*  Private helpers                                                           */
+/* -------------------------------------------------------------------------- */
+
+/* Word type that may alias any object, so word copies are not subject to
+ * strict-aliasing assumptions. */
+typedef uint32_t __attribute__((may_alias)) word_t;
+
+/* Below this length the alignment prologue costs more than it saves */
+#define MEM_SMALL_THRESHOLD 8
+
+static inline int is_aligned(const void *p)
+{
+    return ((uintptr_t)p & 3) == 0;
+}
+
+/* Forward copy, safe for overlapping buffers as long as dst <= src. */
+static void copy_fwd(uint8_t *d, const uint8_t *s, size_t n)
+{
+    if (n >= MEM_SMALL_THRESHOLD) {
+        while (!is_aligned(d)) {
+            *d++ = *s++;
+            n--;
+        }
+
+        word_t *dw = (word_t *)d;
+
+        if (is_aligned(s)) {
+            const word_t *sw = (const word_t *)s;
+
+            /* Load the whole block before storing it: PicoRV32 has no
+             * load-use stall, but grouping keeps the loop overhead at one
+             * branch per 32 bytes. */
+            while (n >= 32) {
+                uint32_t w0 = sw[0], w1 = sw[1], w2 = sw[2], w3 = sw[3];
+                uint32_t w4 = sw[4], w5 = sw[5], w6 = sw[6], w7 = sw[7];
+                dw[0] = w0; dw[1] = w1; dw[2] = w2; dw[3] = w3;
+                dw[4] = w4; dw[5] = w5; dw[6] = w6; dw[7] = w7;
+                dw += 8;
+                sw += 8;
+                n -= 32;
+            }
+            while (n >= 4) {
+                *dw++ = *sw++;
+                n -= 4;
+            }
+            s = (const uint8_t *)sw;
+        } else {
+            /* Source is misaligned relative to the destination: read aligned
+             * words and merge neighbours with shifts (little-endian). */
+            uint32_t off = (uintptr_t)s & 3;
+            uint32_t rs = off * 8;
+            uint32_t ls = 32 - rs;
+            const word_t *sw = (const word_t *)(s - off);
+            uint32_t lo = *sw++;
+
+            while (n >= 8) {
+                uint32_t m = *sw++;
+                uint32_t h = *sw++;
+                dw[0] = (lo >> rs) | (m << ls);
+                dw[1] = (m >> rs) | (h << ls);
+                dw += 2;
+                lo = h;
+                n -= 8;
+            }
+            if (n >= 4) {
+                uint32_t h = *sw++;
+                *dw++ = (lo >> rs) | (h << ls);
+                n -= 4;
+            }
+            s = (const uint8_t *)sw - 4 + off;
+        }
+        d = (uint8_t *)dw;
+    }
+
+    while (n--)
+        *d++ = *s++;
+}
+
+/* Backward copy for overlapping buffers with dst > src. */
+static void copy_bwd(uint8_t *d, const uint8_t *s, size_t n)
+{
+    d += n;
+    s += n;
+
+    if (n >= MEM_SMALL_THRESHOLD && (((uintptr_t)d ^ (uintptr_t)s) & 3) == 0) {
+        while (!is_aligned(d)) {
+            *--d = *--s;
+            n--;
+        }
+
+        word_t *dw = (word_t *)d;
+        const word_t *sw = (const word_t *)s;
+
+        while (n >= 16) {
+            uint32_t w3 = sw[-1], w2 = sw[-2], w1 = sw[-3], w0 = sw[-4];
+            dw[-1] = w3; dw[-2] = w2; dw[-3] = w1; dw[-4] = w0;
+            dw -= 4;
+            sw -= 4;
+            n -= 16;
+        }
+        while (n >= 4) {
+            *--dw = *--sw;
+            n -= 4;
+        }
+        d = (uint8_t *)dw;
+        s = (const uint8_t *)sw;
+    }
+
+    while (n--)
+        *--d = *--s;
+}
+
+/* -------------------------------------------------------------------------- */
+/*  Public API                                                                */
+/* -------------------------------------------------------------------------- */
+
+void *memcpy(void *restrict dst, const void *restrict src, size_t n)
+{
+    copy_fwd(dst, src, n);
+    return dst;
+}
+
+void *memmove(void *dst, const void *src, size_t n)
+{
+    uint8_t *d = dst;
+    const uint8_t *s = src;
+
+    if (d <= s || d >= s + n)
+        copy_fwd(d, s, n);
+    else
+        copy_bwd(d, s, n);
+    return dst;
+}
+
+void *memset(void *dst, int c, size_t n)
+{
+    uint8_t *d = dst;
+    uint8_t b = (uint8_t)c;
+
+    if (n >= MEM_SMALL_THRESHOLD) {
+        uint32_t w = b;
+        w |= w << 8;
+        w |= w << 16;
+
+        while (!is_aligned(d)) {
+            *d++ = b;
+            n--;
+        }
+
+        word_t *dw = (word_t *)d;
+        while (n >= 32) {
+            dw[0] = w; dw[1] = w; dw[2] = w; dw[3] = w;
+            dw[4] = w; dw[5] = w; dw[6] = w; dw[7] = w;
+            dw += 8;
+            n -= 32;
+        }
+        while (n >= 4) {
+            *dw++ = w;
+            n -= 4;
+        }
+        d = (uint8_t *)dw;
+    }
+
+    while (n--)
+        *d++ = b;
+    return dst;
+}
+
+int memcmp(const void *a, const void *b, size_t n)
+{
+    const uint8_t *pa = a;
+    const uint8_t *pb = b;
+
+    if (n >= MEM_SMALL_THRESHOLD && (((uintptr_t)pa ^ (uintptr_t)pb) & 3) == 0) {
+        while (!is_aligned(pa)) {
+            if (*pa != *pb)
+                return *pa - *pb;
+            pa++;
+            pb++;
+            n--;
+        }
+
+        const word_t *wa = (const word_t *)pa;
+        const word_t *wb = (const word_t *)pb;
+
+        /* Skip over equal words; the byte loop below locates the first
+         * differing byte of a mismatching word. */
+        while (n >= 4 && *wa == *wb) {
+            wa++;
+            wb++;
+            n -= 4;
+        }
+        pa = (const uint8_t *)wa;
+        pb = (const uint8_t *)wb;
+    }
+
+    while (n--) {
+        if (*pa != *pb)
+            return *pa - *pb;
+        pa++;
+        pb++;
+    }
+    return 0;
+}
@@ -0,0 +1,21 @@
+#ifndef MEM_H
+#define MEM_H
+
+#include <stddef.h>
+
+/* -------------------------------------------------------------------------- */
+/*  Freestanding memory primitives for RV32IMC                                */
+/*                                                                            */
+/*  These provide the symbols GCC emits calls to even with -ffreestanding     */
+/*  (struct copies, large initializers), so applications linking this         */
+/*  library no longer need to fall back to byte loops. PicoRV32 traps on      */
+/*  misaligned accesses, so all word accesses below are naturally aligned;    */
+/*  mismatched source/destination alignment is handled by shift-merging.      */
+/* -------------------------------------------------------------------------- */
+
+void *memcpy(void *restrict dst, const void *restrict src, size_t n);
+void *memmove(void *dst, const void *src, size_t n);
+void *memset(void *dst, int c, size_t n);
+int memcmp(const void *a, const void *b, size_t n);
+
+#endif /* MEM_H */
@@ -0,0 +1,62 @@
+#ifndef PCPI_CRC_H
+#define PCPI_CRC_H
+
+#include <stdint.h>
+
+/* -------------------------------------------------------------------------- */
+/*  Intrinsics for the pcpi_crc co-processor (src/pcpi_crc)                   */
+/*                                                                            */
+/*  R-type instructions on the custom-1 opcode (0x2B), funct7 = 0:            */
+/*    funct3 0  crc32.w  rd = CRC-32 state rs1 updated with word rs2          */
+/*    funct3 1  crc32.b  rd = CRC-32 state rs1 updated with byte rs2[7:0]     */
+/*    funct3 4  swz      rd byte i = rs1 byte rs2[2i+1:2i]                    */
+/*    funct3 5  bfextu   rd = rs1[rs2[4:0] +: rs2[9:5]+1], zero extended      */
+/*                                                                            */
+/*  Only use these when the SoC is built with ENABLE_PCPI_CRC_p = 1, on a     */
+/*  core without the co-processor they trap as illegal instructions.          */
+/*  Assembly code can use the macros in custom_ops.S instead.                 */
+/* -------------------------------------------------------------------------- */
+
+#define PCPI_SWZ_BSWAP    0x1B          /**< swz selector reversing the byte order */
+#define PCPI_SWZ_SPLAT(n) ((n) * 0x55)  /**< swz selector replicating byte n */
+
+/** Update a raw CRC-32 state with 4 bytes (little-endian word). */
+static inline uint32_t pcpi_crc32_w(uint32_t crc, uint32_t word)
+{
+    uint32_t rd;
+    __asm__ (".insn r 0x2B, 0, 0, %0, %1, %2" : "=r"(rd) : "r"(crc), "r"(word));
+    return rd;
+}
+
+/** Update a raw CRC-32 state with one byte. */
+static inline uint32_t pcpi_crc32_b(uint32_t crc, uint32_t byte)
+{
+    uint32_t rd;
+    __asm__ (".insn r 0x2B, 1, 0, %0, %1, %2" : "=r"(rd) : "r"(crc), "r"(byte));
+    return rd;
+}
+
+/** Permute the bytes of value, two selector bits per destination byte. */
+static inline uint32_t pcpi_swz(uint32_t value, uint32_t selector)
+{
+    uint32_t rd;
+    __asm__ (".insn r 0x2B, 4, 0, %0, %1, %2" : "=r"(rd) : "r"(value), "r"(selector));
+    return rd;
+}
+
+/** Reverse the byte order of a word. */
+static inline uint32_t pcpi_bswap(uint32_t value)
+{
+    return pcpi_swz(value, PCPI_SWZ_BSWAP);
+}
+
+/** Extract width (1..32) bits of value starting at bit lsb. */
+static inline uint32_t pcpi_bfextu(uint32_t value, uint32_t lsb, uint32_t width)
+{
+    uint32_t rd;
+    __asm__ (".insn r 0x2B, 5, 0, %0, %1, %2"
+             : "=r"(rd) : "r"(value), "r"((lsb & 31) | (((width - 1) & 31) << 5)));
+    return rd;
+}
+
+#endif /* PCPI_CRC_H */
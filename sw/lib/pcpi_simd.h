@@ -0,0 +1,121 @@
+#ifndef PCPI_SIMD_H
+#define PCPI_SIMD_H
+
+#include <stdint.h>
+
+/* -------------------------------------------------------------------------- */
+/*  Intrinsics for the pcpi_simd co-processor (src/pcpi_simd)                 */
+/*                                                                            */
+/*  R-type instructions on the custom-2 opcode (0x5B). A register holds 4     */
+/*  byte lanes (..8) or 2 halfword lanes (..16).                              */
+/*                                                                            */
+/*    funct7 0  funct3 0-3  add8 sub8 add16 sub16         wrapping            */
+/*    funct7 1  funct3 0-3  kadd8 ksub8 kadd16 ksub16     signed saturation   */
+/*    funct7 1  funct3 4-7  ukadd8 uksub8 ukadd16 uksub16 unsigned saturation */
+/*    funct7 2  funct3 0-3  cmpeq8 cmplt8 cmpeq16 cmplt16 lane mask, signed   */
+/*    funct7 2  funct3 4-7  max8 min8 max16 min16         signed              */
+/*    funct7 3  funct3 0    dot8   rd = sum of signed byte products           */
+/*    funct7 3  funct3 1    dot16  rd = sum of signed halfword products       */
+/*    funct7 3  funct3 2    mac8   acc += dot8,  rd = acc[31:0]               */
+/*    funct7 3  funct3 3    mac16  acc += dot16, rd = acc[31:0]               */
+/*    funct7 3  funct3 4    accrd  rd = sat32(acc >> rs1[5:0]), arithmetic    */
+/*    funct7 3  funct3 5    accwr  acc = {rs2, rs1}                           */
+/*                                                                            */
+/*  acc is a 64-bit accumulator inside the co-processor, one per core. It is  */
+/*  not saved on interrupts: IRQ handlers must not use the MAC instructions.  */
+/*  Every instruction takes 2 cycles in the co-processor. Only use these      */
+/*  when the SoC is built with ENABLE_PCPI_SIMD_p = 1, otherwise they trap    */
+/*  as illegal instructions.                                                  */
+/*  Assembly code can use the macros in custom_ops.S instead.                 */
+/* -------------------------------------------------------------------------- */
+
+/** Pack four bytes into the lanes of a word, b0 in the lowest lane. */
+static inline uint32_t pcpi_pack8(int8_t b0, int8_t b1, int8_t b2, int8_t b3)
+{
+    return (uint32_t)(uint8_t)b0 | ((uint32_t)(uint8_t)b1 << 8) |
+           ((uint32_t)(uint8_t)b2 << 16) | ((uint32_t)(uint8_t)b3 << 24);
+}
+
+/** Pack two halfwords into the lanes of a word, h0 in the lower lane. */
+static inline uint32_t pcpi_pack16(int16_t h0, int16_t h1)
+{
+    return (uint32_t)(uint16_t)h0 | ((uint32_t)(uint16_t)h1 << 16);
+}
+
+/* Lane-wise operations: no side effects, the compiler may schedule them freely */
+#define PCPI_SIMD_LANE_OP(name, funct7, funct3)                                     \
+    static inline uint32_t pcpi_##name(uint32_t a, uint32_t b)                      \
+    {                                                                               \
+        uint32_t rd;                                                                \
+        __asm__ (".insn r 0x5B, " #funct3 ", " #funct7 ", %0, %1, %2"               \
+                 : "=r"(rd) : "r"(a), "r"(b));                                      \
+        return rd;                                                                  \
+    }
+
+PCPI_SIMD_LANE_OP(add8,    0, 0)
+PCPI_SIMD_LANE_OP(sub8,    0, 1)
+PCPI_SIMD_LANE_OP(add16,   0, 2)
+PCPI_SIMD_LANE_OP(sub16,   0, 3)
+PCPI_SIMD_LANE_OP(kadd8,   1, 0)
+PCPI_SIMD_LANE_OP(ksub8,   1, 1)
+PCPI_SIMD_LANE_OP(kadd16,  1, 2)
+PCPI_SIMD_LANE_OP(ksub16,  1, 3)
+PCPI_SIMD_LANE_OP(ukadd8,  1, 4)
+PCPI_SIMD_LANE_OP(uksub8,  1, 5)
+PCPI_SIMD_LANE_OP(ukadd16, 1, 6)
+PCPI_SIMD_LANE_OP(uksub16, 1, 7)
+PCPI_SIMD_LANE_OP(cmpeq8,  2, 0)
+PCPI_SIMD_LANE_OP(cmplt8,  2, 1)
+PCPI_SIMD_LANE_OP(cmpeq16, 2, 2)
+PCPI_SIMD_LANE_OP(cmplt16, 2, 3)
+PCPI_SIMD_LANE_OP(max8,    2, 4)
+PCPI_SIMD_LANE_OP(min8,    2, 5)
+PCPI_SIMD_LANE_OP(max16,   2, 6)
+PCPI_SIMD_LANE_OP(min16,   2, 7)
+PCPI_SIMD_LANE_OP(dot8,    3, 0)
+PCPI_SIMD_LANE_OP(dot16,   3, 1)
+
+#undef PCPI_SIMD_LANE_OP
+
+/*
+ * Accumulator operations are volatile so they stay in program order with respect to each other.
+ */
+
+/** Set the accumulator. */
+static inline void pcpi_accwr(int64_t value)
+{
+    __asm__ volatile (".insn r 0x5B, 5, 3, x0, %0, %1"
+                      : : "r"((uint32_t)value), "r"((uint32_t)((uint64_t)value >> 32)));
+}
+
+/** Clear the accumulator. */
+static inline void pcpi_accclr(void)
+{
+    __asm__ volatile (".insn r 0x5B, 5, 3, x0, x0, x0");
+}
+
+/** acc += dot product of the byte lanes, returns the low word of the new accumulator. */
+static inline uint32_t pcpi_mac8(uint32_t a, uint32_t b)
+{
+    uint32_t rd;
+    __asm__ volatile (".insn r 0x5B, 2, 3, %0, %1, %2" : "=r"(rd) : "r"(a), "r"(b));
+    return rd;
+}
+
+/** acc += dot product of the halfword lanes, returns the low word of the new accumulator. */
+static inline uint32_t pcpi_mac16(uint32_t a, uint32_t b)
+{
+    uint32_t rd;
+    __asm__ volatile (".insn r 0x5B, 3, 3, %0, %1, %2" : "=r"(rd) : "r"(a), "r"(b));
+    return rd;
+}
+
+/** Read acc arithmetically shifted right by shift (0..63), saturated to int32_t. */
+static inline int32_t pcpi_accrd(uint32_t shift)
+{
+    uint32_t rd;
+    __asm__ volatile (".insn r 0x5B, 4, 3, %0, %1, x0" : "=r"(rd) : "r"(shift));
+    return (int32_t)rd;
+}
+
+#endif /* PCPI_SIMD_H */
@@ -0,0 +1,134 @@
+#include "spi.h"
+
+/* -------------------------------------------------------------------------- */
+/*  Private helpers — direct MMIO access                                      */
+/* -------------------------------------------------------------------------- */
+
+static inline uint32_t reg_read(const spi_t *dev, uint32_t offset)
+{
+    return dev->base[offset / sizeof(uint32_t)];
+}
+
+static inline void reg_write(const spi_t *dev, uint32_t offset, uint32_t val)
+{
+    dev->base[offset / sizeof(uint32_t)] = val;
+}
+
+/* -------------------------------------------------------------------------- */
+/*  Public API                                                                */
+/* -------------------------------------------------------------------------- */
+
+void spi_init(spi_t *dev, uintptr_t base_addr)
+{
+    dev->base = (volatile uint32_t *)base_addr;
+}
+
+void spi_configure(spi_t *dev, uint32_t ctrl, uint32_t clk_div)
+{
+    spi_wait_idle(dev);
+    reg_write(dev, SPI_REG_CTRL, ctrl);
+    reg_write(dev, SPI_REG_CLK_DIV, clk_div);
+}
+
+void spi_select(spi_t *dev, uint32_t cs_mask)
+{
+    reg_write(dev, SPI_REG_CS, cs_mask);
+}
+
+void spi_deselect(spi_t *dev)
+{
+    reg_write(dev, SPI_REG_CS, 0);
+}
+
+uint32_t spi_get_status(spi_t *dev)
+{
+    return reg_read(dev, SPI_REG_STATUS);
+}
+
+void spi_wait_idle(spi_t *dev)
+{
+    while (reg_read(dev, SPI_REG_STATUS) & SPI_STATUS_BUSY)
+        ;
+}
+
+void spi_set_thresholds(spi_t *dev, uint32_t tx_thresh, uint32_t rx_thresh)
+{
+    reg_write(dev, SPI_REG_THRESH, (tx_thresh & 0xFFU) | ((rx_thresh & 0xFFU) << 8));
+}
+
+void spi_enable_interrupts(spi_t *dev, uint32_t mask)
+{
+    reg_write(dev, SPI_REG_IRQ_EN, mask);
+}
+
+uint32_t spi_irq_ack(spi_t *dev)
+{
+    uint32_t status = reg_read(dev, SPI_REG_IRQ_STATUS);
+
+    if (status & SPI_IRQ_STICKY_MASK)
+        reg_write(dev, SPI_REG_IRQ_STATUS, status & SPI_IRQ_STICKY_MASK);
+    return status;
+}
+
+void spi_dma_enable(spi_t *dev, uint32_t mask)
+{
+    reg_write(dev, SPI_REG_DMA_CTRL, mask);
+}
+
+void spi_fifo_clear(spi_t *dev, uint32_t fifos)
+{
+    reg_write(dev, SPI_REG_FIFO_CLEAR, fifos);
+}
+
+void spi_transfer(spi_t *dev, const uint32_t *tx, uint32_t *rx, size_t n)
+{
+    size_t sent = 0;
+    size_t received = 0;
+
+    while (received < n) {
+        /* One STATUS read per round, the levels only move in our favour meanwhile */
+        uint32_t status = reg_read(dev, SPI_REG_STATUS);
+        size_t tx_room = SPI_FIFO_DEPTH - SPI_STATUS_TX_LEVEL(status);
+
+        for (size_t i = SPI_STATUS_RX_LEVEL(status); i > 0; i--) {
+            uint32_t frame = reg_read(dev, SPI_REG_RX_DATA);
+            if (rx)
+                rx[received] = frame;
+            received++;
+        }
+
+        /* At most SPI_FIFO_DEPTH frames without a place in the RX FIFO */
+        while (sent < n && tx_room > 0 && sent - received < SPI_FIFO_DEPTH) {
+            reg_write(dev, SPI_REG_TX_DATA, tx ? tx[sent] : 0);
+            sent++;
+            tx_room--;
+        }
+    }
+}
+
+void spi_write(spi_t *dev, const uint32_t *tx, size_t n)
+{
+    uint32_t ctrl = reg_read(dev, SPI_REG_CTRL);
+    size_t sent = 0;
+
+    spi_wait_idle(dev);
+    reg_write(dev, SPI_REG_CTRL, ctrl | SPI_CTRL_RX_DISABLE);
+    while (sent < n) {
+        size_t tx_room = SPI_FIFO_DEPTH - SPI_STATUS_TX_LEVEL(reg_read(dev, SPI_REG_STATUS));
+
+        while (sent < n && tx_room > 0) {
+            reg_write(dev, SPI_REG_TX_DATA, tx[sent++]);
+            tx_room--;
+        }
+    }
+    spi_wait_idle(dev);
+    reg_write(dev, SPI_REG_CTRL, ctrl);
+}
+
+uint32_t spi_transfer_frame(spi_t *dev, uint32_t frame)
+{
+    uint32_t rx;
+
+    spi_transfer(dev, &frame, &rx, 1);
+    return rx;
+}
@@ -0,0 +1,170 @@
+#ifndef SPI_H
+#define SPI_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* -------------------------------------------------------------------------- */
+/*  SPI master (src/axi_spi) on Pmod JA                                       */
+/*                                                                            */
+/*  Every FIFO word is one frame of 8, 16, 24 or 32 bits, right aligned.      */
+/*  Frames are shifted back to back while the TX FIFO has data, so keeping    */
+/*  it topped up gives the full SCK rate (up to fclk / 2). Change CTRL and    */
+/*  CLK_DIV only while the master is idle, spi_configure() waits for that.    */
+/* -------------------------------------------------------------------------- */
+
+#define SPI_BASE_ADDR             0x0000A000
+
+/* -------------------------------------------------------------------------- */
+/*  Register offsets                                                          */
+/* -------------------------------------------------------------------------- */
+#define SPI_REG_CTRL              0x00
+#define SPI_REG_CLK_DIV           0x04
+#define SPI_REG_CS                0x08
+#define SPI_REG_STATUS            0x0C
+#define SPI_REG_THRESH            0x10
+#define SPI_REG_IRQ_EN            0x14
+#define SPI_REG_IRQ_STATUS        0x18
+#define SPI_REG_FIFO_CLEAR        0x1C
+#define SPI_REG_TX_DATA           0x20
+#define SPI_REG_RX_DATA           0x24
+#define SPI_REG_DMA_CTRL          0x28
+
+/* -------------------------------------------------------------------------- */
+/*  CTRL register fields                                                      */
+/* -------------------------------------------------------------------------- */
+#define SPI_CTRL_CPOL             (1U << 0)
+#define SPI_CTRL_CPHA             (1U << 1)
+#define SPI_CTRL_LSB_FIRST        (1U << 2)
+#define SPI_CTRL_RX_DISABLE       (1U << 5)
+
+#define SPI_CTRL_MODE0            0
+#define SPI_CTRL_MODE1            SPI_CTRL_CPHA
+#define SPI_CTRL_MODE2            SPI_CTRL_CPOL
+#define SPI_CTRL_MODE3            (SPI_CTRL_CPOL | SPI_CTRL_CPHA)
+
+/* Frame size [4:3] */
+#define SPI_CTRL_FRAME_SHIFT      3
+#define SPI_CTRL_FRAME_MASK       (0x3U << SPI_CTRL_FRAME_SHIFT)
+#define SPI_CTRL_FRAME_8          (0x0U << SPI_CTRL_FRAME_SHIFT)
+#define SPI_CTRL_FRAME_16         (0x1U << SPI_CTRL_FRAME_SHIFT)
+#define SPI_CTRL_FRAME_24         (0x2U << SPI_CTRL_FRAME_SHIFT)
+#define SPI_CTRL_FRAME_32         (0x3U << SPI_CTRL_FRAME_SHIFT)
+
+/* -------------------------------------------------------------------------- */
+/*  CS register fields                                                        */
+/* -------------------------------------------------------------------------- */
+#define SPI_CS_SEL(n)             (1U << (n))
+#define SPI_CS_AUTO               (1U << 8)
+
+/* -------------------------------------------------------------------------- */
+/*  STATUS register bits (RO)                                                 */
+/* -------------------------------------------------------------------------- */
+#define SPI_STATUS_BUSY           (1U << 0)
+#define SPI_STATUS_TX_EMPTY       (1U << 1)
+#define SPI_STATUS_TX_FULL        (1U << 2)
+#define SPI_STATUS_RX_EMPTY       (1U << 3)
+#define SPI_STATUS_RX_FULL        (1U << 4)
+#define SPI_STATUS_TX_LEVEL(s)    (((s) >> 8) & 0xFFU)
+#define SPI_STATUS_RX_LEVEL(s)    (((s) >> 16) & 0xFFU)
+
+/* -------------------------------------------------------------------------- */
+/*  IRQ_EN / IRQ_STATUS bits, TX_LOW and RX_HIGH follow the FIFO levels, the  */
+/*  others are sticky and cleared by writing 1                                */
+/* -------------------------------------------------------------------------- */
+#define SPI_IRQ_TX_LOW            (1U << 0)   /* TX level <= TX threshold */
+#define SPI_IRQ_RX_HIGH           (1U << 1)   /* RX level >  RX threshold */
+#define SPI_IRQ_DONE              (1U << 2)
+#define SPI_IRQ_RX_OVERFLOW       (1U << 3)
+#define SPI_IRQ_TX_OVERFLOW       (1U << 4)
+
+#define SPI_IRQ_STICKY_MASK       (SPI_IRQ_DONE | SPI_IRQ_RX_OVERFLOW | SPI_IRQ_TX_OVERFLOW)
+
+/* -------------------------------------------------------------------------- */
+/*  FIFO_CLEAR and DMA_CTRL register bits                                     */
+/* -------------------------------------------------------------------------- */
+#define SPI_FIFO_CLEAR_TX         (1U << 0)
+#define SPI_FIFO_CLEAR_RX         (1U << 1)
+
+#define SPI_DMA_TX_REQ            (1U << 0)
+#define SPI_DMA_RX_REQ            (1U << 1)
+
+/* -------------------------------------------------------------------------- */
+/*  FIFO depth and interrupt                                                  */
+/* -------------------------------------------------------------------------- */
+#define SPI_FIFO_DEPTH            16   /* SPI_FIFO_DEPTH_p */
+#define SPI_IRQ                   7    /**< PicoRV32 IRQ, level, high while an enabled bit is set */
+
+/* -------------------------------------------------------------------------- */
+/*  Driver handle                                                             */
+/* -------------------------------------------------------------------------- */
+typedef struct {
+    volatile uint32_t *base;   /* Pointer to MMIO register base */
+} spi_t;
+
+/* -------------------------------------------------------------------------- */
+/*  API                                                                       */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * Initialize SPI handle with the given MMIO base address.
+ * Does NOT touch hardware — call spi_configure() after this.
+ */
+void spi_init(spi_t *dev, uintptr_t base_addr);
+
+/**
+ * Wait until the master is idle, then set CTRL (SPI_CTRL_* flags) and the
+ * clock divider: SCK = fclk / (2 * (clk_div + 1)).
+ * Example: spi_configure(dev, SPI_CTRL_MODE0 | SPI_CTRL_FRAME_8, 0);
+ */
+void spi_configure(spi_t *dev, uint32_t ctrl, uint32_t clk_div);
+
+/**
+ * Select the slaves in cs_mask (SPI_CS_SEL(n) flags). With SPI_CS_AUTO in
+ * cs_mask they are only selected while frames are shifted, otherwise they
+ * stay selected until spi_deselect().
+ */
+void spi_select(spi_t *dev, uint32_t cs_mask);
+
+/** Release all chip selects. */
+void spi_deselect(spi_t *dev);
+
+/** Read STATUS register. */
+uint32_t spi_get_status(spi_t *dev);
+
+/** Spin until the TX FIFO is empty and the last frame has been received. */
+void spi_wait_idle(spi_t *dev);
+
+/** Set the TX and RX FIFO thresholds of SPI_IRQ_TX_LOW and SPI_IRQ_RX_HIGH. */
+void spi_set_thresholds(spi_t *dev, uint32_t tx_thresh, uint32_t rx_thresh);
+
+/** Enable exactly the interrupts in mask (ORed SPI_IRQ_* flags), 0 disables all. */
+void spi_enable_interrupts(spi_t *dev, uint32_t mask);
+
+/** Return IRQ_STATUS and clear the sticky bits that were set. */
+uint32_t spi_irq_ack(spi_t *dev);
+
+/** Drive the DMA request lines in mask (SPI_DMA_TX_REQ / SPI_DMA_RX_REQ). */
+void spi_dma_enable(spi_t *dev, uint32_t mask);
+
+/** Flush TX FIFO, RX FIFO, or both. Use SPI_FIFO_CLEAR_TX/RX flags. */
+void spi_fifo_clear(spi_t *dev, uint32_t fifos);
+
+/**
+ * Shift n frames out and read n frames back (blocking). tx == NULL sends
+ * zeros, rx == NULL discards what comes back. The TX FIFO is kept full
+ * while no more than SPI_FIFO_DEPTH frames wait for their answer, so the
+ * RX FIFO never overflows and SCK does not stop between frames.
+ */
+void spi_transfer(spi_t *dev, const uint32_t *tx, uint32_t *rx, size_t n);
+
+/**
+ * Shift n frames out with the receiver disabled (blocking), for displays,
+ * DACs and flash programming where nothing useful comes back.
+ */
+void spi_write(spi_t *dev, const uint32_t *tx, size_t n);
+
+/** Exchange one frame (blocking). */
+uint32_t spi_transfer_frame(spi_t *dev, uint32_t frame);
+
+#endif /* SPI_H */
@@ -0,0 +1,42 @@
+#ifndef WBUF_H
+#define WBUF_H
+
+#include <stdint.h>
+
+/* -------------------------------------------------------------------------- */
+/*  Posted-write buffer (src/axi_lite_write_buffer)                           */
+/*                                                                            */
+/*  With ENABLE_WRITE_BUFFER_p = 1 a store completes before it has reached    */
+/*  the peripheral. Loads from the same 4k region still see it and stores to  */
+/*  different regions reach the bus in order, but code that needs a store to  */
+/*  have taken effect (before a wfi, before a reset) calls wbuf_drain().      */
+/*  A failed write (SLVERR/DECERR) raises WBUF_IRQ on core 0 until the error  */
+/*  count is read. Without the buffer stores are never posted, the registers  */
+/*  are unmapped and the return values are meaningless.                       */
+/* -------------------------------------------------------------------------- */
+
+#define WBUF_BASE_ADDR   0x00000FF0
+
+#define WBUF_DRAIN       0x0
+#define WBUF_ERR_ADDR    0x4
+
+#define WBUF_IRQ         5    /**< PicoRV32 IRQ raised while write errors are pending */
+
+#define WBUF_REG(off) (*(volatile uint32_t *)(WBUF_BASE_ADDR + (off)))
+
+/**
+ * Wait until every buffered store has completed. Returns the number of stores that failed
+ * since the last call and clears the error interrupt.
+ */
+static inline uint32_t wbuf_drain(void)
+{
+    return WBUF_REG(WBUF_DRAIN);
+}
+
+/** Address of the last store that failed. */
+static inline uint32_t wbuf_error_addr(void)
+{
+    return WBUF_REG(WBUF_ERR_ADDR);
+}
+
+#endif /* WBUF_H */
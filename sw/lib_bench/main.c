@@ -0,0 +1,297 @@
+// main.c - Cycle benchmark of the sw/lib runtime against naive byte loops
+#include <stdint.h>
+#include "uart.h"
+#include "mem.h"
+#include "crc.h"
+#include "fmt.h"
+#include "blog.h"
+
+#define UART_BASE_ADDR       0x00003000
+
+#define BUF_SIZE             1024
+#define FMT_ITERATIONS       64
+
+static uart_t uart0;
+
+static uint8_t src_buf[BUF_SIZE + 8] __attribute__((aligned(4)));
+static uint8_t dst_buf[BUF_SIZE + 8] __attribute__((aligned(4)));
+
+static volatile uint32_t sink;
+static uint32_t failures;
+
+/* -------------------------------------------------------------------------- */
+/*  Helpers                                                                   */
+/* -------------------------------------------------------------------------- */
+
+static inline uint32_t rdcycle(void)
+{
+    uint32_t cycles;
+    __asm__ volatile ("rdcycle %0" : "=r"(cycles));
+    return cycles;
+}
+
+uint32_t *irq(uint32_t *regs, uint32_t irqs)
+{
+    return regs;
+}
+
+static void report(const char *name, uint32_t naive, uint32_t lib, int ok)
+{
+    uint32_t ratio = lib ? (naive * 100U) / lib : 0;
+
+    if (!ok)
+        failures++;
+    uart_printf(&uart0, "%-26s %9u %9u %5u.%02ux  %s\r\n", name, naive, lib,
+                ratio / 100, ratio % 100, ok ? "ok" : "MISMATCH");
+}
+
+/* -------------------------------------------------------------------------- */
+/*  Naive reference implementations                                           */
+/* -------------------------------------------------------------------------- */
+
+__attribute__((noinline))
+static void naive_memcpy(uint8_t *d, const uint8_t *s, uint32_t n)
+{
+    while (n--)
+        *d++ = *s++;
+}
+
+__attribute__((noinline))
+static void naive_memset(uint8_t *d, uint8_t c, uint32_t n)
+{
+    while (n--)
+        *d++ = c;
+}
+
+__attribute__((noinline))
+static void naive_memmove(uint8_t *d, const uint8_t *s, uint32_t n)
+{
+    if (d < s) {
+        while (n--)
+            *d++ = *s++;
+    } else {
+        while (n--)
+            d[n] = s[n];
+    }
+}
+
+__attribute__((noinline))
+static int naive_memcmp(const uint8_t *a, const uint8_t *b, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++)
+        if (a[i] != b[i])
+            return a[i] - b[i];
+    return 0;
+}
+
+__attribute__((noinline))
+static uint32_t naive_crc32(const uint8_t *p, uint32_t n)
+{
+    uint32_t crc = 0xFFFFFFFFU;
+
+    while (n--) {
+        crc ^= *p++;
+        for (int i = 0; i < 8; i++)
+            crc = (crc >> 1) ^ (0xEDB88320U & -(crc & 1));
+    }
+    return ~crc;
+}
+
+__attribute__((noinline))
+static uint16_t naive_crc16(const uint8_t *p, uint32_t n)
+{
+    uint16_t crc = 0xFFFF;
+
+    while (n--) {
+        crc ^= (uint16_t)(*p++ << 8);
+        for (int i = 0; i < 8; i++)
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+    return crc;
+}
+
+__attribute__((noinline))
+static int naive_utoa(char *buf, uint32_t v)
+{
+    char tmp[10];
+    int n = 0;
+
+    do {
+        tmp[n++] = (char)('0' + v % 10);
+        v /= 10;
+    } while (v);
+    for (int i = 0; i < n; i++)
+        buf[i] = tmp[n - 1 - i];
+    return n;
+}
+
+/* -------------------------------------------------------------------------- */
+/*  Benchmarks                                                                */
+/* -------------------------------------------------------------------------- */
+
+static void bench_memcpy(const char *name, uint32_t src_off, uint32_t dst_off)
+{
+    uint32_t t0, t1, t2;
+
+    naive_memset(dst_buf, 0, sizeof(dst_buf));
+    t0 = rdcycle();
+    naive_memcpy(dst_buf + dst_off, src_buf + src_off, BUF_SIZE);
+    t1 = rdcycle();
+    memcpy(dst_buf + dst_off, src_buf + src_off, BUF_SIZE);
+    t2 = rdcycle();
+
+    report(name, t1 - t0, t2 - t1,
+           naive_memcmp(dst_buf + dst_off, src_buf + src_off, BUF_SIZE) == 0);
+}
+
+static void bench_memset(void)
+{
+    uint32_t t0, t1, t2;
+
+    t0 = rdcycle();
+    naive_memset(dst_buf, 0x5A, BUF_SIZE);
+    t1 = rdcycle();
+    memset(dst_buf, 0xA5, BUF_SIZE);
+    t2 = rdcycle();
+
+    report("memset 1KiB", t1 - t0, t2 - t1, dst_buf[0] == 0xA5 && dst_buf[BUF_SIZE - 1] == 0xA5);
+}
+
+static void bench_memmove(void)
+{
+    uint32_t t0, t1, t2, t3;
+
+    naive_memcpy(dst_buf, src_buf, BUF_SIZE);
+    t0 = rdcycle();
+    naive_memmove(dst_buf + 4, dst_buf, BUF_SIZE - 4);
+    t1 = rdcycle();
+
+    naive_memcpy(dst_buf, src_buf, BUF_SIZE);
+    t2 = rdcycle();
+    memmove(dst_buf + 4, dst_buf, BUF_SIZE - 4);
+    t3 = rdcycle();
+
+    report("memmove 1KiB overlap", t1 - t0, t3 - t2,
+           naive_memcmp(dst_buf + 4, src_buf, BUF_SIZE - 4) == 0);
+}
+
+static void bench_memcmp(void)
+{
+    uint32_t t0, t1, t2;
+    int a, b;
+
+    naive_memcpy(dst_buf, src_buf, BUF_SIZE);
+    dst_buf[BUF_SIZE - 1] ^= 1;
+    t0 = rdcycle();
+    a = naive_memcmp(dst_buf, src_buf, BUF_SIZE);
+    t1 = rdcycle();
+    b = memcmp(dst_buf, src_buf, BUF_SIZE);
+    t2 = rdcycle();
+
+    report("memcmp 1KiB", t1 - t0, t2 - t1, (a < 0) == (b < 0) && (a > 0) == (b > 0));
+}
+
+static void bench_crc(void)
+{
+    uint32_t t0, t1, t2;
+    uint32_t a32, b32;
+    uint16_t a16, b16;
+
+    t0 = rdcycle();
+    a32 = naive_crc32(src_buf, BUF_SIZE);
+    t1 = rdcycle();
+    b32 = crc32(src_buf, BUF_SIZE);
+    t2 = rdcycle();
+    report("crc32 1KiB", t1 - t0, t2 - t1, a32 == b32);
+
+    t0 = rdcycle();
+    a16 = naive_crc16(src_buf, BUF_SIZE);
+    t1 = rdcycle();
+    b16 = crc16_ccitt(src_buf, BUF_SIZE);
+    t2 = rdcycle();
+    report("crc16-ccitt 1KiB", t1 - t0, t2 - t1, a16 == b16);
+}
+
+static void bench_utoa(void)
+{
+    char a[12], b[12];
+    uint32_t t0, t1, t2, naive = 0, lib = 0;
+    uint32_t v = 0x9E3779B9U;
+    int ok = 1;
+
+    for (int i = 0; i < FMT_ITERATIONS; i++) {
+        t0 = rdcycle();
+        int na = naive_utoa(a, v);
+        t1 = rdcycle();
+        int nb = fmt_utoa(b, v);
+        t2 = rdcycle();
+        naive += t1 - t0;
+        lib += t2 - t1;
+        ok &= na == nb && naive_memcmp((uint8_t *)a, (uint8_t *)b, na) == 0;
+        v = v * 1664525U + 1013904223U;
+    }
+    report("utoa x64", naive, lib, ok);
+}
+
+static void uart_tx_wait(void)
+{
+    while (!(uart_get_status(&uart0) & UART_STATUS_TX_FIFO_EMPTY))
+        ;
+}
+
+/* The same log line as text and as a binary frame, timed until it has left the TX FIFO */
+static void bench_log(void)
+{
+    uint32_t t0, t1, t2, t3;
+    uint32_t text, bin;
+    uint32_t ch = 3, status = 0xA5C3;
+    int32_t mv = -1250;
+
+    uart_tx_wait();
+    t0 = rdcycle();
+    text = (uint32_t)uart_printf(&uart0, "sensor ch%u: %d mV, status %08x\r\n", ch, mv, status);
+    uart_tx_wait();
+    t1 = rdcycle();
+
+    t2 = rdcycle();
+    bin = BLOG(&uart0, "sensor ch%u: %d mV, status %08x\r\n", ch, mv, status);
+    uart_tx_wait();
+    t3 = rdcycle();
+
+    report("log line printf/blog", t1 - t0, t3 - t2, 1);
+    report("log line bytes", text, bin, 1);
+}
+
+int main(void) {
+
+    /*
+     * Initialize UART
+     *   8 data bits, 1 stop bit, no parity, 921600 baud rate
+     */
+    uart_init(&uart0, UART_BASE_ADDR);
+    uart_configure(&uart0, UART_CFG_DATA_8 | UART_CFG_BAUD_921600);
+    uart_fifo_clear(&uart0, UART_FIFO_CLEAR_TX | UART_FIFO_CLEAR_RX);
+
+    for (uint32_t i = 0; i < sizeof(src_buf); i++)
+        src_buf[i] = (uint8_t)(i * 7 + 3);
+
+    uart_printf(&uart0, "\r\n%-26s %9s %9s %9s\r\n", "benchmark (cycles)", "naive", "lib", "speedup");
+    bench_memcpy("memcpy 1KiB aligned", 0, 0);
+    bench_memcpy("memcpy 1KiB src+1", 1, 0);
+    bench_memcpy("memcpy 1KiB src+2 dst+1", 2, 1);
+    bench_memset();
+    bench_memmove();
+    bench_memcmp();
+    bench_crc();
+    bench_utoa();
+    bench_log();
+    uart_printf(&uart0, "%s\r\n", failures ? "FAILED" : "PASSED");
+
+    /* Wait for the TX FIFO to drain so simulation captures the full report */
+    uart_tx_wait();
+
+    sink = failures;
+    __asm__ volatile ("ebreak");
+
+    return 0;
+}
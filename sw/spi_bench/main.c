@@ -0,0 +1,184 @@
+// main.c - SPI master loopback check and throughput at several SCK dividers
+#include <stdint.h>
+#include "uart.h"
+#include "fmt.h"
+#include "irq.h"
+#include "spi.h"
+
+#define UART_BASE_ADDR       0x00003000
+#define CPU_MHZ              100
+
+#define BURST_LEN            256
+
+static uart_t uart0;
+static spi_t spi0;
+
+static uint32_t tx_buf[BURST_LEN];
+static uint32_t rx_buf[BURST_LEN];
+
+static volatile uint32_t spi_done_count;
+static volatile uint32_t sink;
+static uint32_t failures;
+static uint32_t seed = 0x2545F491U;
+
+/* The loopback slave answers with the bit stream delayed by 8 bits, this is its last byte */
+static uint32_t slave_byte;
+
+/* -------------------------------------------------------------------------- */
+/*  Helpers                                                                   */
+/* -------------------------------------------------------------------------- */
+
+static inline uint32_t rdcycle(void)
+{
+    uint32_t cycles;
+    __asm__ volatile ("rdcycle %0" : "=r"(cycles));
+    return cycles;
+}
+
+uint32_t *irq(uint32_t *regs, uint32_t irqs)
+{
+    /* Level interrupt, it drops once the sticky bits are acknowledged */
+    if (irqs & (1U << SPI_IRQ)) {
+        if (spi_irq_ack(&spi0) & SPI_IRQ_DONE)
+            spi_done_count++;
+    }
+    return regs;
+}
+
+static uint32_t rand32(void)
+{
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+static void fill(uint32_t mask)
+{
+    for (uint32_t i = 0; i < BURST_LEN; i++)
+        tx_buf[i] = rand32() & mask;
+}
+
+/* Compare rx_buf with what the loopback slave returns for tx_buf in MSB-first frames of bits */
+static int check(uint32_t n, uint32_t bits)
+{
+    int ok = 1;
+
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t expected = (slave_byte << (bits - 8)) | (tx_buf[i] >> 8);
+
+        if (bits < 32)
+            expected &= (1U << bits) - 1;
+        if (rx_buf[i] != expected && ok) {
+            uart_printf(&uart0, "  frame %u: got %08x, expected %08x\r\n", i, rx_buf[i], expected);
+            ok = 0;
+        }
+        slave_byte = tx_buf[i] & 0xFF;
+    }
+    return ok;
+}
+
+static void report(const char *kind, uint32_t bits, uint32_t clk_div, uint32_t cycles, int ok)
+{
+    /* Mbit/s with two decimals at CPU_MHZ */
+    uint32_t rate = cycles ? (BURST_LEN * bits * CPU_MHZ * 100U) / cycles : 0;
+
+    if (!ok)
+        failures++;
+    uart_printf(&uart0, "%-8s %2u bit, div %u %9u %5u.%02u  %s\r\n", kind, bits, clk_div, cycles,
+                rate / 100, rate % 100, ok ? "ok" : "MISMATCH");
+}
+
+/* -------------------------------------------------------------------------- */
+/*  Tests                                                                     */
+/* -------------------------------------------------------------------------- */
+
+static void bench_transfer(uint32_t frame, uint32_t bits, uint32_t clk_div)
+{
+    uint32_t start, cycles;
+
+    spi_configure(&spi0, SPI_CTRL_MODE0 | frame, clk_div);
+    fill(bits == 32 ? 0xFFFFFFFFU : (1U << bits) - 1);
+    start = rdcycle();
+    spi_transfer(&spi0, tx_buf, rx_buf, BURST_LEN);
+    cycles = rdcycle() - start;
+    report("transfer", bits, clk_div, cycles, check(BURST_LEN, bits));
+}
+
+static void bench_write(uint32_t clk_div)
+{
+    uint32_t start, cycles;
+    int ok;
+
+    spi_configure(&spi0, SPI_CTRL_MODE0 | SPI_CTRL_FRAME_32, clk_div);
+    fill(0xFFFFFFFFU);
+    start = rdcycle();
+    spi_write(&spi0, tx_buf, BURST_LEN);
+    cycles = rdcycle() - start;
+    /* Nothing may have been stored while the receiver was off */
+    ok = (spi_get_status(&spi0) & SPI_STATUS_RX_EMPTY) &&
+         !(spi_irq_ack(&spi0) & SPI_IRQ_RX_OVERFLOW);
+    slave_byte = tx_buf[BURST_LEN - 1] & 0xFF;
+    report("write", 32, clk_div, cycles, ok);
+}
+
+static void test_done_irq(void)
+{
+    uint32_t timeout = 100000;
+
+    spi_configure(&spi0, SPI_CTRL_MODE0 | SPI_CTRL_FRAME_8, 3);
+    spi_irq_ack(&spi0);
+    spi_done_count = 0;
+    spi_enable_interrupts(&spi0, SPI_IRQ_DONE);
+    irq_setmask(~(1U << SPI_IRQ));
+    irq_setie(1);
+
+    fill(0xFF);
+    spi_transfer(&spi0, tx_buf, rx_buf, 8);
+    while (spi_done_count == 0 && --timeout)
+        ;
+    irq_setie(0);
+    spi_enable_interrupts(&spi0, 0);
+
+    check(8, 8);
+    if (spi_done_count != 1)
+        failures++;
+    uart_printf(&uart0, "%-22s %9u %8s  %s\r\n", "done interrupt", spi_done_count, "",
+                spi_done_count == 1 ? "ok" : "MISSING");
+}
+
+int main(void) {
+
+    /*
+     * Initialize UART
+     *   8 data bits, 1 stop bit, no parity, 921600 baud rate
+     */
+    uart_init(&uart0, UART_BASE_ADDR);
+    uart_configure(&uart0, UART_CFG_DATA_8 | UART_CFG_BAUD_921600);
+    uart_fifo_clear(&uart0, UART_FIFO_CLEAR_TX | UART_FIFO_CLEAR_RX);
+
+    /* Slave 0 with automatic chip select, the loopback model starts out all zero */
+    spi_init(&spi0, SPI_BASE_ADDR);
+    spi_fifo_clear(&spi0, SPI_FIFO_CLEAR_TX | SPI_FIFO_CLEAR_RX);
+    spi_select(&spi0, SPI_CS_AUTO | SPI_CS_SEL(0));
+    slave_byte = 0;
+
+    uart_printf(&uart0, "\r\n%-22s %9s %8s\r\n", "SPI benchmark", "cycles", "Mbit/s");
+    bench_transfer(SPI_CTRL_FRAME_8, 8, 3);
+    bench_transfer(SPI_CTRL_FRAME_8, 8, 0);
+    bench_transfer(SPI_CTRL_FRAME_32, 32, 3);
+    bench_transfer(SPI_CTRL_FRAME_32, 32, 1);
+    bench_transfer(SPI_CTRL_FRAME_32, 32, 0);
+    bench_write(0);
+    test_done_irq();
+    uart_printf(&uart0, "%s\r\n", failures ? "FAILED" : "PASSED");
+
+    /* Wait for the TX FIFO to drain so simulation captures the full report */
+    while (!(uart_get_status(&uart0) & UART_STATUS_TX_FIFO_EMPTY))
+        ;
+
+    sink = failures;
+    __asm__ volatile ("ebreak");
+
+    return 0;
+}
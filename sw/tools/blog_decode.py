@@ -0,0 +1,195 @@
+#!/usr/bin/env python3
+# blog_decode.py - Host side of the deferred-format logger (sw/lib/blog.c)
+#
+# Reads BLOG() frames from a serial port, a raw capture file or a simulation log, looks the
+# format strings up in the .blog section of firmware.elf and prints the formatted messages.
+# Non-frame bytes are regular console output and are passed through unchanged.
+import argparse
+import re
+import struct
+import sys
+import time
+
+SYNC0 = 0xA5
+SYNC1 = ord('L')
+
+CONVERSION = re.compile(r'%([-0]*)(\d*)l?([diuxXpc%])')
+SIM_RX = re.compile(r'RX = 0x([0-9a-fA-F]{2})')
+
+
+def read_blog_section(elf):
+    """Return (address, bytes) of the .blog section, parsed directly from the ELF32 file."""
+    with open(elf, 'rb') as f:
+        data = f.read()
+    if data[:4] != b'\x7fELF' or data[4] != 1:
+        sys.exit('%s is not an ELF32 file' % elf)
+    shoff, = struct.unpack_from('<I', data, 0x20)
+    shentsize, shnum, shstrndx = struct.unpack_from('<HHH', data, 0x2E)
+
+    def section(i):
+        return struct.unpack_from('<IIIIII', data, shoff + i * shentsize)
+
+    strtab = section(shstrndx)[4]
+    for i in range(shnum):
+        name, _, _, addr, offset, size = section(i)
+        end = data.index(b'\0', strtab + name)
+        if data[strtab + name:end] == b'.blog':
+            return addr, data[offset:offset + size]
+    sys.exit('%s has no .blog section (see sw/lib/blog.h)' % elf)
+
+
+def format_message(fmt, args):
+    """Apply a uart_printf() style format to 32-bit argument words."""
+    args = list(args)
+
+    def convert(m):
+        flags, width, conv = m.groups()
+        if conv == '%':
+            return '%'
+        value = args.pop(0) & 0xFFFFFFFF if args else 0
+        if conv in 'di':
+            value = value - (1 << 32) if value & 0x80000000 else value
+            return ('%' + flags + width + 'd') % value
+        if conv == 'u':
+            return ('%' + flags + width + 'd') % value
+        if conv == 'p':
+            return ('%' + flags.replace('0', '') + width + 's') % ('0x%x' % value)
+        if conv == 'c':
+            return ('%' + flags.replace('0', '') + width + 's') % chr(value & 0xFF)
+        return ('%' + flags + width + conv) % value
+
+    return CONVERSION.sub(convert, fmt)
+
+
+class FrameParser:
+    """Incremental decoder for the BLOG() frame format."""
+
+    def __init__(self, blog_addr, blog_data, out):
+        self.blog_addr = blog_addr
+        self.blog_data = blog_data
+        self.out = out
+        self.buf = bytearray()
+        self.messages = 0
+        self.frame_bytes = 0
+        self.text_bytes = 0
+        self.bad_frames = 0
+
+    @staticmethod
+    def _varint(data, pos):
+        value = 0
+        shift = 0
+        while True:
+            b = data[pos]
+            pos += 1
+            value |= (b & 0x7F) << shift
+            shift += 7
+            if not b & 0x80:
+                break
+        return ((value >> 1) ^ -(value & 1)) & 0xFFFFFFFF, pos
+
+    def feed(self, data):
+        self.buf += data
+        while True:
+            idx = self.buf.find(bytes([SYNC0, SYNC1]))
+            if idx < 0:
+                # Keep a trailing SYNC0, it may start the next frame
+                keep = 1 if self.buf.endswith(bytes([SYNC0])) else 0
+                self._emit(self.buf[:len(self.buf) - keep].decode('ascii', errors='replace'))
+                del self.buf[:len(self.buf) - keep]
+                return
+            self._emit(self.buf[:idx].decode('ascii', errors='replace'))
+            del self.buf[:idx]
+            if len(self.buf) < 3 or len(self.buf) < 4 + self.buf[2]:
+                return
+            length = self.buf[2]
+            payload = bytes(self.buf[3:3 + length])
+            checksum = self.buf[3 + length]
+            message = None
+            if (length + sum(payload)) & 0xFF == checksum:
+                message = self._decode(payload)
+            if message is None:
+                # Not a frame after all, treat the sync bytes as console text
+                self.bad_frames += 1
+                self._emit(self.buf[:2].decode('ascii', errors='replace'))
+                del self.buf[:2]
+                continue
+            del self.buf[:4 + length]
+            self.messages += 1
+            self.frame_bytes += 4 + length
+            self.text_bytes += len(message)
+            self._emit(message)
+
+    def _decode(self, payload):
+        try:
+            words = []
+            pos = 0
+            while pos < len(payload):
+                value, pos = self._varint(payload, pos)
+                words.append(value)
+        except IndexError:
+            return None
+        if not words or not 0 <= words[0] - self.blog_addr < len(self.blog_data):
+            return None
+        offset = words[0] - self.blog_addr
+        end = self.blog_data.find(b'\0', offset)
+        fmt = self.blog_data[offset:end if end >= 0 else None].decode('ascii', errors='replace')
+        return format_message(fmt, words[1:])
+
+    def finish(self):
+        """Pass through what is left at the end of the input, e.g. a frame cut short."""
+        self._emit(self.buf.decode('ascii', errors='replace'))
+        del self.buf[:]
+
+    def _emit(self, text):
+        if text:
+            self.out.write(text)
+            self.out.flush()
+
+
+def capture_serial(parser, device, baud, duration):
+    import serial
+    port = serial.Serial(device, baud, timeout=0.1)
+    deadline = time.time() + duration if duration else None
+    try:
+        while deadline is None or time.time() < deadline:
+            data = port.read(4096)
+            if data:
+                parser.feed(data)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        port.close()
+
+
+def main():
+    ap = argparse.ArgumentParser(description='Decode BLOG() binary log frames')
+    src = ap.add_mutually_exclusive_group(required=True)
+    src.add_argument('-d', '--device', help='Serial device (e.g., /dev/ttyUSB0)')
+    src.add_argument('-i', '--input', help='Raw UART capture file instead of a live device')
+    src.add_argument('-s', '--sim-log', help='Simulation log with the testbench "RX = 0x.." lines')
+    ap.add_argument('-b', '--baud', type=int, default=921600, help='Baud rate (default: 921600)')
+    ap.add_argument('-t', '--duration', type=float, default=0,
+                    help='Capture duration in seconds (default: until Ctrl-C)')
+    ap.add_argument('-e', '--elf', required=True, help='firmware.elf holding the format strings')
+    args = ap.parse_args()
+
+    addr, data = read_blog_section(args.elf)
+    parser = FrameParser(addr, data, sys.stdout)
+    if args.input:
+        with open(args.input, 'rb') as f:
+            parser.feed(f.read())
+    elif args.sim_log:
+        with open(args.sim_log) as f:
+            parser.feed(bytes(int(m.group(1), 16) for m in SIM_RX.finditer(f.read())))
+    else:
+        capture_serial(parser, args.device, args.baud, args.duration)
+    parser.finish()
+
+    if parser.messages:
+        sys.stderr.write('\n%d messages: %d bytes sent, %d bytes as text (%.1fx), %d corrupt frames\n'
+                         % (parser.messages, parser.frame_bytes, parser.text_bytes,
+                            parser.text_bytes / parser.frame_bytes, parser.bad_frames))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+# bootloader_emu.py - Stand-in boards for testing the upload tools without hardware
+#
+# Creates one pseudo-terminal per emulated board and speaks the protocol of
+# sw/bootloader/bootloader.S on it: 'R' (full 16KB upload, '.' per 1KB), 'H' (CRC-32 of every
+# 256-byte block), 'W' <n> <256 bytes> (write block, '.' or '!') and 'J' (jump). After a jump the
+# "firmware" prints a banner with the CRC-32 of the image and a line every --tick seconds, until
+# a break or the byte 0x03 "resets" the board back into the bootloader. SRAM survives the reset,
+# like on the board.
+#
+#   python3 bootloader_emu.py -n 4 --link-dir /tmp/shock
+#   python3 multi_upload.py -f firmware.bin -d /tmp/shock/board* --delta -t 3
+import argparse
+import asyncio
+import os
+import random
+import sys
+import tty
+import zlib
+
+SRAM_SIZE = 16384
+BLOCK_SIZE = 256
+BLOCK_NBR = SRAM_SIZE // BLOCK_SIZE
+CHUNK_SIZE = 1024
+RESET = 0x03
+
+
+class Board:
+    """One emulated board behind the master side of a pseudo-terminal."""
+
+    def __init__(self, index, args):
+        self.index = index
+        self.args = args
+        self.master, self.slave = os.openpty()
+        # Keep the slave open so the master never sees EIO while no client is connected
+        tty.setraw(self.slave)
+        os.set_blocking(self.master, False)
+        self.path = os.ttyname(self.slave)
+        self.sram = bytearray(random.getrandbits(8) for _ in range(SRAM_SIZE))
+        self.rx = asyncio.Queue()
+        self.running = None
+        self.corrupt = index in args.corrupt
+
+    def on_readable(self):
+        try:
+            data = os.read(self.master, 4096)
+        except OSError:
+            return
+        for b in data:
+            self.rx.put_nowait(b)
+
+    async def recv(self, n):
+        data = bytearray()
+        while len(data) < n:
+            data.append(await self.rx.get())
+        return bytes(data)
+
+    def send(self, data):
+        if isinstance(data, str):
+            data = data.encode()
+        view = memoryview(data)
+        while view:
+            try:
+                written = os.write(self.master, view)
+            except BlockingIOError:
+                # Nobody is reading, drop the rest like a UART with a full FIFO
+                return
+            view = view[written:]
+
+    def store(self, offset, data):
+        self.sram[offset:offset + len(data)] = data
+        if self.corrupt:
+            # A flaky board, one bit of every store is lost
+            self.sram[offset] ^= 0x01
+
+    async def firmware(self):
+        crc = zlib.crc32(bytes(self.sram))
+        self.send('\r\nHello from emulated board %d, image crc32 0x%08x\r\n' % (self.index, crc))
+        tick = 0
+        while True:
+            await asyncio.sleep(self.args.tick)
+            self.send('tick %d\r\n' % tick)
+            tick += 1
+
+    async def run(self):
+        while True:
+            cmd = await self.rx.get()
+            if self.running:
+                if cmd == RESET:
+                    self.running.cancel()
+                    self.running = None
+                continue
+            if cmd == ord('R'):
+                for offset in range(0, SRAM_SIZE, CHUNK_SIZE):
+                    self.store(offset, await self.recv(CHUNK_SIZE))
+                    self.send(b'.')
+                self.running = asyncio.ensure_future(self.firmware())
+            elif cmd == ord('H'):
+                await asyncio.sleep(self.args.hash_delay)
+                self.send(b''.join(
+                    zlib.crc32(self.sram[i:i + BLOCK_SIZE]).to_bytes(4, 'little')
+                    for i in range(0, SRAM_SIZE, BLOCK_SIZE)))
+            elif cmd == ord('W'):
+                index = (await self.recv(1))[0]
+                data = await self.recv(BLOCK_SIZE)
+                if index < BLOCK_NBR:
+                    self.store(index * BLOCK_SIZE, data)
+                    self.send(b'.')
+                else:
+                    self.send(b'!')
+            elif cmd == ord('J'):
+                self.running = asyncio.ensure_future(self.firmware())
+
+
+async def serve(args):
+    boards = [Board(i, args) for i in range(args.boards)]
+    loop = asyncio.get_running_loop()
+    for board in boards:
+        loop.add_reader(board.master, board.on_readable)
+        if args.link_dir:
+            os.makedirs(args.link_dir, exist_ok=True)
+            link = os.path.join(args.link_dir, 'board%d' % board.index)
+            if os.path.lexists(link):
+                os.remove(link)
+            os.symlink(board.path, link)
+            print('%s -> %s' % (link, board.path))
+        else:
+            print(board.path)
+    sys.stdout.flush()
+    await asyncio.gather(*(board.run() for board in boards))
+
+
+def main():
+    ap = argparse.ArgumentParser(description='Emulate bootloader boards on pseudo-terminals')
+    ap.add_argument('-n', '--boards', type=int, default=2, help='Number of boards (default: 2)')
+    ap.add_argument('--link-dir', help='Create board<i> symlinks to the terminals in this directory')
+    ap.add_argument('--tick', type=float, default=1.0,
+                    help='Seconds between the lines printed by the emulated firmware')
+    ap.add_argument('--hash-delay', type=float, default=0.03,
+                    help='Time the bootloader takes to hash SRAM (default: 0.03 s)')
+    ap.add_argument('--corrupt', type=int, action='append', default=[], metavar='BOARD',
+                    help='Make this board corrupt every stored block (repeatable)')
+    args = ap.parse_args()
+    try:
+        asyncio.run(serve(args))
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,287 @@
+#!/usr/bin/env python3
+# multi_upload.py - Upload one image to many boards at once and log their consoles
+#
+# Every serial device is handled by its own coroutine on a single asyncio event loop, so N
+# boards take about as long as one. Each board gets the bootloader protocol of upload.py (a full
+# 'R' upload, or with --delta only the blocks whose CRC differs, verified with a second hash
+# request), and its console output is then written with timestamps to <log-dir>/<board>.log and
+# echoed with a [board] prefix. The serial ports are driven directly through termios, no
+# pyserial needed. Test it without hardware against bootloader_emu.py.
+#
+#   python3 multi_upload.py -f firmware.bin -d /dev/ttyUSB0 /dev/ttyUSB1 --delta -t 10
+import argparse
+import asyncio
+import datetime
+import os
+import signal
+import sys
+import termios
+import time
+import tty
+import zlib
+
+SRAM_SIZE = 16384
+BLOCK_SIZE = 256
+BLOCK_NBR = SRAM_SIZE // BLOCK_SIZE
+CHUNK_SIZE = 1024
+
+
+class UploadError(Exception):
+    pass
+
+
+class AsyncSerial:
+    """Raw, non-blocking serial port (or pseudo-terminal) driven by the event loop."""
+
+    def __init__(self, path, baud):
+        self.path = path
+        self.fd = os.open(path, os.O_RDWR | os.O_NOCTTY | os.O_NONBLOCK)
+        tty.setraw(self.fd)
+        attrs = termios.tcgetattr(self.fd)
+        speed = getattr(termios, 'B%d' % baud, None)
+        if speed is None:
+            raise UploadError('unsupported baud rate %d' % baud)
+        attrs[4] = attrs[5] = speed
+        attrs[2] |= termios.CLOCAL | termios.CREAD
+        termios.tcsetattr(self.fd, termios.TCSANOW, attrs)
+        termios.tcflush(self.fd, termios.TCIOFLUSH)
+        self.baud = baud
+        self.buf = bytearray()
+        self.event = asyncio.Event()
+        self.loop = asyncio.get_running_loop()
+        self.loop.add_reader(self.fd, self._on_readable)
+
+    def _on_readable(self):
+        try:
+            data = os.read(self.fd, 4096)
+        except OSError:
+            data = b''
+        if data:
+            self.buf += data
+            self.event.set()
+
+    def reset_input(self):
+        self.buf.clear()
+
+    async def read(self, n, timeout):
+        """Wait for n bytes, return what arrived before the timeout."""
+        deadline = self.loop.time() + timeout
+        while len(self.buf) < n:
+            remaining = deadline - self.loop.time()
+            if remaining <= 0:
+                break
+            self.event.clear()
+            try:
+                await asyncio.wait_for(self.event.wait(), remaining)
+            except asyncio.TimeoutError:
+                break
+        data = bytes(self.buf[:n])
+        del self.buf[:n]
+        return data
+
+    async def read_any(self):
+        """Wait for and return whatever has been received."""
+        while not self.buf:
+            self.event.clear()
+            await self.event.wait()
+        data = bytes(self.buf)
+        self.buf.clear()
+        return data
+
+    async def write(self, data):
+        view = memoryview(data)
+        while view:
+            try:
+                written = os.write(self.fd, view)
+                view = view[written:]
+            except BlockingIOError:
+                writable = self.loop.create_future()
+                self.loop.add_writer(self.fd, writable.set_result, None)
+                try:
+                    await writable
+                finally:
+                    self.loop.remove_writer(self.fd)
+        # Let the data leave before timing anything on the answer
+        await self.loop.run_in_executor(None, termios.tcdrain, self.fd)
+
+    def wire_time(self, nbr):
+        """Seconds nbr bytes take on the line at 10 bits per byte."""
+        return nbr * 10 / self.baud
+
+    def close(self):
+        self.loop.remove_reader(self.fd)
+        os.close(self.fd)
+
+
+class Board:
+    def __init__(self, path, args, image):
+        self.path = path
+        self.name = os.path.basename(path)
+        self.args = args
+        self.image = image
+        self.status = 'pending'
+        self.detail = ''
+        self.upload_time = 0.0
+        self.lines = 0
+        self.log = None
+        self.port = None
+
+    async def read_hashes(self):
+        self.port.reset_input()
+        await self.port.write(b'H')
+        raw = await self.port.read(4 * BLOCK_NBR, 2.0 + self.port.wire_time(4 * BLOCK_NBR))
+        if len(raw) != 4 * BLOCK_NBR:
+            return None
+        return [int.from_bytes(raw[4 * i:4 * i + 4], 'little') for i in range(BLOCK_NBR)]
+
+    async def full_upload(self):
+        await self.port.write(b'R')
+        for offset in range(0, SRAM_SIZE, CHUNK_SIZE):
+            await self.port.write(self.image[offset:offset + CHUNK_SIZE])
+            ack = await self.port.read(1, 5.0)
+            if ack != b'.':
+                raise UploadError('no progress indicator after %d bytes' % (offset + CHUNK_SIZE))
+        return 'full'
+
+    async def delta_upload(self, hashes):
+        used = (self.args.file_size + BLOCK_SIZE - 1) // BLOCK_SIZE
+        blocks = [self.image[i * BLOCK_SIZE:(i + 1) * BLOCK_SIZE] for i in range(used)]
+        changed = [i for i in range(used) if zlib.crc32(blocks[i]) != hashes[i]]
+        for i in changed:
+            await self.port.write(b'W' + bytes([i]) + blocks[i])
+            ack = await self.port.read(1, 5.0)
+            if ack != b'.':
+                raise UploadError('block %d not acknowledged (%r)' % (i, ack))
+        if changed:
+            hashes = await self.read_hashes()
+            if hashes is None:
+                raise UploadError('no hashes received when verifying')
+            bad = [i for i in range(used) if zlib.crc32(blocks[i]) != hashes[i]]
+            if bad:
+                raise UploadError('blocks %s differ after upload' % bad)
+        await self.port.write(b'J')
+        return 'delta %d/%d' % (len(changed), used)
+
+    async def upload(self):
+        start = time.monotonic()
+        mode = None
+        if self.args.delta:
+            hashes = await self.read_hashes()
+            if hashes is not None:
+                mode = await self.delta_upload(hashes)
+            else:
+                self.port.reset_input()
+        if mode is None:
+            mode = await self.full_upload()
+        self.upload_time = time.monotonic() - start
+        return mode
+
+    def log_line(self, text):
+        stamp = datetime.datetime.now().strftime('%H:%M:%S.%f')[:-3]
+        self.log.write('%s %s\n' % (stamp, text))
+        self.log.flush()
+        if not self.args.quiet:
+            print('%s [%s] %s' % (stamp, self.name, text))
+
+    async def console(self, expect):
+        """Log console lines until cancelled, the board counts as verified once expect shows up."""
+        pending = b''
+        found = expect is None
+        while True:
+            pending += await self.port.read_any()
+            *lines, pending = pending.split(b'\n')
+            for line in lines:
+                text = line.rstrip(b'\r').decode('utf-8', 'replace')
+                self.log_line(text)
+                self.lines += 1
+                if not found and expect in text:
+                    found = True
+                    self.status = 'ok'
+                    self.detail += ', saw "%s"' % expect
+
+    async def run(self, stop):
+        try:
+            self.port = AsyncSerial(self.path, self.args.baud)
+        except (OSError, UploadError) as e:
+            self.status, self.detail = 'FAILED', str(e)
+            return
+        self.log = open(os.path.join(self.args.log_dir, self.name + '.log'), 'w')
+        try:
+            self.status = 'uploading'
+            self.detail = await self.upload()
+            self.status = 'waiting' if self.args.expect else 'ok'
+            self.log_line('--- uploaded %s in %.2f s ---' % (self.detail, self.upload_time))
+            console = asyncio.ensure_future(self.console(self.args.expect))
+            try:
+                if self.args.expect:
+                    deadline = time.monotonic() + self.args.expect_timeout
+                    while self.status != 'ok' and time.monotonic() < deadline:
+                        await asyncio.sleep(0.05)
+                    if self.status != 'ok':
+                        raise UploadError('"%s" not seen within %.1f s' %
+                                          (self.args.expect, self.args.expect_timeout))
+                    if not self.args.duration:
+                        return
+                await stop.wait()
+            finally:
+                console.cancel()
+        except UploadError as e:
+            self.status, self.detail = 'FAILED', str(e)
+            self.log_line('--- FAILED: %s ---' % e)
+        finally:
+            self.log.close()
+            self.port.close()
+
+
+async def run_all(args, image):
+    os.makedirs(args.log_dir, exist_ok=True)
+    boards = [Board(path, args, image) for path in args.devices]
+    stop = asyncio.Event()
+    loop = asyncio.get_running_loop()
+    if args.duration:
+        loop.call_later(args.duration, stop.set)
+    loop.add_signal_handler(signal.SIGINT, stop.set)
+    await asyncio.gather(*(board.run(stop) for board in boards))
+    return boards
+
+
+def main():
+    ap = argparse.ArgumentParser(description='Upload a binary to several bootloaders at once and '
+                                             'log their consoles')
+    ap.add_argument('-f', '--file', required=True, help='Binary file to upload')
+    ap.add_argument('-d', '--devices', nargs='+', required=True,
+                    help='Serial devices (e.g., /dev/ttyUSB0 /dev/ttyUSB1)')
+    ap.add_argument('-b', '--baud', type=int, default=115200, help='Baud rate (default: 115200)')
+    ap.add_argument('--delta', action='store_true',
+                    help='Only send the 256-byte blocks that differ from each board\'s SRAM')
+    ap.add_argument('-t', '--duration', type=float, default=0,
+                    help='Stop logging the consoles after this many seconds (default: until '
+                         'Ctrl-C, or until every board has printed --expect)')
+    ap.add_argument('-l', '--log-dir', default='logs', help='Per-board log directory (default: logs)')
+    ap.add_argument('-e', '--expect',
+                    help='Text every board must print after the upload to count as verified')
+    ap.add_argument('--expect-timeout', type=float, default=5.0,
+                    help='Seconds to wait for --expect (default: 5)')
+    ap.add_argument('-q', '--quiet', action='store_true', help='Only write the log files')
+    args = ap.parse_args()
+
+    with open(args.file, 'rb') as f:
+        image = f.read()
+    args.file_size = len(image)
+    if args.file_size > SRAM_SIZE:
+        sys.exit('Error: %s does not fit into %d bytes of SRAM' % (args.file, SRAM_SIZE))
+    image += b'\0' * (SRAM_SIZE - len(image))
+
+    # With --expect and no duration every board is done once it has shown the text
+    boards = asyncio.run(run_all(args, image))
+
+    print('\n%-16s %-8s %8s %7s  %s' % ('board', 'status', 'upload', 'lines', 'details'))
+    for board in boards:
+        print('%-16s %-8s %7.2fs %7d  %s' % (board.name, board.status, board.upload_time,
+                                             board.lines, board.detail))
+    failed = [b for b in boards if b.status != 'ok']
+    return 1 if failed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,241 @@
+#!/usr/bin/env python3
+# pgo_layout.py - Profile-guided function layout for PicoRV32 firmware
+#
+# Reads PC samples of a previous run and rewrites an application linker script so that the
+# sampled functions are placed back to back at the start of .text, ordered so that hot callers
+# and callees are adjacent, followed by cold (.text.unlikely) and init (.text.startup) code and
+# then everything that was never sampled. With --ram-budget the hottest functions of an XIP image
+# are moved into .ramtext and run from SRAM instead of through the QSPI line cache.
+#
+# Profiles, any mix of:
+#   - "pc ra" hex pairs: tb +pc_samples=<file>, or profile.py --samples
+#   - folded stacks ("caller;callee count"): profile.py -o
+# The firmware must be compiled and linked with -ffunction-sections: with -flto the code is only
+# generated at link time, so the flag has to be in LDFLAGS as well. Clones GCC makes of a function
+# (name.lto_priv.N, name.constprop.N, name.isra.N, name.part.N) are placed together with it, as
+# their numbering changes from one link to the next.
+import argparse
+import bisect
+import os
+import re
+import subprocess
+import sys
+from collections import Counter
+
+TEXT_CATCH_ALL = re.compile(r'^(\s*)\*\(\.text\*\)\s*$')
+HEX_WORD = re.compile(r'^[0-9a-fA-F]{8}$')
+CLONE_SUFFIX = re.compile(r'(\.(lto_priv|constprop|isra|part)\.\d+)+$')
+
+
+def base_name(sym):
+    """Strip the clone suffixes GCC appends to local and specialized functions."""
+    return CLONE_SUFFIX.sub('', sym)
+
+
+class Functions:
+    """Function symbols of an ELF (address, size, name) from nm."""
+
+    def __init__(self, elf, cross):
+        out = subprocess.run([cross + 'nm', '-n', '-S', '--defined-only', elf],
+                             check=True, capture_output=True, text=True).stdout
+        self.starts = []
+        self.entries = []
+        self.size = {}
+        for line in out.splitlines():
+            fields = line.split()
+            if len(fields) != 4 or fields[2] not in 'tTwW':
+                continue
+            start = int(fields[0], 16)
+            size = int(fields[1], 16)
+            self.starts.append(start)
+            self.entries.append((start, start + size, fields[3]))
+            name = base_name(fields[3])
+            self.size[name] = self.size.get(name, 0) + size
+
+    def lookup(self, addr):
+        i = bisect.bisect_right(self.starts, addr) - 1
+        if i >= 0:
+            start, end, name = self.entries[i]
+            if start <= addr < end:
+                return name
+        return None
+
+
+def read_profile(path, funcs):
+    """Return (self samples per function, caller->callee edge weights, sample count)."""
+    self_count = Counter()
+    edges = Counter()
+    total = 0
+    with open(path) as f:
+        for line in f:
+            fields = line.split()
+            if not fields:
+                continue
+            if len(fields) == 2 and HEX_WORD.match(fields[0]) and HEX_WORD.match(fields[1]):
+                # "pc ra" pair, symbolized against the ELF
+                if funcs is None:
+                    sys.exit('%s: raw PC samples need the ELF they were taken from (-e)' % path)
+                callee = funcs.lookup(int(fields[0], 16))
+                caller = funcs.lookup(int(fields[1], 16))
+                count = 1
+            else:
+                stack = fields[0].split(';')
+                callee = stack[-1]
+                caller = stack[-2] if len(stack) > 1 else None
+                count = int(fields[-1])
+            total += count
+            if callee is None or callee.startswith('0x'):
+                continue
+            callee = base_name(callee)
+            caller = base_name(caller) if caller else None
+            self_count[callee] += count
+            if caller and caller != callee and not caller.startswith('0x'):
+                edges[(caller, callee)] += count
+    return self_count, edges, total
+
+
+def order_functions(self_count, edges):
+    """Greedy call-graph chaining (Pettis-Hansen): merge the chains of the heaviest caller/callee
+    pairs first so they end up adjacent, then emit chains by their total sample count."""
+    chain_of = {fn: [fn] for fn in self_count}
+    for (caller, callee), _ in edges.most_common():
+        a = chain_of.get(caller)
+        b = chain_of.get(callee)
+        if a is None or b is None or a is b:
+            continue
+        a.extend(b)
+        for fn in b:
+            chain_of[fn] = a
+    chains = {id(c): c for c in chain_of.values()}.values()
+    order = []
+    for chain in sorted(chains, key=lambda c: (-sum(self_count[fn] for fn in c), c[0])):
+        order.extend(chain)
+    return order
+
+
+def input_sections(fn, indent):
+    # main and other functions GCC considers init code land in .text.startup.<name>, clones in
+    # .text.<name>.<suffix>
+    return '%s*(%s)\n' % (indent, ' '.join('.text.%s%s .text.%s%s.*' % (prefix, fn, prefix, fn)
+                                             for prefix in ('', 'hot.', 'startup.')))
+
+
+def rewrite_script(lines, hot, ram):
+    """Insert the hot functions in front of the .text catch-all, ram functions into .ramtext."""
+    out = []
+    moved = []              # .text lines after the catch-all, moved out of .text in RAM mode
+    state = 'search'
+    for line in lines:
+        m = TEXT_CATCH_ALL.match(line)
+        if state == 'search' and m:
+            indent = m.group(1)
+            out.append('%s/* pgo_layout.py: sampled functions, hottest call chains first */\n'
+                       % indent)
+            out.extend(input_sections(fn, indent) for fn in hot)
+            out.append('%s*(.text.unlikely .text.unlikely.*)\n' % indent)
+            out.append('%s*(.text.startup .text.startup.*)\n' % indent)
+            if ram:
+                # The catch-all must come after .ramtext in the script, or it would claim the
+                # SRAM functions first. It moves to its own section, still in flash.
+                moved.append(line)
+                state = 'move'
+            else:
+                out.append(line)
+                state = 'done'
+        elif state == 'move':
+            if line.strip().startswith('}'):
+                out.append(line)
+                state = 'ramtext'
+            else:
+                moved.append(line)
+        elif state == 'ramtext' and 'KEEP(*(.ramvectors))' in line:
+            out.append(line)
+            indent = line[:len(line) - len(line.lstrip())]
+            out.append('%s/* pgo_layout.py: hottest functions, run from SRAM */\n' % indent)
+            out.extend(input_sections(fn, indent) for fn in ram)
+            state = 'flash'
+        elif state == 'flash' and line.strip().startswith('_ramtext_load'):
+            out.append(line)
+            out.append('\n    /* pgo_layout.py: unsampled code and read-only data */\n')
+            out.append('    .text.rest : {\n')
+            out.extend(moved)
+            out.append('    } > FLASH\n')
+            state = 'done'
+        else:
+            out.append(line)
+    if state != 'done':
+        what = {'search': 'a "*(.text*)" line',
+                'ramtext': 'a .ramtext section with KEEP(*(.ramvectors))',
+                'flash': 'the _ramtext_load assignment'}.get(state, 'the end of .text')
+        sys.exit('Linker script has no %s to rewrite' % what)
+    return out
+
+
+def main():
+    ap = argparse.ArgumentParser(description='Generate a profile-guided linker script')
+    ap.add_argument('profiles', nargs='+', help='PC sample or folded stack files')
+    ap.add_argument('-e', '--elf', help='firmware.elf the samples were taken from')
+    ap.add_argument('-T', '--script', default='picorv32.ld', help='Base linker script')
+    ap.add_argument('-o', '--output', default='picorv32_pgo.ld', help='Generated linker script')
+    ap.add_argument('--cross', default=os.environ.get('CROSS', 'riscv32-unknown-elf-'),
+                    help='Toolchain prefix (default: riscv32-unknown-elf-)')
+    ap.add_argument('--ram-budget', type=int, default=0,
+                    help='Move the hottest functions of an XIP image to SRAM, up to this many bytes')
+    ap.add_argument('--min-samples', type=int, default=1,
+                    help='Functions with fewer samples are left in place (default: 1)')
+    ap.add_argument('-n', '--top', type=int, default=15, help='Number of hot functions to print')
+    args = ap.parse_args()
+
+    funcs = Functions(args.elf, args.cross) if args.elf else None
+    self_count = Counter()
+    edges = Counter()
+    total = 0
+    for path in args.profiles:
+        s, e, t = read_profile(path, funcs)
+        self_count.update(s)
+        edges.update(e)
+        total += t
+    if not total:
+        sys.exit('No samples in %s' % ', '.join(args.profiles))
+
+    # Assembly entry points have no .text.<name> section of their own
+    self_count = Counter({fn: n for fn, n in self_count.items()
+                          if n >= args.min_samples and not fn.startswith('_')})
+    hot = order_functions(self_count, edges)
+
+    ram = []
+    if args.ram_budget:
+        if funcs is None:
+            sys.exit('--ram-budget needs the function sizes from the ELF (-e)')
+        used = 0
+        for fn, _ in self_count.most_common():
+            size = funcs.size.get(fn, 0)
+            if size and used + size <= args.ram_budget:
+                ram.append(fn)
+                used += size
+        ram.sort(key=hot.index)
+        hot = [fn for fn in hot if fn not in ram]
+
+    with open(args.script) as f:
+        lines = f.readlines()
+    with open(args.output, 'w') as f:
+        f.write('/* Generated by pgo_layout.py from %s and %s, do not edit */\n'
+                % (args.script, ', '.join(args.profiles)))
+        f.writelines(rewrite_script(lines, hot, ram))
+
+    placed = sum(self_count.values())
+    print('%d samples, %d in %d placed functions (%.1f%%)' %
+          (total, placed, len(self_count), 100.0 * placed / total))
+    if funcs is not None:
+        hot_bytes = sum(funcs.size.get(fn, 0) for fn in hot + ram)
+        print('Hot code: %d bytes, %d of them in SRAM' %
+              (hot_bytes, sum(funcs.size.get(fn, 0) for fn in ram)))
+    print('%8s %7s  %-6s %s' % ('samples', 'self%', 'where', 'function'))
+    for fn, count in self_count.most_common(args.top):
+        print('%8d %6.1f%%  %-6s %s' % (count, 100.0 * count / total,
+                                       'sram' if fn in ram else 'text', fn))
+    print('Wrote %s' % args.output)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,243 @@
+#!/usr/bin/env python3
+# profile.py - Host side of the sampling PC profiler (sw/hello_world/profiler.c)
+#
+# Reads profiler frames from a serial port (or a raw capture file), symbolizes
+# the sampled PC / return address pairs against firmware.elf and writes folded
+# stacks ("caller;callee count" lines, as consumed by flamegraph.pl) and an
+# optional self-contained SVG flame graph. Non-frame bytes are regular console
+# output and are passed through to stdout. The default baud rate is 921600, the console rate
+# of hello_world, not the 115200 of the bootloader used for the upload.
+import argparse
+import bisect
+import html
+import os
+import subprocess
+import sys
+import time
+from collections import Counter
+
+SYNC0 = 0xA5
+SYNC1 = ord('P')
+
+
+class Symbolizer:
+    """Map addresses to function names using nm from the RISC-V toolchain."""
+
+    def __init__(self, elf, cross):
+        out = subprocess.run([cross + 'nm', '-n', '-S', '--defined-only', elf],
+                             check=True, capture_output=True, text=True).stdout
+        self.starts = []
+        self.entries = []
+        for line in out.splitlines():
+            fields = line.split()
+            if len(fields) != 4 or fields[2] not in 'tTwW':
+                continue
+            start = int(fields[0], 16)
+            size = int(fields[1], 16)
+            self.starts.append(start)
+            self.entries.append((start, start + size, fields[3]))
+
+    def lookup(self, addr):
+        i = bisect.bisect_right(self.starts, addr) - 1
+        if i >= 0:
+            start, end, name = self.entries[i]
+            if start <= addr < end:
+                return name
+        return '0x%08x' % addr
+
+
+class FrameParser:
+    """Incremental decoder for the profiler frame format."""
+
+    def __init__(self, console):
+        self.buf = bytearray()
+        self.console = console
+        self.samples = []
+        self.dropped = 0
+        self.bad_frames = 0
+
+    @staticmethod
+    def _varint(data, pos):
+        value = 0
+        shift = 0
+        while True:
+            b = data[pos]
+            pos += 1
+            value |= (b & 0x7F) << shift
+            shift += 7
+            if not b & 0x80:
+                break
+        return (value >> 1) ^ -(value & 1), pos
+
+    def feed(self, data):
+        self.buf += data
+        while True:
+            idx = self.buf.find(bytes([SYNC0, SYNC1]))
+            if idx < 0:
+                # Keep a trailing SYNC0, it may start the next frame
+                keep = 1 if self.buf.endswith(bytes([SYNC0])) else 0
+                self._emit_console(self.buf[:len(self.buf) - keep])
+                del self.buf[:len(self.buf) - keep]
+                return
+            self._emit_console(self.buf[:idx])
+            del self.buf[:idx]
+            if len(self.buf) < 5 or len(self.buf) < 6 + self.buf[4]:
+                return
+            count, dropped, length = self.buf[2], self.buf[3], self.buf[4]
+            payload = bytes(self.buf[5:5 + length])
+            checksum = self.buf[5 + length]
+            if (count + dropped + length + sum(payload)) & 0xFF != checksum:
+                # Not a frame after all, treat the sync bytes as console text
+                self.bad_frames += 1
+                self._emit_console(self.buf[:2])
+                del self.buf[:2]
+                continue
+            del self.buf[:6 + length]
+            self._decode(count, payload)
+            self.dropped += dropped
+
+    def _decode(self, count, payload):
+        pc = ra = 0
+        pos = 0
+        for _ in range(count):
+            dpc, pos = self._varint(payload, pos)
+            dra, pos = self._varint(payload, pos)
+            pc = (pc + dpc) & 0xFFFFFFFF
+            ra = (ra + dra) & 0xFFFFFFFF
+            self.samples.append((pc, ra))
+
+    def _emit_console(self, data):
+        if self.console and data:
+            sys.stdout.write(data.decode('ascii', errors='replace'))
+            sys.stdout.flush()
+
+
+def fold(samples, sym):
+    """Build two-level stacks: the function owning the return address is
+    reported as caller when it differs from the sampled function. For leaf
+    functions this is exact; for others ra may be stale, so treat the caller
+    level as a hint."""
+    stacks = Counter()
+    for pc, ra in samples:
+        func = sym.lookup(pc)
+        # ra points after the call instruction, step back into it
+        caller = sym.lookup(ra - 2) if ra else None
+        if caller and caller != func and not caller.startswith('0x'):
+            stacks[caller + ';' + func] += 1
+        else:
+            stacks[func] += 1
+    return stacks
+
+
+def write_svg(stacks, path, width=1200, row=18):
+    """Render folded stacks as a minimal flame graph."""
+    tree = {}
+    for stack, count in stacks.items():
+        node = tree
+        for name in stack.split(';'):
+            entry = node.setdefault(name, [0, {}])
+            entry[0] += count
+            node = entry[1]
+    total = sum(stacks.values()) or 1
+
+    def depth(node):
+        return 1 + max((depth(child[1]) for child in node.values()), default=0)
+
+    levels = depth(tree)
+    height = (levels + 1) * row
+    rects = []
+
+    def draw(node, x, level):
+        for name, (count, children) in sorted(node.items()):
+            w = count * width / total
+            y = height - (level + 2) * row
+            hue = (sum(map(ord, name)) * 37) % 60
+            label = html.escape(name)
+            rects.append(
+                '<g><title>%s (%d samples, %.1f%%)</title>'
+                '<rect x="%.2f" y="%d" width="%.2f" height="%d" fill="hsl(%d,90%%,60%%)" stroke="white"/>'
+                '<text x="%.2f" y="%d" font-size="11" font-family="monospace">%s</text></g>'
+                % (label, count, 100.0 * count / total, x, y, w, row - 1, hue,
+                   x + 3, y + row - 5, label if w > 7 * len(name) else ''))
+            draw(children, x, level + 1)
+            x += w
+
+    draw(tree, 0.0, 0)
+    with open(path, 'w') as f:
+        f.write('<svg xmlns="http://www.w3.org/2000/svg" width="%d" height="%d">\n' % (width, height))
+        f.write('<text x="4" y="14" font-size="13" font-family="monospace">'
+                'Flame graph: %d samples</text>\n' % total)
+        f.write('\n'.join(rects))
+        f.write('\n</svg>\n')
+
+
+def capture_serial(parser, device, baud, duration):
+    import serial
+    port = serial.Serial(device, baud, timeout=0.1)
+    port.reset_input_buffer()
+    deadline = time.time() + duration if duration else None
+    try:
+        while deadline is None or time.time() < deadline:
+            data = port.read(4096)
+            if data:
+                parser.feed(data)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        port.close()
+
+
+def main():
+    ap = argparse.ArgumentParser(description='Collect and symbolize PicoRV32 PC samples')
+    src = ap.add_mutually_exclusive_group(required=True)
+    src.add_argument('-d', '--device', help='Serial device (e.g., /dev/ttyUSB0)')
+    src.add_argument('-i', '--input', help='Raw UART capture file instead of a live device')
+    ap.add_argument('-b', '--baud', type=int, default=921600, help='Baud rate (default: 921600)')
+    ap.add_argument('-t', '--duration', type=float, default=0,
+                    help='Capture duration in seconds (default: until Ctrl-C)')
+    ap.add_argument('-e', '--elf', required=True, help='firmware.elf used for symbolization')
+    ap.add_argument('--cross', default=os.environ.get('CROSS', 'riscv32-unknown-elf-'),
+                    help='Toolchain prefix (default: riscv32-unknown-elf-)')
+    ap.add_argument('-o', '--folded', default='profile.folded', help='Folded stacks output')
+    ap.add_argument('--svg', help='Write an SVG flame graph to this file')
+    ap.add_argument('--samples', help='Write raw "pc ra" sample pairs to this file')
+    ap.add_argument('-n', '--top', type=int, default=15, help='Number of hot functions to print')
+    ap.add_argument('-q', '--quiet', action='store_true', help='Do not echo console output')
+    args = ap.parse_args()
+
+    parser = FrameParser(console=not args.quiet)
+    if args.input:
+        with open(args.input, 'rb') as f:
+            parser.feed(f.read())
+    else:
+        capture_serial(parser, args.device, args.baud, args.duration)
+
+    if not parser.samples:
+        print('\nNo samples received')
+        sys.exit(1)
+
+    sym = Symbolizer(args.elf, args.cross)
+    stacks = fold(parser.samples, sym)
+
+    with open(args.folded, 'w') as f:
+        for stack, count in sorted(stacks.items()):
+            f.write('%s %d\n' % (stack, count))
+    if args.samples:
+        with open(args.samples, 'w') as f:
+            for pc, ra in parser.samples:
+                f.write('%08x %08x\n' % (pc, ra))
+    if args.svg:
+        write_svg(stacks, args.svg)
+
+    flat = Counter()
+    for stack, count in stacks.items():
+        flat[stack.split(';')[-1]] += count
+    total = len(parser.samples)
+    print('\n%d samples, %d dropped, %d corrupt frames' % (total, parser.dropped, parser.bad_frames))
+    print('%8s %7s  %s' % ('samples', 'self%', 'function'))
+    for name, count in flat.most_common(args.top):
+        print('%8d %6.2f%%  %s' % (count, 100.0 * count / total, name))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,239 @@
+#!/usr/bin/env python3
+# shock_dbg.py - Host side of the UART debug bridge (src/uart_axi_bridge)
+#
+# Reads and writes SoC memory and registers over the UART without firmware involvement, loads
+# images into SRAM at full line rate and polls variables while the firmware keeps running. The
+# bridge only answers after the unlock sequence and hands the UART back to the firmware when
+# the session is closed, which this script does on exit. The bridge is only in bitstreams built
+# with CFG_ENABLE_DBG_BRIDGE=1.
+#
+#   shock_dbg.py -d /dev/ttyUSB0 read 0x4000 16
+#   shock_dbg.py -d /dev/ttyUSB0 write 0x2000 0x55
+#   shock_dbg.py -d /dev/ttyUSB0 load firmware.bin
+#   shock_dbg.py -d /dev/ttyUSB0 watch -e firmware.elf led_state 0x1000
+import argparse
+import os
+import subprocess
+import sys
+import time
+
+UNLOCK = b'\x1bDBG'
+BURST_WORDS = 256           # 'W'/'R' move up to 256 words per command
+SRAM_BASE = 0x4000
+SRAM_SIZE = 16384
+BOOTLOADER_BAUD = 115200
+
+
+class DebugError(Exception):
+    pass
+
+
+class Bridge:
+    """Command level access to uart_axi_bridge, see the protocol in uart_axi_bridge.sv."""
+
+    def __init__(self, device, baud):
+        import serial
+        self.port = serial.Serial(device, baud, timeout=0.5)
+        self.port.reset_input_buffer()
+        self.port.write(UNLOCK)
+        self.port.flush()
+        if self.port.read(1) != b'K':
+            # A previous session may still be open, in which case the unlock bytes were taken as
+            # commands. Let their replies arrive, then a ping tells if the bridge is there.
+            time.sleep(0.05)
+            self.port.reset_input_buffer()
+            self.port.write(b'S')
+            if self.port.read(1) != b'K':
+                raise DebugError('no answer from the debug bridge on %s' % device)
+            self.port.reset_input_buffer()
+
+    def _status(self, what):
+        status = self.port.read(1)
+        if status == b'E':
+            raise DebugError('%s: error response' % what)
+        if status != b'K':
+            raise DebugError('%s: unexpected reply %r' % (what, status))
+
+    def read(self, addr, nbr=1):
+        """Read nbr words starting at addr."""
+        words = []
+        while nbr > 0:
+            n = min(nbr, BURST_WORDS)
+            self.port.write(b'R' + addr.to_bytes(4, 'little') + bytes([n - 1]))
+            raw = self.port.read(4 * n)
+            if len(raw) != 4 * n:
+                raise DebugError('read 0x%08x: %d of %d bytes received' % (addr, len(raw), 4 * n))
+            self._status('read 0x%08x' % addr)
+            words += [int.from_bytes(raw[4 * i:4 * i + 4], 'little') for i in range(n)]
+            addr += 4 * n
+            nbr -= n
+        return words
+
+    def write(self, addr, words):
+        """Write a list of words starting at addr."""
+        for i in range(0, len(words), BURST_WORDS):
+            chunk = words[i:i + BURST_WORDS]
+            payload = b''.join(w.to_bytes(4, 'little') for w in chunk)
+            self.port.write(b'W' + addr.to_bytes(4, 'little') + bytes([len(chunk) - 1]) + payload)
+            self._status('write 0x%08x' % addr)
+            addr += 4 * len(chunk)
+
+    def halt(self, on):
+        """Hold the cores in reset (on) or release them, they restart from their reset vector."""
+        self.port.write(b'H' + bytes([1 if on else 0]))
+        self._status('halt' if on else 'resume')
+
+    def close(self):
+        """End the session, the UART belongs to the firmware again."""
+        try:
+            self.port.write(b'Q')
+            self._status('close')
+        finally:
+            self.port.close()
+
+
+def parse_int(text):
+    return int(text, 0)
+
+
+def resolve(names, elf, cross):
+    """Turn numbers and (with an ELF) symbol names into (label, address) pairs."""
+    symbols = {}
+    if elf:
+        out = subprocess.run([cross + 'nm', '--defined-only', elf],
+                             check=True, capture_output=True, text=True).stdout
+        for line in out.splitlines():
+            fields = line.split()
+            if len(fields) == 3:
+                symbols[fields[2]] = int(fields[0], 16)
+    result = []
+    for name in names:
+        if name in symbols:
+            result.append((name, symbols[name]))
+        else:
+            try:
+                result.append((name, parse_int(name)))
+            except ValueError:
+                sys.exit('unknown symbol %s%s' % (name, '' if elf else ' (no -e/--elf given)'))
+    return result
+
+
+def cmd_read(bridge, args):
+    words = bridge.read(args.addr & ~3, args.count)
+    for i in range(0, len(words), 4):
+        line = ' '.join('%08x' % w for w in words[i:i + 4])
+        print('%08x: %s' % ((args.addr & ~3) + 4 * i, line))
+
+
+def cmd_write(bridge, args):
+    bridge.write(args.addr & ~3, args.values)
+
+
+def cmd_load(bridge, args):
+    with open(args.file, 'rb') as f:
+        data = f.read()
+    if args.addr == SRAM_BASE and len(data) > SRAM_SIZE:
+        sys.exit('%s does not fit into %d bytes of SRAM' % (args.file, SRAM_SIZE))
+    data += b'\0' * (-len(data) % 4)
+    words = [int.from_bytes(data[i:i + 4], 'little') for i in range(0, len(data), 4)]
+
+    start = time.time()
+    bridge.halt(True)
+    bridge.write(args.addr, words)
+    if args.verify and bridge.read(args.addr, len(words)) != words:
+        raise DebugError('verify failed')
+    elapsed = time.time() - start
+    print('Loaded %d bytes at 0x%08x in %.2f s' % (len(data), args.addr, elapsed))
+    if args.no_run:
+        return
+
+    # Released cores restart in the bootloader, which starts the image on 'J'
+    bridge.halt(False)
+    bridge.close()
+    import serial
+    port = serial.Serial(args.device, BOOTLOADER_BAUD, timeout=0.1)
+    port.write(b'J')
+    port.flush()
+    port.close()
+    print('Started')
+
+
+def cmd_watch(bridge, args):
+    targets = resolve(args.names, args.elf, args.cross)
+    previous = None
+    try:
+        while True:
+            values = [bridge.read(addr & ~3)[0] for _, addr in targets]
+            if values != previous or not args.changes:
+                stamp = time.strftime('%H:%M:%S')
+                print(stamp + '  ' + '  '.join('%s=0x%08x' % (label, v)
+                                               for (label, _), v in zip(targets, values)))
+                sys.stdout.flush()
+            previous = values
+            if args.count:
+                args.count -= 1
+                if args.count == 0:
+                    break
+            time.sleep(args.interval)
+    except KeyboardInterrupt:
+        pass
+
+
+def main():
+    ap = argparse.ArgumentParser(description='Access SoC memory through the UART debug bridge')
+    ap.add_argument('-d', '--device', required=True, help='Serial device (e.g., /dev/ttyUSB0)')
+    ap.add_argument('-b', '--baud', type=int, default=921600,
+                    help='Debug bridge baud rate, DBG_BRIDGE_BAUD_p (default: 921600)')
+    sub = ap.add_subparsers(dest='cmd', required=True)
+
+    p = sub.add_parser('read', help='Print words')
+    p.add_argument('addr', type=parse_int)
+    p.add_argument('count', type=parse_int, nargs='?', default=1)
+    p.set_defaults(func=cmd_read)
+
+    p = sub.add_parser('write', help='Write words')
+    p.add_argument('addr', type=parse_int)
+    p.add_argument('values', type=parse_int, nargs='+')
+    p.set_defaults(func=cmd_write)
+
+    p = sub.add_parser('load', help='Halt the CPU, load a binary and start it')
+    p.add_argument('file', help='Binary file (firmware.bin)')
+    p.add_argument('-a', '--addr', type=parse_int, default=SRAM_BASE,
+                   help='Load address (default: 0x4000)')
+    p.add_argument('--verify', action='store_true', help='Read the image back before starting')
+    p.add_argument('--no-run', action='store_true',
+                   help='Leave the cores halted (resume starts them from the reset vector)')
+    p.set_defaults(func=cmd_load)
+
+    p = sub.add_parser('watch', help='Poll words while the firmware runs')
+    p.add_argument('names', nargs='+', help='Addresses or symbol names (with -e)')
+    p.add_argument('-e', '--elf', help='firmware.elf for symbol names')
+    p.add_argument('--cross', default=os.environ.get('CROSS', 'riscv32-unknown-elf-'),
+                   help='Toolchain prefix (default: riscv32-unknown-elf-)')
+    p.add_argument('-i', '--interval', type=float, default=0.1, help='Seconds between polls')
+    p.add_argument('-n', '--count', type=int, default=0, help='Number of polls (default: forever)')
+    p.add_argument('-c', '--changes', action='store_true', help='Only print when a value changes')
+    p.set_defaults(func=cmd_watch)
+
+    p = sub.add_parser('halt', help='Hold the cores in reset')
+    p.set_defaults(func=lambda bridge, args: bridge.halt(True))
+
+    p = sub.add_parser('resume', help='Release the cores, they restart from the reset vector')
+    p.set_defaults(func=lambda bridge, args: bridge.halt(False))
+
+    args = ap.parse_args()
+    try:
+        bridge = Bridge(args.device, args.baud)
+    except DebugError as e:
+        sys.exit(str(e))
+    try:
+        args.func(bridge, args)
+    except DebugError as e:
+        sys.exit(str(e))
+    finally:
+        if bridge.port.is_open:
+            bridge.close()
+
+
+if __name__ == '__main__':
+    main()
@@ -1,21 +1,169 @@
 #!/usr/bin/env python3
-import serial
 import sys
 import os
 import time
 import argparse
+import zlib
+
+SRAM_SIZE = 16384
+BLOCK_SIZE = 256
+BLOCK_NBR = SRAM_SIZE // BLOCK_SIZE
 
 # Parse command line arguments
 parser = argparse.ArgumentParser(description='Upload binary to RISC-V bootloader via UART')
 parser.add_argument('-f', '--file', required=True, help='Binary file to upload')
-parser.add_argument('-d', '--device', required=True, help='Serial device (e.g., /dev/ttyUSB0)')
+parser.add_argument('-d', '--device', help='Serial device (e.g., /dev/ttyUSB0)')
 parser.add_argument('-b', '--baud', type=int, default=115200, help='Baud rate (default: 115200)')
+parser.add_argument('--delta', action='store_true',
+                    help='Only send the 256-byte blocks that differ from the SRAM contents '
+                         '(falls back to a full upload if the bootloader does not answer)')
+parser.add_argument('--stim', metavar='FILE',
+                    help='Write a testbench UART stimulus script (sim/Makefile UART_STIM) that '
+                         'performs the upload instead of using a serial device')
 args = parser.parse_args()
+if not args.device and not args.stim:
+    parser.error('one of -d/--device or --stim is required')
 
 binary_file = args.file
 serial_port = args.device
 baud_rate = args.baud
 
+
+def read_exact(port, n, timeout_seconds):
+    """Read n bytes or return what arrived before the timeout."""
+    data = b''
+    start_time = time.time()
+    while len(data) < n and time.time() - start_time < timeout_seconds:
+        data += port.read(n - len(data))
+    return data
+
+
+def wait_for_ack(port, timeout_seconds):
+    """Wait for the bootloader's '.' (ok) or '!' (error), returns the byte or None."""
+    start_time = time.time()
+    while time.time() - start_time < timeout_seconds:
+        char = port.read(1)
+        if char in (b'.', b'!'):
+            return char
+    return None
+
+
+def read_hashes(port):
+    """Ask the bootloader for the CRC-32 of every SRAM block, None if it does not answer."""
+    port.reset_input_buffer()
+    port.write(b'H')
+    port.flush()
+    # The bootloader CRC is bit-serial: 131072 bits at 7-8 instructions each, ~1M instructions at
+    # roughly 8 clocks each fetched from the ROM, i.e. ~80 ms at 100 MHz. Plus 256 bytes on the wire,
+    # generous for low baud rates
+    raw = read_exact(port, 4 * BLOCK_NBR, 2.0 + 4 * BLOCK_NBR * 10 / baud_rate)
+    if len(raw) != 4 * BLOCK_NBR:
+        return None
+    return [int.from_bytes(raw[4 * i:4 * i + 4], 'little') for i in range(BLOCK_NBR)]
+
+
+def full_upload(port, data):
+    # Send 'R' trigger
+    print("Sending 'R' trigger...")
+    port.write(b'R')
+
+    print("Uploading program...")
+    sys.stdout.write("Progress: ")
+    sys.stdout.flush()
+
+    # Send data in 1KB chunks, wait for dot after each chunk
+    chunk_size = 1024
+    timeout_seconds = 5
+
+    for i in range(0, len(data), chunk_size):
+        chunk = data[i:i+chunk_size]
+        port.write(chunk)
+        port.flush()
+
+        # Wait for dot with timeout
+        start_time = time.time()
+        dot_received = False
+
+        while time.time() - start_time < timeout_seconds:
+            if port.in_waiting > 0:
+                char = port.read(1)
+                if char == b'.':
+                    sys.stdout.write('.')
+                    sys.stdout.flush()
+                    dot_received = True
+                    break
+            time.sleep(0.01)
+
+        if not dot_received:
+            sys.stdout.write(f"\nError: Timeout waiting for progress indicator after {i + len(chunk)} bytes\n")
+            sys.stdout.flush()
+            port.close()
+            sys.exit(1)
+
+    sys.stdout.write("\n")
+
+
+def write_stim(path, data):
+    """Upload as a tb/src/uart_agent.sv script. The simulated SRAM holds nothing useful, so
+    --delta sends every block of the image with 'W' and starts it with 'J'; otherwise it is the
+    full 'R' upload."""
+    src = os.path.abspath(binary_file)
+    # Bytes on the wire at 10 bits each, twice over for the bootloader's own work
+    def timeout_us(n):
+        return int(2 * n * 10 * 1e6 / baud_rate) + 1000
+
+    with open(path, 'w') as f:
+        f.write(f"# Generated by upload.py from {binary_file}\n")
+        f.write(f"baud {baud_rate}\n")
+        if args.delta:
+            used = (file_size + BLOCK_SIZE - 1) // BLOCK_SIZE
+            f.write(f"timeout {timeout_us(BLOCK_SIZE + 2)}\n")
+            for i in range(used):
+                f.write(f"hex 57 {i:02x}\n")
+                f.write(f"file {src} {i * BLOCK_SIZE} {BLOCK_SIZE}\n")
+                f.write("wait .\n")
+            f.write("send J\n")
+        else:
+            f.write(f"timeout {timeout_us(1024)}\n")
+            f.write("send R\n")
+            for i in range(0, len(data), 1024):
+                f.write(f"file {src} {i} 1024\n")
+                f.write("wait .\n")
+        f.write("# Program output can be checked with further 'wait <text>' lines\n")
+    print(f"Wrote UART stimulus {path}")
+
+
+def delta_upload(port, data, hashes):
+    # Only the blocks covered by the image matter, start.S clears BSS and sets up the stack
+    used = (file_size + BLOCK_SIZE - 1) // BLOCK_SIZE
+    blocks = [data[i * BLOCK_SIZE:(i + 1) * BLOCK_SIZE] for i in range(used)]
+    changed = [i for i in range(used) if zlib.crc32(blocks[i]) != hashes[i]]
+    print(f"Delta upload: {len(changed)} of {used} blocks differ")
+
+    for i in changed:
+        port.write(b'W' + bytes([i]) + blocks[i])
+        port.flush()
+        ack = wait_for_ack(port, 5)
+        if ack != b'.':
+            print(f"Error: block {i} not acknowledged ({ack})")
+            return False
+
+    # Verify the result before starting the program
+    if changed:
+        hashes = read_hashes(port)
+        if hashes is None:
+            print("Error: no hashes received when verifying")
+            return False
+        bad = [i for i in range(used) if zlib.crc32(blocks[i]) != hashes[i]]
+        if bad:
+            print(f"Error: blocks {bad} differ after upload")
+            return False
+
+    port.write(b'J')
+    port.flush()
+    return True
+
+
 # Check if file exists
 if not os.path.exists(binary_file):
     print(f"Error: File '{binary_file}' not found")
@@ -28,13 +176,22 @@ with open(binary_file, 'rb') as f:
 file_size = len(data)
 print(f"File size: {file_size} bytes")
 
+if file_size > SRAM_SIZE:
+    print(f"Error: File does not fit into {SRAM_SIZE} bytes of SRAM")
+    sys.exit(1)
+
 # Pad to 16KB (16384 bytes) with zeros
-if len(data) < 16384:
-    padding = 16384 - len(data)
+if len(data) < SRAM_SIZE:
+    padding = SRAM_SIZE - len(data)
     data += b'\x00' * padding
     print(f"Padded with {padding} zero bytes to 16KB")
 
+if args.stim:
+    write_stim(args.stim, data)
+    sys.exit(0)
+
 # Open serial port
+import serial
 try:
     port = serial.Serial(serial_port, baud_rate, timeout=0.1)
     print(f"Opened {serial_port} at {baud_rate} baud")
@@ -45,42 +202,21 @@ except serial.SerialException as e:
 # Clear any stale data
 port.reset_input_buffer()
 
-# Send 'R' trigger
-print("Sending 'R' trigger...")
-port.write(b'R')
-
-print("Uploading program...")
-sys.stdout.write("Progress: ")
-sys.stdout.flush()
-
-# Send data in 1KB chunks, wait for dot after each chunk
-chunk_size = 1024
-timeout_seconds = 5
-
-for i in range(0, len(data), chunk_size):
-    chunk = data[i:i+chunk_size]
-    port.write(chunk)
-    port.flush()
-    
-    # Wait for dot with timeout
-    start_time = time.time()
-    dot_received = False
-    
-    while time.time() - start_time < timeout_seconds:
-        if port.in_waiting > 0:
-            char = port.read(1)
-            if char == b'.':
-                sys.stdout.write('.')
-                sys.stdout.flush()
-                dot_received = True
-                break
-        time.sleep(0.01)
-    
-    if not dot_received:
-        sys.stdout.write(f"\nError: Timeout waiting for progress indicator after {i + len(chunk)} bytes\n")
-        sys.stdout.flush()
+start = time.time()
+done = False
+if args.delta:
+    hashes = read_hashes(port)
+    if hashes is None:
+        print("Bootloader did not answer the hash request, falling back to a full upload")
+        port.reset_input_buffer()
+    elif not delta_upload(port, data, hashes):
         port.close()
         sys.exit(1)
+    else:
+        done = True
+
+if not done:
+    full_upload(port, data)
 
-sys.stdout.write("\nUpload complete! Program should now be executing...\n")
+sys.stdout.write(f"Upload complete in {time.time() - start:.2f} s! Program should now be executing...\n")
 port.close()
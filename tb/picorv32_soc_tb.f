@@ -1,5 +1,8 @@
 $PICORV32_SOC_ROOT/src/picorv32/picorv32.v
 $PICORV32_SOC_ROOT/src/ccr/rtl/ccr.sv
 -f $PICORV32_SOC_ROOT/rtl/picorv32_soc.f
+$PICORV32_SOC_ROOT/tb/src/qspi_flash_model.sv
+$PICORV32_SOC_ROOT/tb/src/uart_agent.sv
+$PICORV32_SOC_ROOT/tb/src/spi_loopback_model.sv
 $PICORV32_SOC_ROOT/tb/src/picorv32_soc_tb_top.sv
 $PICORV32_SOC_ROOT/fpga/sim/glbl.v
@@ -3,8 +3,17 @@ module picorv32_soc_tb_top;
   logic tb_clk;
   logic tb_rst_n;
   logic [7:0] tb_led;
+  logic [7:0] tb_sw;
+  logic [4:0] tb_btn;
   logic tb_uart_rx;
   logic tb_uart_tx;
+  logic tb_stim_finish;
+  logic tb_qspi_cs_n;
+  wire [3:0] tb_qspi_dq;
+  logic tb_spi_sck;
+  logic tb_spi_mosi;
+  wire tb_spi_miso;
+  logic tb_spi_cs_n;
 
   // Generate clock
   initial begin
@@ -38,71 +47,154 @@ module picorv32_soc_tb_top;
   end
   `endif // RAM_INIT_FILE
 
+  `ifndef FLASH_INIT_FILE
+    `define FLASH_INIT_FILE ""
+  `endif
+
+  // QSPI flash, SCK is taken from inside the DUT as on the board it leaves through STARTUPE2
+  pullup (tb_qspi_cs_n);
+  pullup (tb_qspi_dq[0]);
+  pullup (tb_qspi_dq[1]);
+  pullup (tb_qspi_dq[2]);
+  pullup (tb_qspi_dq[3]);
+
+  qspi_flash_model #(
+    .INIT_FILE      ( `FLASH_INIT_FILE                             ),
+    .INIT_OFFSET_p  ( picorv32_soc_pkg::QSPI_IMAGE_OFFSET_p        ),
+    .DUMMY_CYCLES_p ( picorv32_soc_pkg::QSPI_DUMMY_CYCLES_p        ),
+    .QUAD_INIT_p    ( !picorv32_soc_pkg::QSPI_QUAD_SETUP_p         )
+  ) qspi_flash_model_inst (
+    .sck  ( picorv32_soc_dut.s_qspi_sck ),
+    .cs_n ( tb_qspi_cs_n                ),
+    .dq   ( tb_qspi_dq                  )
+  );
+
+  // SPI loopback slave on the Pmod JA pins, mode 0, answers with the byte sent before
+  pullup (tb_spi_miso);
+
+  spi_loopback_model #(
+    .CPOL_p ( 0 ),
+    .CPHA_p ( 0 )
+  ) spi_loopback_model_inst (
+    .sck  ( tb_spi_sck  ),
+    .cs_n ( tb_spi_cs_n ),
+    .mosi ( tb_spi_mosi ),
+    .miso ( tb_spi_miso )
+  );
+
+  // Switches from +sw=<hex>, buttons released
+  initial begin
+    if (!$value$plusargs("sw=%h", tb_sw)) begin
+      tb_sw = '0;
+    end
+    tb_btn = '0;
+  end
+
   // Generate reset
   initial begin
     tb_rst_n <= 1'b0;
     repeat (10) @(posedge tb_clk);
     tb_rst_n <= 1'b1;
-    wait(picorv32_soc_dut.s_trap === 1'b1);
-    $display("Trap detected! Ending simulation.");
+    wait(picorv32_soc_dut.s_trap[0] === 1'b1 || tb_stim_finish === 1'b1);
+    if (tb_stim_finish === 1'b1) begin
+      $display("UART stimulus finished! Ending simulation.");
+    end else begin
+      $display("Trap detected! Ending simulation.");
+    end
+    report_stats();
     repeat(10) @(posedge tb_clk);
 
     $finish;
   end
 
-  always @(tb_led) begin
-    $display("LED status: %8b", tb_led);
-  end
-
-  task automatic uart_receive();
-    logic [7:0] data;
-    int bit_period_ns;
-
-    bit_period_ns = 1000000000 / 921600;  // ~1085 ns
-
-    forever begin
-      // Wait for start bit (falling edge)
-      @(negedge tb_uart_rx);
+  // Core performance counters at the end of the run, parsed by fpga/config_explorer.py
+  task automatic report_stats();
+    longint unsigned cycles;
+    longint unsigned instret;
+    cycles  = picorv32_soc_dut.gen_cpu[0].picorv32_axi_inst.picorv32_core.count_cycle;
+    instret = picorv32_soc_dut.gen_cpu[0].picorv32_axi_inst.picorv32_core.count_instr;
+    $display("SIM_STATS cycles=%0d instret=%0d cpi=%0.3f led=%02h", cycles, instret,
+      (instret != 0) ? real'(cycles) / real'(instret) : 0.0, tb_led);
+  endtask
 
-      // Wait to middle of start bit
-      #(bit_period_ns / 2);
+  // PC sampling for sw/tools/pgo_layout.py: +pc_samples=<file> writes the PC and return address
+  // of core 0 as "pc ra" hex pairs (the format of profile.py --samples) every
+  // +pc_sample_period=<n> CPU cycles. The default period is prime so it does not alias with loops.
+  initial begin
+    string fname;
+    int    period;
+    int    fd;
 
-      if (tb_uart_rx !== 1'b0) begin
-        $display("ERROR @ %t: Invalid start bit", $time);
-        continue;
+    if ($value$plusargs("pc_samples=%s", fname)) begin
+      if (!$value$plusargs("pc_sample_period=%d", period)) begin
+        period = 97;
       end
-
-      // Sample 8 data bits (LSB first)
-      for (int i = 0; i < 8; i++) begin
-        #bit_period_ns;
-        data[i] = tb_uart_rx;
+      fd = $fopen(fname, "w");
+      if (!fd) begin
+        $display("Cannot open PC sample file %0s", fname);
+        $fatal;
       end
-
-      // Check stop bit
-      #bit_period_ns;
-      if (tb_uart_rx !== 1'b1) begin
-        $display("ERROR @ %t: Invalid stop bit (received: %b)", $time, tb_uart_rx);
+      wait(picorv32_soc_dut.s_rst_n === 1'b1);
+      while (picorv32_soc_dut.s_trap[0] !== 1'b1) begin
+        repeat (period) @(posedge picorv32_soc_dut.s_clk);
+        $fdisplay(fd, "%08h %08h",
+          picorv32_soc_dut.gen_cpu[0].picorv32_axi_inst.picorv32_core.reg_pc,
+          picorv32_soc_dut.gen_cpu[0].picorv32_axi_inst.picorv32_core.cpuregs[1]);
       end
-
-      // Display received byte
-      $display("@ %t: RX = 0x%02h ('%c')", $time, data, 
-        (data >= 32 && data < 127) ? data : ".");
+      $fclose(fd);
     end
-  endtask
+  end
 
-  // In your testbench initial block:
+  // Startup time: +main_addr=<hex> reports when core 0 first fetches from main() (take the
+  // address from nm firmware.elf). Times are counted from the release of the reset button.
   initial begin
-    fork
-      uart_receive(); 
-    join_none
+    logic [31:0]     main_addr;
+    realtime         t_btn;
+    realtime         t_rst;
+    longint unsigned cycles;
+
+    wait(tb_rst_n === 1'b1);
+    t_btn = $realtime;
+    wait(picorv32_soc_dut.s_rst_n === 1'b1);
+    t_rst = $realtime;
+    if ($value$plusargs("main_addr=%h", main_addr)) begin
+      do @(posedge picorv32_soc_dut.s_clk);
+      while (picorv32_soc_dut.gen_cpu[0].picorv32_axi_inst.picorv32_core.reg_pc !== main_addr);
+      cycles = picorv32_soc_dut.gen_cpu[0].picorv32_axi_inst.picorv32_core.count_cycle;
+      $display("BOOT_STATS rst_release_ns=%0.1f main_ns=%0.1f main_cycles=%0d",
+        (t_rst - t_btn) / 1ns, ($realtime - t_btn) / 1ns, cycles);
+    end else begin
+      $display("BOOT_STATS rst_release_ns=%0.1f", (t_rst - t_btn) / 1ns);
+    end
   end
 
+  always @(tb_led) begin
+    $display("LED status: %8b", tb_led);
+  end
+
+  // UART agent: prints received bytes, +uart_stim=<file> drives scripted input (see uart_agent.sv)
+  uart_agent #(
+    .SPEEDUP_p ( picorv32_soc_pkg::UART_SIM_SPEEDUP_p )
+  ) uart_agent_inst (
+    .i_rx     ( tb_uart_rx      ),
+    .o_tx     ( tb_uart_tx      ),
+    .o_finish ( tb_stim_finish  )
+  );
+
   picorv32_soc_top picorv32_soc_dut (
-    .i_clk         ( tb_clk     ),
-    .i_btn_rst_n   ( tb_rst_n   ),
-    .o_led         ( tb_led     ),
-    .o_uart_rx     ( tb_uart_rx ),
-    .i_uart_tx     ( tb_uart_tx )
+    .i_clk         ( tb_clk       ),
+    .i_btn_rst_n   ( tb_rst_n     ),
+    .o_led         ( tb_led       ),
+    .i_sw          ( tb_sw        ),
+    .i_btn         ( tb_btn       ),
+    .o_uart_rx     ( tb_uart_rx   ),
+    .i_uart_tx     ( tb_uart_tx   ),
+    .o_qspi_cs_n   ( tb_qspi_cs_n ),
+    .io_qspi_dq    ( tb_qspi_dq   ),
+    .o_spi_sck     ( tb_spi_sck   ),
+    .o_spi_mosi    ( tb_spi_mosi  ),
+    .i_spi_miso    ( tb_spi_miso  ),
+    .o_spi_cs_n    ( tb_spi_cs_n  )
   );
 
 endmodule : picorv32_soc_tb_top
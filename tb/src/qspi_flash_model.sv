@@ -0,0 +1,184 @@
+// Behavioural model of the S25FL256S quad SPI flash on the Nexys Video, just enough of the
+// command set for axi_qspi_xip:
+//   0x05 RDSR1, 0x35 RDCR, 0x06 WREN, 0x01 WRR (sets SR1/CR1, WIP for WRR_BUSY_NS_p),
+//   0xEB Quad I/O Read with continuous read mode (mode byte 0xAx), mode bit reset (0xFF).
+// SPI mode 0: inputs are sampled on the rising SCK edge, outputs change on the falling edge.
+// The array reads 0xFF except for INIT_FILE (one 32-bit little-endian word per line as written
+// by sw/tools/makehex.py) placed at INIT_OFFSET_p.
+module qspi_flash_model #(
+  parameter string       INIT_FILE      = "",
+  parameter int unsigned INIT_OFFSET_p  = 32'h00C0_0000,
+  parameter int unsigned DUMMY_CYCLES_p = 4,
+  parameter bit          QUAD_INIT_p    = 0,
+  parameter int unsigned WRR_BUSY_NS_p  = 2000
+)(
+  input  logic     sck,
+  input  logic     cs_n,
+  inout  wire [3:0] dq
+);
+
+  timeunit 1ns;
+  timeprecision 1ps;
+
+  logic [7:0] mem [logic [23:0]];
+  logic [7:0] sr1;
+  logic [7:0] cr1;
+  logic       cont_read;
+  logic [3:0] dq_o;
+  logic [3:0] dq_oe;
+  logic [7:0] cr1_new;
+  event       wrr_start;
+
+  for (genvar i = 0; i < 4; i++) begin : gen_dq
+    assign dq[i] = dq_oe[i] ? dq_o[i] : 1'bz;
+  end
+
+  function automatic logic [7:0] mem_read(input logic [23:0] addr);
+    return mem.exists(addr) ? mem[addr] : 8'hFF;
+  endfunction
+
+  initial begin
+    int          fd;
+    int          nbr;
+    logic [31:0] word;
+
+    sr1       = '0;
+    cr1       = QUAD_INIT_p ? 8'h02 : 8'h00;
+    cont_read = 1'b0;
+    dq_o      = '0;
+    dq_oe     = '0;
+
+    if (INIT_FILE != "") begin
+      fd = $fopen(INIT_FILE, "r");
+      if (!fd) begin
+        $display("Flash image %0s not found!", INIT_FILE);
+        $fatal;
+      end
+      nbr = 0;
+      while ($fscanf(fd, "%h", word) == 1) begin
+        for (int b = 0; b < 4; b++) begin
+          mem[24'(INIT_OFFSET_p + 4 * nbr + b)] = word[8*b +: 8];
+        end
+        nbr++;
+      end
+      $fclose(fd);
+      $display("Flash: loaded %0d bytes from %0s at 0x%06h", 4 * nbr, INIT_FILE, INIT_OFFSET_p);
+    end
+  end
+
+  task automatic shift_in_single(input int bits, output logic [31:0] value);
+    value = '0;
+    repeat (bits) begin
+      @(posedge sck);
+      value = {value[30:0], dq[0]};
+    end
+  endtask
+
+  task automatic shift_in_quad(input int nibbles, output logic [31:0] value);
+    value = '0;
+    repeat (nibbles) begin
+      @(posedge sck);
+      value = {value[27:0], dq};
+    end
+  endtask
+
+  // Drive bytes on DQ1 until CS# goes high (the register repeats)
+  task automatic shift_out_single(input logic [7:0] data);
+    forever begin
+      for (int i = 7; i >= 0; i--) begin
+        @(negedge sck);
+        dq_oe   = 4'b0010;
+        dq_o[1] = data[i];
+      end
+    end
+  endtask
+
+  // Quad I/O Read: address and mode on DQ[3:0], dummy clocks, then data from addr onwards
+  task automatic quad_read();
+    logic [31:0] value;
+    logic [23:0] addr;
+    logic [7:0]  data;
+
+    if (!cr1[1]) begin
+      $error("Flash: quad read with CR1.QUAD clear");
+    end
+    shift_in_quad(6, value);
+    addr = value[23:0];
+    shift_in_quad(2, value);
+    cont_read = value[7:4] == 4'hA;
+    repeat (DUMMY_CYCLES_p) @(posedge sck);
+    forever begin
+      data = mem_read(addr);
+      for (int n = 1; n >= 0; n--) begin
+        @(negedge sck);
+        dq_oe = 4'b1111;
+        dq_o  = data[4*n +: 4];
+      end
+      addr++;
+    end
+  endtask
+
+  task automatic transaction(output logic wrr, output logic [15:0] wrr_data);
+    logic [31:0] value;
+
+    wrr = 1'b0;
+    if (cont_read) begin
+      quad_read();
+      return;
+    end
+    shift_in_single(8, value);
+    unique case (value[7:0])
+      8'h05: shift_out_single(sr1);
+      8'h35: shift_out_single(cr1);
+      8'h06: begin
+        if (!sr1[0]) begin
+          sr1[1] = 1'b1;
+        end
+      end
+      8'h01: begin
+        shift_in_single(16, value);
+        wrr      = sr1[1] && !sr1[0];
+        wrr_data = value[15:0];
+      end
+      8'hEB: quad_read();
+      8'hFF: ;  // Mode bit reset outside continuous read mode
+      default: $error("Flash: unsupported command 0x%02h", value[7:0]);
+    endcase
+  endtask
+
+  initial begin
+    logic        wrr;
+    logic [15:0] wrr_data;
+
+    forever begin
+      @(negedge cs_n);
+      wrr = 1'b0;
+      fork
+        transaction(wrr, wrr_data);
+        @(posedge cs_n);
+      join_any
+      disable fork;
+      if (!cs_n) begin
+        @(posedge cs_n);
+      end
+      dq_oe = '0;
+
+      if (wrr) begin
+        sr1     = {wrr_data[15:8] & 8'hFC, 2'b11};
+        cr1_new = wrr_data[7:0];
+        -> wrr_start;
+      end
+    end
+  end
+
+  // Non-volatile register write completes in the background, SR1.WIP is polled meanwhile
+  initial begin
+    forever begin
+      @(wrr_start);
+      #(WRR_BUSY_NS_p * 1ns);
+      cr1      = cr1_new;
+      sr1[1:0] = 2'b00;
+    end
+  end
+
+endmodule : qspi_flash_model
@@ -0,0 +1,57 @@
+// Behavioural SPI slave that answers with what it received DELAY_BITS_p bits earlier, a shift
+// register between MOSI and MISO. Every frame that is a multiple of DELAY_BITS_p long therefore
+// comes back one frame later, in any bit order. The register keeps its content while CS_N is
+// high. CPOL_p/CPHA_p select the SPI mode: the slave samples MOSI on the leading SCK edge and
+// changes MISO on the trailing edge with CPHA_p = 0, the other way round with CPHA_p = 1. MISO
+// is released while CS_N is high, so several models can share the line.
+module spi_loopback_model #(
+  parameter bit          CPOL_p       = 0,
+  parameter bit          CPHA_p       = 0,
+  parameter int unsigned DELAY_BITS_p = 8
+)(
+  input  logic sck,
+  input  logic cs_n,
+  input  logic mosi,
+  output wire  miso
+);
+
+  timeunit 1ns;
+  timeprecision 1ps;
+
+  logic [DELAY_BITS_p-1:0] sr = '0;
+  logic                    in_bit;
+  logic                    miso_o;
+  int unsigned             bit_count = 0;  // Bits received, for the testbench
+
+  assign miso = cs_n ? 1'bz : miso_o;
+
+  // With CPHA = 0 the first bit has to be on MISO before the first edge
+  always @(negedge cs_n) begin
+    miso_o <= sr[DELAY_BITS_p-1];
+  end
+
+  // Leading edge
+  always @(edge sck) begin
+    if (!cs_n && sck != CPOL_p) begin
+      if (CPHA_p) begin
+        miso_o <= sr[DELAY_BITS_p-1];
+      end else begin
+        in_bit <= mosi;
+      end
+    end
+  end
+
+  // Trailing edge
+  always @(edge sck) begin
+    if (!cs_n && sck == CPOL_p) begin
+      bit_count <= bit_count + 1;
+      if (CPHA_p) begin
+        sr <= {sr[DELAY_BITS_p-2:0], mosi};
+      end else begin
+        sr     <= {sr[DELAY_BITS_p-2:0], in_bit};
+        miso_o <= sr[DELAY_BITS_p-2];
+      end
+    end
+  end
+
+endmodule : spi_loopback_model
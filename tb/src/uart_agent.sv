@@ -0,0 +1,297 @@
+// Transaction-level UART agent for the SoC testbench, 8N1.
+//
+// The monitor decodes every byte the DUT sends, prints it as "RX = 0x.." (the format read by
+// sw/tools/blog_decode.py) and appends it to rx_data. The driver sends bytes to the DUT with
+// send_byte(). The bit period is 1 / (baud * SPEEDUP_p), SPEEDUP_p must match the factor the
+// DUT UART clock frequency is scaled by (picorv32_soc_pkg::UART_SIM_SPEEDUP_p).
+//
+// run_script() plays a stimulus file, one command per line:
+//   # comment
+//   baud <n>                       bit rate seen by the firmware (default +uart_baud or 921600)
+//   send <text>                    send text, escapes \r \n \t \\ \xHH
+//   hex <hh> <hh> ...              send raw bytes
+//   file <path> [<offset> [<len>]] send bytes of a binary file, zero-padded past its end
+//   wait <text>                    wait until text has been received since the previous wait
+//   timeout <us>                   time limit of each wait (default 10000 us), fails the run
+//   delay <us>                     idle the line
+//   finish                         end the simulation
+// Every command is echoed with a "UART_STIM" prefix. A failed wait also ends the simulation,
+// without finish the run continues until the firmware traps.
+module uart_agent #(
+  parameter int unsigned SPEEDUP_p = 1
+)(
+  input  logic i_rx,   // DUT TX
+  output logic o_tx,   // DUT RX
+  output logic o_finish
+);
+
+  timeunit 1ns;
+  timeprecision 1ps;
+
+  int unsigned baud;
+  realtime     bit_period;
+  byte         rx_data[$];
+  int unsigned rx_pos;
+  realtime     wait_timeout;
+  int unsigned errors;
+  event        rx_event;
+
+  function automatic void set_baud(input int unsigned b);
+    baud       = b;
+    bit_period = 1s / (real'(b) * SPEEDUP_p);
+  endfunction
+
+  // Set up the line and the bit period, then play +uart_stim if given. Both happen in one block so
+  // the start-up delay below always sees the final bit period.
+  initial begin
+    int unsigned b;
+    string       fname;
+
+    o_tx         = 1'b1;
+    o_finish     = 1'b0;
+    rx_pos       = 0;
+    errors       = 0;
+    wait_timeout = 10ms;
+    if (!$value$plusargs("uart_baud=%d", b)) begin
+      b = 921600;
+    end
+    set_baud(b);
+
+    if ($value$plusargs("uart_stim=%s", fname)) begin
+      // Give the DUT time to come out of reset and configure its UART
+      #(20 * bit_period);
+      run_script(fname);
+    end
+  end
+
+  // --------------------------------------------------------------------------
+  // Monitor
+  // --------------------------------------------------------------------------
+  initial begin
+    logic [7:0] data;
+
+    forever begin
+      // Wait for start bit (falling edge), then sample in the middle of each bit
+      @(negedge i_rx);
+      #(bit_period / 2);
+      if (i_rx !== 1'b0) begin
+        $display("ERROR @ %t: Invalid start bit", $time);
+        continue;
+      end
+
+      // 8 data bits, LSB first
+      for (int i = 0; i < 8; i++) begin
+        #(bit_period);
+        data[i] = i_rx;
+      end
+
+      #(bit_period);
+      if (i_rx !== 1'b1) begin
+        $display("ERROR @ %t: Invalid stop bit (received: %b)", $time, i_rx);
+      end
+
+      rx_data.push_back(data);
+      -> rx_event;
+      $display("@ %t: RX = 0x%02h ('%c')", $time, data,
+        (data >= 32 && data < 127) ? data : ".");
+    end
+  end
+
+  // --------------------------------------------------------------------------
+  // Driver
+  // --------------------------------------------------------------------------
+  task automatic send_byte(input logic [7:0] data);
+    o_tx = 1'b0;
+    #(bit_period);
+    for (int i = 0; i < 8; i++) begin
+      o_tx = data[i];
+      #(bit_period);
+    end
+    o_tx = 1'b1;
+    #(bit_period);
+  endtask
+
+  task automatic send_string(input string s);
+    for (int i = 0; i < s.len(); i++) begin
+      send_byte(s[i]);
+    end
+  endtask
+
+  // Wait until text shows up in the bytes received after the previous match, returns 0 on timeout
+  task automatic wait_for(input string text, output bit found);
+    found = 0;
+    fork : wait_or_timeout
+      begin
+        forever begin
+          for (int unsigned start = rx_pos; start + text.len() <= rx_data.size(); start++) begin
+            bit match = 1;
+            for (int i = 0; i < text.len(); i++) begin
+              if (rx_data[start + i] != text[i]) begin
+                match = 0;
+                break;
+              end
+            end
+            if (match) begin
+              rx_pos = start + text.len();
+              found  = 1;
+              break;
+            end
+          end
+          if (found) begin
+            break;
+          end
+          @(rx_event);
+        end
+      end
+      #(wait_timeout);
+    join_any
+    disable wait_or_timeout;
+  endtask
+
+  // --------------------------------------------------------------------------
+  // Stimulus scripts
+  // --------------------------------------------------------------------------
+  function automatic string unescape(input string s);
+    string r = "";
+    int    i = 0;
+    while (i < s.len()) begin
+      if (s[i] == "\\" && i + 1 < s.len()) begin
+        i++;
+        case (s[i])
+          "r": r = {r, "\r"};
+          "n": r = {r, "\n"};
+          "t": r = {r, "\t"};
+          "x": begin
+            r = {r, string'(byte'(s.substr(i + 1, i + 2).atohex()))};
+            i += 2;
+          end
+          default: r = {r, string'(s[i])};
+        endcase
+      end else begin
+        r = {r, string'(s[i])};
+      end
+      i++;
+    end
+    return r;
+  endfunction
+
+  task automatic send_file(input string args);
+    string       path;
+    int unsigned offset = 0;
+    int          len = -1;
+    int          fd;
+    int          c;
+    int unsigned nbr;
+
+    void'($sscanf(args, "%s %d %d", path, offset, len));
+    fd = $fopen(path, "rb");
+    if (!fd) begin
+      $display("UART_STIM ERROR: cannot open %0s", path);
+      errors++;
+      return;
+    end
+    void'($fseek(fd, offset, 0));
+    nbr = 0;
+    while (len < 0 || nbr < len) begin
+      c = $fgetc(fd);
+      if (c == -1) begin
+        if (len < 0) begin
+          break;
+        end
+        c = 0;
+      end
+      send_byte(c[7:0]);
+      nbr++;
+    end
+    $fclose(fd);
+    $display("UART_STIM @ %t: sent %0d bytes of %0s", $time, nbr, path);
+  endtask
+
+  task automatic run_script(input string fname);
+    int    fd;
+    string line;
+    string cmd;
+    string arg;
+    int    sep;
+    int    lineno = 0;
+    bit    finish = 0;
+
+    fd = $fopen(fname, "r");
+    if (!fd) begin
+      $display("UART stimulus file %0s not found!", fname);
+      $fatal;
+    end
+
+    while ($fgets(line, fd)) begin
+      lineno++;
+      // Strip the line ending and leading blanks
+      while (line.len() > 0 && (line[line.len() - 1] == "\n" || line[line.len() - 1] == "\r")) begin
+        line = line.substr(0, line.len() - 2);
+      end
+      while (line.len() > 0 && (line[0] == " " || line[0] == "\t")) begin
+        line = line.substr(1, line.len() - 1);
+      end
+      if (line.len() == 0 || line[0] == "#") begin
+        continue;
+      end
+
+      sep = line.len();
+      for (int i = 0; i < line.len(); i++) begin
+        if (line[i] == " ") begin
+          sep = i;
+          break;
+        end
+      end
+      cmd = line.substr(0, sep - 1);
+      arg = (sep + 1 < line.len()) ? line.substr(sep + 1, line.len() - 1) : "";
+      $display("UART_STIM @ %t: %0s", $time, line);
+
+      case (cmd)
+        "baud": set_baud(arg.atoi());
+        "send": send_string(unescape(arg));
+        "hex": begin
+          int unsigned value;
+          string       rest = arg;
+          while (rest.len() > 0) begin
+            if ($sscanf(rest, "%h", value) != 1) begin
+              break;
+            end
+            send_byte(value[7:0]);
+            // Skip the token just read and the blanks after it
+            while (rest.len() > 0 && rest[0] != " ") rest = rest.substr(1, rest.len() - 1);
+            while (rest.len() > 0 && rest[0] == " ") rest = rest.substr(1, rest.len() - 1);
+          end
+        end
+        "file": send_file(arg);
+        "wait": begin
+          bit found;
+          wait_for(unescape(arg), found);
+          if (!found) begin
+            $display("UART_STIM ERROR @ %t: timeout waiting for \"%0s\" (%0s:%0d)", $time, arg,
+              fname, lineno);
+            errors++;
+            finish = 1;
+            break;
+          end
+        end
+        "timeout": wait_timeout = arg.atoi() * 1us;
+        "delay": #(arg.atoi() * 1us);
+        "finish": begin
+          finish = 1;
+          break;
+        end
+        default: begin
+          $display("UART_STIM ERROR: unknown command \"%0s\" (%0s:%0d)", cmd, fname, lineno);
+          errors++;
+          finish = 1;
+          break;
+        end
+      endcase
+    end
+    $fclose(fd);
+
+    $display("UART_STIM %0s", errors ? "FAILED" : "PASSED");
+    o_finish = finish;
+  endtask
+
+endmodule : uart_agent